@@ -32,7 +32,7 @@
   ==============================================================================
 */
 
-#ifdef ADSP_H_INCLUDED
+#if defined(ADSP_H_INCLUDED) && !defined(ADSP_HEADER_ONLY)
 #error "ERROR: incorrect use of ADSP.cpp file"
 #endif
 
@@ -43,3 +43,34 @@
 #include "source/filter/RcHp1.cpp"
 #include "source/filter/SkLp2.cpp"
 #include "source/filter/SkHp2.cpp"
+#include "source/oversampling/HalfbandIir.cpp"
+#include "source/oversampling/HalfbandFir.cpp"
+#include "source/oversampling/Oversampler.cpp"
+#include "source/resampling/Resampler.cpp"
+#include "source/analysis/FrequencyResponse.cpp"
+#include "source/debug/RealtimeCheck.cpp"
+#include "source/debug/Profiler.cpp"
+#include "source/filter/Svf.cpp"
+#include "source/filter/RbjDesign.cpp"
+#include "source/filter/Peak.cpp"
+#include "source/filter/LowShelf.cpp"
+#include "source/filter/HighShelf.cpp"
+#include "source/filter/Notch.cpp"
+#include "source/filter/Bandpass.cpp"
+#include "source/filter/Allpass.cpp"
+#include "source/filter/BiquadCascade.cpp"
+#include "source/filter/ParametricEq.cpp"
+#include "source/filter/FilterDesigner.cpp"
+#include "source/filter/BiquadFixed.cpp"
+#include "source/delay/DelayLine.cpp"
+#include "source/analysis/MeterBank.cpp"
+#include "source/dynamics/Dynamics.cpp"
+#include "source/nonlinear/Saturator.cpp"
+#include "source/utility/Smoother.cpp"
+#include "source/analysis/OctaveFilterBank.cpp"
+#include "source/filter/FilterGroup.cpp"
+#include "source/filter/FirstOrder.cpp"
+#include "source/filter/DcBlocker.cpp"
+#include "source/analysis/TimeResponse.cpp"
+#include "source/graph/ProcessGraph.cpp"
+#include "source/filter/FilterPool.cpp"
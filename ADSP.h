@@ -36,8 +36,48 @@
 #define ADSP_H_INCLUDED
 
 #include "source/filter/Biquad.h"
+#include "source/filter/BiquadKernels.h"
+#include "source/filter/FirstOrder.h"
 #include "source/utility/utility.h"
 #include "source/filter/RcLp1.h"
 #include "source/filter/RcHp1.h"
 #include "source/filter/SkLp2.h"
 #include "source/filter/SkHp2.h"
+#include "source/oversampling/HalfbandIir.h"
+#include "source/oversampling/HalfbandFir.h"
+#include "source/oversampling/Oversampler.h"
+#include "source/resampling/Resampler.h"
+#include "source/analysis/FrequencyResponse.h"
+#include "source/debug/RealtimeCheck.h"
+#include "source/debug/Profiler.h"
+#include "source/filter/Svf.h"
+#include "source/filter/RbjDesign.h"
+#include "source/filter/Peak.h"
+#include "source/filter/LowShelf.h"
+#include "source/filter/HighShelf.h"
+#include "source/filter/Notch.h"
+#include "source/filter/Bandpass.h"
+#include "source/filter/Allpass.h"
+#include "source/filter/BiquadCascade.h"
+#include "source/filter/ParametricEq.h"
+#include "source/filter/FilterDesigner.h"
+#include "source/filter/BiquadFixed.h"
+#include "source/filter/ConstantBiquad.h"
+#include "source/filter/FilterGroup.h"
+#include "source/filter/FilterPool.h"
+#include "source/filter/DcBlocker.h"
+#include "source/delay/DelayLine.h"
+#include "source/analysis/MeterBank.h"
+#include "source/dynamics/Dynamics.h"
+#include "source/utility/saturation.h"
+#include "source/nonlinear/Saturator.h"
+#include "source/utility/Smoother.h"
+#include "source/analysis/OctaveFilterBank.h"
+#include "source/analysis/TimeResponse.h"
+#include "source/graph/ProcessGraph.h"
+#include "source/utility/inline.h"
+
+// Header-only mode compiles the implementation into every translation unit
+#ifdef ADSP_HEADER_ONLY
+#include "ADSP.cpp"
+#endif
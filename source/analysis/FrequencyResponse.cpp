@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+    FrequencyResponse.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE FrequencyResponse::FrequencyResponse() {}
+ADSP_INLINE FrequencyResponse::~FrequencyResponse() {}
+
+ADSP_INLINE void FrequencyResponse::setFrequencies(const double *_frequencies,
+                                                   int numFrequencies,
+                                                   double sampleRate) {
+    frequencies.assign(_frequencies, _frequencies + numFrequencies);
+
+    cos1.resize(numFrequencies);
+    sin1.resize(numFrequencies);
+    cos2.resize(numFrequencies);
+    sin2.resize(numFrequencies);
+
+    for (int i = 0; i < numFrequencies; ++i) {
+        const double w = TWO_PI * frequencies[i] / sampleRate;
+        cos1[i] = cos(w);
+        sin1[i] = sin(w);
+        cos2[i] = cos(2.0 * w);
+        sin2[i] = sin(2.0 * w);
+    }
+
+    responseReal.resize(numFrequencies);
+    responseImag.resize(numFrequencies);
+    groupDelay.resize(numFrequencies);
+    magnitude.resize(numFrequencies);
+    magnitudedB.resize(numFrequencies);
+    phase.resize(numFrequencies);
+
+    clear();
+}
+
+ADSP_INLINE void FrequencyResponse::setLogFrequencies(int numFrequencies,
+                                                      double minFrequency,
+                                                      double maxFrequency,
+                                                      double sampleRate) {
+    std::vector<double> grid(numFrequencies);
+
+    const double logRatio = log(maxFrequency / minFrequency);
+    for (int i = 0; i < numFrequencies; ++i) {
+        const double position =
+            numFrequencies > 1 ? static_cast<double>(i) / (numFrequencies - 1)
+                               : 0.0;
+        grid[i] = minFrequency * exp(logRatio * position);
+    }
+
+    setFrequencies(grid.data(), numFrequencies, sampleRate);
+}
+
+ADSP_INLINE void FrequencyResponse::clear() {
+    std::fill(responseReal.begin(), responseReal.end(), 1.0);
+    std::fill(responseImag.begin(), responseImag.end(), 0.0);
+    std::fill(groupDelay.begin(), groupDelay.end(), 0.0);
+}
+
+//==============================================================================
+
+ADSP_INLINE void FrequencyResponse::addBiquad(const double *coefficients) {
+    const double n0 = coefficients[a0];
+    const double n1 = coefficients[a1];
+    const double n2 = coefficients[a2];
+    const double d1 = coefficients[b1];
+    const double d2 = coefficients[b2];
+
+    // Guards the group delay against zeros exactly on the unit circle
+    constexpr double tiny = 1e-300;
+
+    const double *c1 = cos1.data();
+    const double *s1 = sin1.data();
+    const double *c2 = cos2.data();
+    const double *s2 = sin2.data();
+    double *re = responseReal.data();
+    double *im = responseImag.data();
+    double *gd = groupDelay.data();
+
+    const int numFrequencies = static_cast<int>(frequencies.size());
+    for (int i = 0; i < numFrequencies; ++i) {
+        // Numerator and denominator evaluated at z = e^(jw)
+        const double numReal = n0 + n1 * c1[i] + n2 * c2[i];
+        const double numImag = -(n1 * s1[i] + n2 * s2[i]);
+        const double denReal = 1.0 + d1 * c1[i] + d2 * c2[i];
+        const double denImag = -(d1 * s1[i] + d2 * s2[i]);
+
+        const double invDenNorm =
+            1.0 / (denReal * denReal + denImag * denImag);
+
+        // H = N / D
+        const double hReal =
+            (numReal * denReal + numImag * denImag) * invDenNorm;
+        const double hImag =
+            (numImag * denReal - numReal * denImag) * invDenNorm;
+
+        // Accumulate complex product
+        const double accReal = re[i];
+        const double accImag = im[i];
+        re[i] = accReal * hReal - accImag * hImag;
+        im[i] = accReal * hImag + accImag * hReal;
+    }
+
+    // Separate pass for the group delay, keeps the number of arrays per loop low
+    // enough for the compiler to vectorize both loops
+    for (int i = 0; i < numFrequencies; ++i) {
+        const double numReal = n0 + n1 * c1[i] + n2 * c2[i];
+        const double numImag = -(n1 * s1[i] + n2 * s2[i]);
+        const double denReal = 1.0 + d1 * c1[i] + d2 * c2[i];
+        const double denImag = -(d1 * s1[i] + d2 * s2[i]);
+
+        const double numNorm = numReal * numReal + numImag * numImag + tiny;
+        const double denNorm = denReal * denReal + denImag * denImag;
+
+        // Group delay of a polynomial P is Re(sum(k * p_k * z^-k) / P)
+        const double numRampReal = n1 * c1[i] + 2.0 * n2 * c2[i];
+        const double numRampImag = -(n1 * s1[i] + 2.0 * n2 * s2[i]);
+        const double denRampReal = d1 * c1[i] + 2.0 * d2 * c2[i];
+        const double denRampImag = -(d1 * s1[i] + 2.0 * d2 * s2[i]);
+
+        gd[i] +=
+            (numRampReal * numReal + numRampImag * numImag) / numNorm -
+            (denRampReal * denReal + denRampImag * denImag) / denNorm;
+    }
+}
+
+ADSP_INLINE void FrequencyResponse::addCascade(
+    const double *const *coefficients, int numSections) {
+    for (int section = 0; section < numSections; ++section) {
+        addBiquad(coefficients[section]);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE int FrequencyResponse::getNumFrequencies() {
+    return static_cast<int>(frequencies.size());
+}
+
+ADSP_INLINE const double *FrequencyResponse::getFrequencies() {
+    return frequencies.data();
+}
+
+ADSP_INLINE const double *FrequencyResponse::getMagnitude() {
+    const int numFrequencies = static_cast<int>(frequencies.size());
+    for (int i = 0; i < numFrequencies; ++i) {
+        magnitude[i] = sqrt(responseReal[i] * responseReal[i] +
+                            responseImag[i] * responseImag[i]);
+    }
+    return magnitude.data();
+}
+
+ADSP_INLINE const double *FrequencyResponse::getMagnitudedB() {
+    // 20 * log10(|H|) = 10 * log10(|H|^2), saves the square root
+    const int numFrequencies = static_cast<int>(frequencies.size());
+    for (int i = 0; i < numFrequencies; ++i) {
+        magnitudedB[i] = 10.0 * log10(responseReal[i] * responseReal[i] +
+                                      responseImag[i] * responseImag[i]);
+    }
+    return magnitudedB.data();
+}
+
+ADSP_INLINE const double *FrequencyResponse::getPhase() {
+    const int numFrequencies = static_cast<int>(frequencies.size());
+    for (int i = 0; i < numFrequencies; ++i) {
+        phase[i] = atan2(responseImag[i], responseReal[i]);
+    }
+    return phase.data();
+}
+
+ADSP_INLINE const double *FrequencyResponse::getGroupDelay() {
+    return groupDelay.data();
+}
+}  // namespace adsp
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+    FrequencyResponse.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file FrequencyResponse.h
+*
+* @brief Frequency response evaluation of biquad coefficient sets
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../filter/Biquad.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Evaluates magnitude, phase and group delay of biquad cascades on a frequency grid
+*
+* The cosine and sine tables of the grid are computed once in setFrequencies(), adding a
+* section only costs a handful of multiply-adds and one complex division per frequency.
+* All loops run over contiguous arrays without branches, so they vectorize.
+*
+* Sections are accumulated as a complex product, magnitude and phase are only derived
+* when they are read out. Every getter has a buffer of its own, a returned array holds
+* the response at the time of the call and stays valid until the same getter is
+* called again or the grid is changed:
+*
+*     response.setLogFrequencies(1024, 20.0, 20000.0, sampleRate);
+*     response.clear();
+*     for (auto &band : bands) response.addFilter(band);
+*     const double *magnitudedB = response.getMagnitudedB();
+*/
+class FrequencyResponse {
+   public:
+    FrequencyResponse();
+    ~FrequencyResponse();
+
+    //==============================================================================
+
+    /**
+    * @brief Set the frequency grid, precompute tables and clear the response
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param frequencies Array of frequencies [Hz]
+    * @param numFrequencies Number of frequencies
+    * @param sampleRate Sample rate of the evaluated filters
+    */
+    void setFrequencies(const double *frequencies, int numFrequencies,
+                        double sampleRate);
+
+    /**
+    * @brief Set a logarithmically spaced frequency grid
+    *
+    * @param numFrequencies Number of frequencies (at least 2)
+    * @param minFrequency Lowest frequency [Hz]
+    * @param maxFrequency Highest frequency [Hz]
+    * @param sampleRate Sample rate of the evaluated filters
+    */
+    void setLogFrequencies(int numFrequencies, double minFrequency,
+                           double maxFrequency, double sampleRate);
+
+    /**
+    * @brief Reset the accumulated response to unity (no sections)
+    *
+    */
+    void clear();
+
+    //==============================================================================
+
+    /**
+    * @brief Multiply a second-order section into the accumulated response
+    *
+    * @param coefficients Array of numCoefficients filter coefficients (see filterCoefficients)
+    */
+    void addBiquad(const double *coefficients);
+
+    /**
+    * @brief Multiply a cascade of second-order sections into the accumulated response
+    *
+    * @param coefficients Array of numSections coefficient arrays
+    * @param numSections Number of sections
+    */
+    void addCascade(const double *const *coefficients, int numSections);
+
+    /**
+    * @brief Multiply any filter exposing getCoefficients() into the accumulated response
+    *
+    * @tparam Filter Biquad or one of the filter wrappers
+    * @param filter Filter to evaluate
+    */
+    template <typename Filter>
+    void addFilter(Filter &filter) {
+        addBiquad(filter.getCoefficients());
+    }
+
+    //==============================================================================
+
+    /**
+    * @brief Get number of frequencies in the grid
+    *
+    * @return Number of frequencies
+    */
+    int getNumFrequencies();
+
+    /**
+    * @brief Get the frequency grid
+    *
+    * @return Array of frequencies [Hz]
+    */
+    const double *getFrequencies();
+
+    /**
+    * @brief Get magnitude of the accumulated response
+    *
+    * @return Array of raw amplitude gains [1]
+    */
+    const double *getMagnitude();
+
+    /**
+    * @brief Get magnitude of the accumulated response in decibels
+    *
+    * @return Array of gains [dB]
+    */
+    const double *getMagnitudedB();
+
+    /**
+    * @brief Get phase of the accumulated response
+    *
+    * @return Array of phases in ]-pi, pi] [rad]
+    */
+    const double *getPhase();
+
+    /**
+    * @brief Get group delay of the accumulated response
+    *
+    * @return Array of group delays [samples]
+    */
+    const double *getGroupDelay();
+
+   protected:
+    /**
+    * @brief Frequency grid
+    */
+    std::vector<double> frequencies;
+
+    /**
+    * @brief Tables of cos(w), sin(w), cos(2w), sin(2w) of the grid
+    */
+    std::vector<double> cos1;
+    std::vector<double> sin1;
+    std::vector<double> cos2;
+    std::vector<double> sin2;
+
+    /**
+    * @brief Accumulated complex response
+    */
+    std::vector<double> responseReal;
+    std::vector<double> responseImag;
+
+    /**
+    * @brief Accumulated group delay
+    */
+    std::vector<double> groupDelay;
+
+    /**
+    * @brief Readout buffers, one per getter
+    */
+    std::vector<double> magnitude;
+    std::vector<double> magnitudedB;
+    std::vector<double> phase;
+};
+}  // namespace adsp
@@ -0,0 +1,396 @@
+/*
+  ==============================================================================
+    MeterBank.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "MeterBank.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+/**
+* @brief Convert a mean square to decibels, limited to METER_MIN_DB
+*/
+double meterPowerTodB(double power) {
+    return power > 0.0 ? std::max(10.0 * log10(power), METER_MIN_DB)
+                       : METER_MIN_DB;
+}
+
+/**
+* @brief Offset between the K-weighted mean square in dB and LUFS
+*/
+constexpr double LOUDNESS_OFFSET = -0.691;
+}  // namespace
+
+ADSP_INLINE void calculateKWeightingCoefficients(double *shelf,
+                                                 double *highpass,
+                                                 double sampleRate) {
+    // Analog prototype of the shelf as published with the 48 kHz coefficients
+    const double shelfFrequency = 1681.974450955533;
+    const double shelfGain = 3.999843853973347;  // dB
+    const double shelfQ = 0.7071752369554196;
+
+    double k = tan(PI * shelfFrequency / sampleRate);
+    const double highGain = pow(10.0, shelfGain / 20.0);
+    const double bandGain = pow(highGain, 0.4996667741545416);
+    double norm = 1.0 / (1.0 + k / shelfQ + k * k);
+
+    shelf[a0] = (highGain + bandGain * k / shelfQ + k * k) * norm;
+    shelf[a1] = 2.0 * (k * k - highGain) * norm;
+    shelf[a2] = (highGain - bandGain * k / shelfQ + k * k) * norm;
+    shelf[b1] = 2.0 * (k * k - 1.0) * norm;
+    shelf[b2] = (1.0 - k / shelfQ + k * k) * norm;
+
+    // Highpass with unity numerator as in the standard
+    const double highpassFrequency = 38.13547087602444;
+    const double highpassQ = 0.5003270373238773;
+
+    k = tan(PI * highpassFrequency / sampleRate);
+    norm = 1.0 / (1.0 + k / highpassQ + k * k);
+
+    highpass[a0] = 1.0;
+    highpass[a1] = -2.0;
+    highpass[a2] = 1.0;
+    highpass[b1] = 2.0 * (k * k - 1.0) * norm;
+    highpass[b2] = (1.0 - k / highpassQ + k * k) * norm;
+}
+
+//==============================================================================
+
+ADSP_INLINE MeterBank::MeterBank() {}
+ADSP_INLINE MeterBank::~MeterBank() {}
+
+//==============================================================================
+
+ADSP_INLINE void MeterBank::reset(int _numChannels, double _sampleRate) {
+    numChannels = _numChannels;
+    sampleRate = _sampleRate;
+
+    blockSize =
+        std::max(1, static_cast<int>(lround(sampleRate * METER_BLOCK_TIME)));
+    blockRemaining = blockSize;
+    ringPosition = 0;
+
+    const size_t channels = static_cast<size_t>(numChannels);
+    peak.assign(channels, 0.0);
+    energy.assign(channels, 0.0);
+    weightedEnergy.assign(channels, 0.0);
+    shelfZ1.assign(channels, 0.0);
+    shelfZ2.assign(channels, 0.0);
+    highpassZ1.assign(channels, 0.0);
+    highpassZ2.assign(channels, 0.0);
+
+    energyRing.assign(channels * METER_MAX_BLOCKS, 0.0);
+    weightedEnergyRing.assign(channels * METER_MAX_BLOCKS, 0.0);
+
+    rmsSum.assign(channels, 0.0);
+    momentarySum.assign(channels, 0.0);
+    shortTermSum.assign(channels, 0.0);
+
+    calculateKWeightingCoefficients(shelfCoefficients, highpassCoefficients,
+                                    sampleRate);
+    calculateCoefficients();
+    updateRmsWindow();
+}
+
+ADSP_INLINE void MeterBank::processInterleaved(const double *in,
+                                               int numFrames) {
+    ADSP_REALTIME_SECTION();
+
+    int offset = 0;
+    while (offset < numFrames) {
+        // Segments end at integration block boundaries
+        const int numSegment = std::min(blockRemaining, numFrames - offset);
+
+        for (int base = 0; base < numChannels; base += METER_BANK_LANES) {
+            const int count = std::min(numChannels - base, METER_BANK_LANES);
+
+            const double *lanes[METER_BANK_LANES];
+            for (int lane = 0; lane < count; ++lane) {
+                lanes[lane] = in + offset * numChannels + base + lane;
+            }
+
+            processGroup(base, count, lanes, numChannels, numSegment);
+        }
+
+        offset += numSegment;
+        blockRemaining -= numSegment;
+        if (blockRemaining == 0) {
+            finishBlock();
+        }
+    }
+}
+
+ADSP_INLINE void MeterBank::processPlanar(const double *const *in,
+                                          int numFrames) {
+    ADSP_REALTIME_SECTION();
+
+    int offset = 0;
+    while (offset < numFrames) {
+        // Segments end at integration block boundaries
+        const int numSegment = std::min(blockRemaining, numFrames - offset);
+
+        for (int base = 0; base < numChannels; base += METER_BANK_LANES) {
+            const int count = std::min(numChannels - base, METER_BANK_LANES);
+
+            const double *lanes[METER_BANK_LANES];
+            for (int lane = 0; lane < count; ++lane) {
+                lanes[lane] = in[base + lane] + offset;
+            }
+
+            processGroup(base, count, lanes, 1, numSegment);
+        }
+
+        offset += numSegment;
+        blockRemaining -= numSegment;
+        if (blockRemaining == 0) {
+            finishBlock();
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE double MeterBank::getPeakdB(int channel) {
+    return meterPowerTodB(peak[channel] * peak[channel]);
+}
+
+ADSP_INLINE double MeterBank::getRmsdB(int channel) {
+    return meterPowerTodB(rmsSum[channel] / (rmsBlocks * blockSize));
+}
+
+ADSP_INLINE void MeterBank::getLevelsdB(double *peakdB, double *rmsdB) {
+    for (int channel = 0; channel < numChannels; ++channel) {
+        peakdB[channel] = getPeakdB(channel);
+        rmsdB[channel] = getRmsdB(channel);
+    }
+}
+
+ADSP_INLINE double MeterBank::getMomentaryLoudness(int channel) {
+    return LOUDNESS_OFFSET +
+           meterPowerTodB(momentarySum[channel] /
+                          (METER_MOMENTARY_BLOCKS * blockSize));
+}
+
+ADSP_INLINE double MeterBank::getShortTermLoudness(int channel) {
+    return LOUDNESS_OFFSET +
+           meterPowerTodB(shortTermSum[channel] /
+                          (METER_MAX_BLOCKS * blockSize));
+}
+
+ADSP_INLINE double MeterBank::getProgramMomentaryLoudness() {
+    double sum = 0.0;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        sum += momentarySum[channel];
+    }
+    return LOUDNESS_OFFSET +
+           meterPowerTodB(sum / (METER_MOMENTARY_BLOCKS * blockSize));
+}
+
+ADSP_INLINE double MeterBank::getProgramShortTermLoudness() {
+    double sum = 0.0;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        sum += shortTermSum[channel];
+    }
+    return LOUDNESS_OFFSET +
+           meterPowerTodB(sum / (METER_MAX_BLOCKS * blockSize));
+}
+
+//==============================================================================
+
+ADSP_INLINE int MeterBank::getNumChannels() { return numChannels; }
+
+ADSP_INLINE MeterBankParams MeterBank::getParameters() { return params; }
+
+ADSP_INLINE void MeterBank::setParameters(const MeterBankParams &parameters) {
+    // If new parameters differ..
+    if (parameters.peakAttack != params.peakAttack ||
+        parameters.peakRelease != params.peakRelease ||
+        parameters.rmsWindow != params.rmsWindow) {
+        const bool windowChanged = parameters.rmsWindow != params.rmsWindow;
+
+        params = parameters;
+
+        calculateCoefficients();
+        if (windowChanged) {
+            updateRmsWindow();
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void MeterBank::processGroup(int base, int count,
+                                         const double *const *in, int stride,
+                                         int numFrames) {
+    // State of the group lives in local arrays for the whole segment, so the lane
+    // loop only touches memory the compiler knows is not aliased.
+    // Unused lanes meter silence.
+    double pk[METER_BANK_LANES] = {};
+    double e[METER_BANK_LANES] = {};
+    double we[METER_BANK_LANES] = {};
+    double s1[METER_BANK_LANES] = {};
+    double s2[METER_BANK_LANES] = {};
+    double h1[METER_BANK_LANES] = {};
+    double h2[METER_BANK_LANES] = {};
+    for (int lane = 0; lane < count; ++lane) {
+        pk[lane] = peak[base + lane];
+        e[lane] = energy[base + lane];
+        we[lane] = weightedEnergy[base + lane];
+        s1[lane] = shelfZ1[base + lane];
+        s2[lane] = shelfZ2[base + lane];
+        h1[lane] = highpassZ1[base + lane];
+        h2[lane] = highpassZ2[base + lane];
+    }
+
+    const double attack = attackCoefficient;
+    const double release = releaseCoefficient;
+
+    const double sa0 = shelfCoefficients[a0];
+    const double sa1 = shelfCoefficients[a1];
+    const double sa2 = shelfCoefficients[a2];
+    const double sb1 = shelfCoefficients[b1];
+    const double sb2 = shelfCoefficients[b2];
+    const double hb1 = highpassCoefficients[b1];
+    const double hb2 = highpassCoefficients[b2];
+
+    for (int n = 0; n < numFrames; ++n) {
+        double x[METER_BANK_LANES] = {};
+        for (int lane = 0; lane < count; ++lane) {
+            x[lane] = in[lane][n * stride];
+        }
+
+        for (int lane = 0; lane < METER_BANK_LANES; ++lane) {
+            // Peak follower, attack while rising and release while falling
+            const double level = fabs(x[lane]);
+            const double coefficient = level > pk[lane] ? attack : release;
+            pk[lane] = coefficient * (pk[lane] - level) + level;
+
+            e[lane] += x[lane] * x[lane];
+
+            // K-weighting, two sections in transposed canonical form
+            const double shelf = sa0 * x[lane] + s1[lane];
+            s1[lane] = sa1 * x[lane] - sb1 * shelf + s2[lane];
+            s2[lane] = sa2 * x[lane] - sb2 * shelf;
+
+            // Highpass numerator is 1 - 2z^-1 + z^-2
+            const double weighted = shelf + h1[lane];
+            h1[lane] = -2.0 * shelf - hb1 * weighted + h2[lane];
+            h2[lane] = shelf - hb2 * weighted;
+
+            we[lane] += weighted * weighted;
+        }
+    }
+
+    for (int lane = 0; lane < count; ++lane) {
+        fixUnderflow(pk[lane]);
+        fixUnderflow(s1[lane]);
+        fixUnderflow(s2[lane]);
+        fixUnderflow(h1[lane]);
+        fixUnderflow(h2[lane]);
+        peak[base + lane] = pk[lane];
+        energy[base + lane] = e[lane];
+        weightedEnergy[base + lane] = we[lane];
+        shelfZ1[base + lane] = s1[lane];
+        shelfZ2[base + lane] = s2[lane];
+        highpassZ1[base + lane] = h1[lane];
+        highpassZ2[base + lane] = h2[lane];
+    }
+}
+
+ADSP_INLINE void MeterBank::finishBlock() {
+    ringPosition = (ringPosition + 1) % METER_MAX_BLOCKS;
+
+    // Blocks leaving the windows, the short-term window spans the whole ring
+    const int rmsLeaving =
+        (ringPosition - rmsBlocks + METER_MAX_BLOCKS) % METER_MAX_BLOCKS;
+    const int momentaryLeaving =
+        (ringPosition - METER_MOMENTARY_BLOCKS + METER_MAX_BLOCKS) %
+        METER_MAX_BLOCKS;
+
+    double *newest = &energyRing[ringPosition * numChannels];
+    double *weightedNewest = &weightedEnergyRing[ringPosition * numChannels];
+    const double *rmsOldest = &energyRing[rmsLeaving * numChannels];
+    const double *momentaryOldest =
+        &weightedEnergyRing[momentaryLeaving * numChannels];
+
+    // Running sums, limited to zero against rounding drift
+    for (int channel = 0; channel < numChannels; ++channel) {
+        rmsSum[channel] = std::max(
+            rmsSum[channel] + energy[channel] - rmsOldest[channel], 0.0);
+        momentarySum[channel] =
+            std::max(momentarySum[channel] + weightedEnergy[channel] -
+                         momentaryOldest[channel],
+                     0.0);
+        shortTermSum[channel] =
+            std::max(shortTermSum[channel] + weightedEnergy[channel] -
+                         weightedNewest[channel],
+                     0.0);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        newest[channel] = energy[channel];
+        weightedNewest[channel] = weightedEnergy[channel];
+        energy[channel] = 0.0;
+        weightedEnergy[channel] = 0.0;
+    }
+
+    blockRemaining = blockSize;
+}
+
+ADSP_INLINE void MeterBank::updateRmsWindow() {
+    rmsBlocks = static_cast<int>(
+        lround(params.rmsWindow * 0.001 / METER_BLOCK_TIME));
+    rmsBlocks = std::min(std::max(rmsBlocks, 1), METER_MAX_BLOCKS);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        double sum = 0.0;
+        for (int block = 0; block < rmsBlocks; ++block) {
+            const int position =
+                (ringPosition - block + METER_MAX_BLOCKS) % METER_MAX_BLOCKS;
+            sum += energyRing[position * numChannels + channel];
+        }
+        rmsSum[channel] = sum;
+    }
+}
+
+ADSP_INLINE void MeterBank::calculateCoefficients() {
+    // One-pole time constants, 0 ms gives an instant response
+    attackCoefficient = params.peakAttack > 0.0
+                            ? exp(-1000.0 / (params.peakAttack * sampleRate))
+                            : 0.0;
+    releaseCoefficient =
+        params.peakRelease > 0.0
+            ? exp(-1000.0 / (params.peakRelease * sampleRate))
+            : 0.0;
+}
+}  // namespace adsp
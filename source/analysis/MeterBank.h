@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+    MeterBank.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file MeterBank.h
+*
+* @brief Multichannel peak, RMS and loudness (LUFS) metering
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+#include "../filter/Biquad.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Number of channels MeterBank processes side by side
+*/
+constexpr int METER_BANK_LANES = 8;
+
+/**
+* @brief Length of the integration blocks the windows are built from
+*/
+constexpr double METER_BLOCK_TIME = 0.01;  // s
+
+/**
+* @brief Number of integration blocks of the longest window (short-term loudness, 3 s)
+*/
+constexpr int METER_MAX_BLOCKS = 300;
+
+/**
+* @brief Number of integration blocks of the momentary loudness window (400 ms)
+*/
+constexpr int METER_MOMENTARY_BLOCKS = 40;
+
+/**
+* @brief Level reported for silence
+*/
+constexpr double METER_MIN_DB = -150.0;
+
+/**
+* @brief Calculate the K-weighting pre-filter of ITU-R BS.1770
+*
+* Two second-order sections, a high shelf modelling the head (+4 dB above ~1.7 kHz)
+* and a highpass at ~38 Hz. Matches the coefficients tabulated in the standard at
+* 48 kHz and keeps the analog prototype at other sample rates.
+*
+* @param shelf Array of numCoefficients coefficients of the shelf section
+* @param highpass Array of numCoefficients coefficients of the highpass section
+* @param sampleRate Sample rate [Hz]
+*/
+void calculateKWeightingCoefficients(double *shelf, double *highpass,
+                                     double sampleRate);
+
+/**
+* @brief Meter bank parameter structure
+*
+*/
+struct MeterBankParams {
+    MeterBankParams() {}
+
+    MeterBankParams &operator=(const MeterBankParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            peakAttack = parameters.peakAttack;
+            peakRelease = parameters.peakRelease;
+            rmsWindow = parameters.rmsWindow;
+            return *this;
+        }
+    }
+
+    // Attack time constant of the peak follower, 0 for instant attack
+    double peakAttack = 0.0;  // ms
+
+    // Release time constant of the peak follower
+    double peakRelease = 300.0;  // ms
+
+    // Length of the rectangular RMS window, rounded to integration blocks
+    double rmsWindow = 300.0;  // ms
+};
+
+//==============================================================================
+
+/**
+* @brief Peak, RMS and loudness meters for many channels
+*
+* Per sample, each channel runs an attack/release peak follower, accumulates its energy
+* and the energy of its K-weighted signal. Every METER_BLOCK_TIME the accumulated
+* energies are pushed into ring buffers, from which the rectangular RMS window and the
+* momentary (400 ms) and short-term (3 s) loudness windows are kept as running sums.
+*
+* State is stored as one array per quantity (structure of arrays). Groups of
+* METER_BANK_LANES channels run in lockstep with the channel loop innermost, so the
+* compiler processes several channels per instruction. No logarithms are taken while
+* processing, levels are converted to dB only by the getters (at the readout rate).
+* Metering 128 channels costs about 2 % of a 512 sample callback at 48 kHz (GCC -O2,
+* SSE2, one core of a virtualized x86-64 server), see the benchmark suite.
+*
+* Reading from another thread than the audio thread gives approximate values, the
+* counters are not synchronized.
+*/
+class MeterBank {
+   public:
+    MeterBank();
+    ~MeterBank();
+
+    //==============================================================================
+
+    /**
+    * @brief Allocate channels, clear all meters and set sample rate
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param numChannels Number of channels
+    * @param sampleRate New sample rate
+    */
+    void reset(int numChannels, double sampleRate);
+
+    /**
+    * @brief Meter an interleaved block
+    *
+    * @param in Interleaved input, numFrames * numChannels values
+    * @param numFrames Number of samples per channel
+    */
+    void processInterleaved(const double *in, int numFrames);
+
+    /**
+    * @brief Meter a block of separate channel buffers
+    *
+    * @param in Array of numChannels channel buffers
+    * @param numFrames Number of samples per channel
+    */
+    void processPlanar(const double *const *in, int numFrames);
+
+    //==============================================================================
+
+    /**
+    * @brief Get the peak follower level of one channel
+    *
+    * @param channel Channel index
+    * @return Peak level [dBFS]
+    */
+    double getPeakdB(int channel);
+
+    /**
+    * @brief Get the windowed RMS level of one channel
+    *
+    * @param channel Channel index
+    * @return RMS level [dBFS], a full scale sine reads -3 dB
+    */
+    double getRmsdB(int channel);
+
+    /**
+    * @brief Get peak and RMS levels of all channels
+    *
+    * @param peakdB Array of numChannels peak levels [dBFS]
+    * @param rmsdB Array of numChannels RMS levels [dBFS]
+    */
+    void getLevelsdB(double *peakdB, double *rmsdB);
+
+    /**
+    * @brief Get the momentary loudness (400 ms window) of one channel
+    *
+    * @param channel Channel index
+    * @return Loudness [LUFS]
+    */
+    double getMomentaryLoudness(int channel);
+
+    /**
+    * @brief Get the short-term loudness (3 s window) of one channel
+    *
+    * @param channel Channel index
+    * @return Loudness [LUFS]
+    */
+    double getShortTermLoudness(int channel);
+
+    /**
+    * @brief Get the momentary loudness of all channels together
+    *
+    * Sums the channel energies with equal weights (e.g. stereo). Surround
+    * layouts weight the surround channels by +1.5 dB and exclude the LFE.
+    *
+    * @return Loudness [LUFS]
+    */
+    double getProgramMomentaryLoudness();
+
+    /**
+    * @brief Get the short-term loudness of all channels together
+    *
+    * @return Loudness [LUFS]
+    */
+    double getProgramShortTermLoudness();
+
+    //==============================================================================
+
+    /**
+    * @brief Get number of channels
+    *
+    * @return Number of channels
+    */
+    int getNumChannels();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Meter bank parameters
+    */
+    MeterBankParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * Real-time safe.
+    *
+    * @param parameters New meter bank parameters
+    */
+    void setParameters(const MeterBankParams &parameters);
+
+   protected:
+    /**
+    * @brief Run the per-sample meters of one channel group over a segment
+    *
+    * @param base First channel of the group
+    * @param count Number of channels in the group
+    * @param in Array of count pointers to the first sample of each channel
+    * @param stride Distance between consecutive samples of a channel
+    * @param numFrames Number of samples, does not cross an integration block
+    */
+    void processGroup(int base, int count, const double *const *in, int stride,
+                      int numFrames);
+
+    /**
+    * @brief Push the accumulated energies into the windows
+    */
+    void finishBlock();
+
+    /**
+    * @brief Sum the ring into the RMS window, after the window length changed
+    */
+    void updateRmsWindow();
+
+    /**
+    * @brief Calculate the follower coefficients
+    */
+    void calculateCoefficients();
+
+    /**
+    * @brief Meter bank parameters
+    */
+    MeterBankParams params;
+
+    /**
+    * @brief Number of channels
+    */
+    int numChannels{0};
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Samples per integration block and samples left in the current one
+    */
+    int blockSize{480};
+    int blockRemaining{480};
+
+    /**
+    * @brief Length of the RMS window in integration blocks
+    */
+    int rmsBlocks{30};
+
+    /**
+    * @brief Ring position of the newest integration block
+    */
+    int ringPosition{0};
+
+    /**
+    * @brief Peak follower coefficients
+    */
+    double attackCoefficient{0.0};
+    double releaseCoefficient{0.0};
+
+    /**
+    * @brief K-weighting coefficients (shelf, highpass)
+    */
+    double shelfCoefficients[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    double highpassCoefficients[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+    /**
+    * @brief Per-channel state
+    */
+    std::vector<double> peak;
+    std::vector<double> energy;
+    std::vector<double> weightedEnergy;
+    std::vector<double> shelfZ1;
+    std::vector<double> shelfZ2;
+    std::vector<double> highpassZ1;
+    std::vector<double> highpassZ2;
+
+    /**
+    * @brief Energies of the last METER_MAX_BLOCKS integration blocks,
+    * index block * numChannels + channel
+    */
+    std::vector<double> energyRing;
+    std::vector<double> weightedEnergyRing;
+
+    /**
+    * @brief Running window sums per channel
+    */
+    std::vector<double> rmsSum;
+    std::vector<double> momentarySum;
+    std::vector<double> shortTermSum;
+};
+}  // namespace adsp
@@ -0,0 +1,398 @@
+/*
+  ==============================================================================
+    OctaveFilterBank.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file OctaveFilterBank.cpp
+*
+* @brief Multirate 1/N-octave filter bank for real-time analysers
+*/
+
+#include "OctaveFilterBank.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+/**
+* @brief Reference frequency of the band center series
+*/
+constexpr double OCTAVE_BANK_REFERENCE = 1000.0;  // Hz
+
+/**
+* @brief Upper band edges stay below this fraction of their processing rate
+*/
+constexpr double OCTAVE_BANK_EDGE_LIMIT = 0.2;
+
+/**
+* @brief Band centers and upper edges stay below this fraction of the sample rate
+*/
+constexpr double OCTAVE_BANK_NYQUIST_LIMIT = 0.45;
+
+/**
+* @brief Halfband decimators, about 70 dB alias rejection below 0.4 of the lower rate
+*/
+constexpr int OCTAVE_BANK_HALFBAND_COEFFICIENTS = 4;
+constexpr double OCTAVE_BANK_HALFBAND_TRANSITION = 0.1;
+
+/**
+* @brief Design the sections of a sixth-order Butterworth bandpass
+*
+* Lowpass to bandpass transformation of the third-order prototype between the
+* prewarped edges, one section per pole pair, each with unity gain at the center.
+*/
+void designOctaveBand(double *gain, double *b1, double *b2, double lowEdge,
+                      double highEdge, double rate) {
+    const double w1 = tan(PI * lowEdge / rate);
+    const double w2 = tan(PI * highEdge / rate);
+    const double w0 = sqrt(w1 * w2);
+    const double bandwidth = w2 - w1;
+
+    // Center frequency on the unit circle
+    const std::complex<double> center = std::polar(1.0, -2.0 * atan(w0));
+
+    int section = 0;
+    for (int k = 0; k < OCTAVE_BANK_SECTIONS; ++k) {
+        const std::complex<double> prototype = std::polar(
+            1.0, PI * (2 * k + OCTAVE_BANK_SECTIONS + 1) /
+                     (2 * OCTAVE_BANK_SECTIONS));
+
+        // Each prototype pole maps to the roots of s^2 - p B s + w0^2
+        const std::complex<double> root =
+            sqrt(prototype * prototype * bandwidth * bandwidth - 4.0 * w0 * w0);
+        for (double sign : {1.0, -1.0}) {
+            const std::complex<double> s =
+                0.5 * (prototype * bandwidth + sign * root);
+
+            // Keep one pole of each conjugate pair
+            if (s.imag() <= 0.0 || section == OCTAVE_BANK_SECTIONS) {
+                continue;
+            }
+
+            const std::complex<double> z = (1.0 + s) / (1.0 - s);
+            b1[section] = -2.0 * z.real();
+            b2[section] = std::norm(z);
+
+            const std::complex<double> numerator = 1.0 - center * center;
+            const std::complex<double> denominator =
+                1.0 + b1[section] * center + b2[section] * center * center;
+            gain[section] = std::abs(denominator) / std::abs(numerator);
+
+            ++section;
+        }
+    }
+}
+}  // namespace
+
+ADSP_INLINE OctaveFilterBank::OctaveFilterBank() {}
+ADSP_INLINE OctaveFilterBank::~OctaveFilterBank() {}
+
+//==============================================================================
+
+ADSP_INLINE void OctaveFilterBank::reset(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    // Sized for the most bands, so setParameters() does not allocate
+    const size_t sections = OCTAVE_BANK_MAX_BANDS * OCTAVE_BANK_SECTIONS;
+    gains.assign(sections, 0.0);
+    b1s.assign(sections, 0.0);
+    b2s.assign(sections, 0.0);
+    z1s.assign(sections, 0.0);
+    z2s.assign(sections, 0.0);
+
+    frequencies.assign(OCTAVE_BANK_MAX_BANDS, 0.0);
+    bandStages.assign(OCTAVE_BANK_MAX_BANDS, 0);
+    energies.assign(OCTAVE_BANK_MAX_BANDS, 0.0);
+    levels.assign(OCTAVE_BANK_MAX_BANDS, 0.0);
+
+    // One odd sample is carried over from the previous block
+    decimationBuffer.assign(OCTAVE_BANK_BLOCK_SIZE + 1, 0.0);
+    stageBuffers.assign(OCTAVE_BANK_MAX_STAGES * OCTAVE_BANK_BLOCK_SIZE, 0.0);
+
+    for (int stage = 0; stage < OCTAVE_BANK_MAX_STAGES; ++stage) {
+        decimators[stage].setup(OCTAVE_BANK_HALFBAND_COEFFICIENTS,
+                                OCTAVE_BANK_HALFBAND_TRANSITION);
+    }
+
+    designBands();
+}
+
+ADSP_INLINE void OctaveFilterBank::processBlock(const double *in,
+                                                int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (numSamples <= 0) {
+        return;
+    }
+
+    std::fill(energies.begin(), energies.begin() + numBands, 0.0);
+
+    int offset = 0;
+    while (offset < numSamples) {
+        const int numChunk =
+            std::min(OCTAVE_BANK_BLOCK_SIZE, numSamples - offset);
+
+        const double *signal = in + offset;
+        int length = numChunk;
+
+        for (int stage = 0; stage < numStages; ++stage) {
+            if (stage > 0) {
+                // Decimate the signal of the stage above, odd samples wait for the
+                // next chunk
+                double *input = &decimationBuffer[0];
+                int numInput = 0;
+                if (hasPending[stage]) {
+                    input[numInput++] = pending[stage];
+                }
+                std::copy(signal, signal + length, input + numInput);
+                numInput += length;
+
+                hasPending[stage] = numInput % 2 != 0;
+                if (hasPending[stage]) {
+                    pending[stage] = input[numInput - 1];
+                }
+
+                double *output = &stageBuffers[stage * OCTAVE_BANK_BLOCK_SIZE];
+                length = numInput / 2;
+                decimators[stage - 1].downsample(input, output, length);
+                signal = output;
+            }
+
+            const int first = stageFirstBand[stage];
+            const int last = first + stageNumBands[stage];
+            for (int band = first; band < last; band += OCTAVE_BANK_LANES) {
+                processGroup(band, std::min(last - band, OCTAVE_BANK_LANES),
+                             signal, length, static_cast<double>(1 << stage));
+            }
+        }
+
+        offset += numChunk;
+    }
+
+    // Exponential averaging once per block
+    const double timeConstant = params.integrationTime * 0.001 * sampleRate;
+    const double coefficient =
+        timeConstant > 0.0 ? 1.0 - exp(-numSamples / timeConstant) : 1.0;
+    for (int band = 0; band < numBands; ++band) {
+        const double power = energies[band] / numSamples;
+        levels[band] += coefficient * (power - levels[band]);
+        fixUnderflow(levels[band]);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE int OctaveFilterBank::getNumBands() { return numBands; }
+
+ADSP_INLINE double OctaveFilterBank::getBandFrequency(int band) {
+    return frequencies[band];
+}
+
+ADSP_INLINE int OctaveFilterBank::getBandDecimation(int band) {
+    return 1 << bandStages[band];
+}
+
+ADSP_INLINE double OctaveFilterBank::getBandEnergy(int band) {
+    return energies[band];
+}
+
+ADSP_INLINE double OctaveFilterBank::getBandLeveldB(int band) {
+    return levels[band] > 0.0
+               ? std::max(10.0 * log10(levels[band]), METER_MIN_DB)
+               : METER_MIN_DB;
+}
+
+ADSP_INLINE void OctaveFilterBank::getBandLevelsdB(double *levelsdB) {
+    for (int band = 0; band < numBands; ++band) {
+        levelsdB[band] = getBandLeveldB(band);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE OctaveFilterBankParams OctaveFilterBank::getParameters() {
+    return params;
+}
+
+ADSP_INLINE void OctaveFilterBank::setParameters(
+    const OctaveFilterBankParams &parameters) {
+    const int bandsPerOctave = std::min(std::max(parameters.bandsPerOctave, 1),
+                                        OCTAVE_BANK_MAX_BANDS_PER_OCTAVE);
+
+    // If new parameters differ..
+    if (bandsPerOctave != params.bandsPerOctave ||
+        parameters.integrationTime != params.integrationTime) {
+        const bool bandsChanged = bandsPerOctave != params.bandsPerOctave;
+
+        params = parameters;
+        params.bandsPerOctave = bandsPerOctave;
+
+        // Before reset() there is nothing to design
+        if (bandsChanged && !frequencies.empty()) {
+            designBands();
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void OctaveFilterBank::designBands() {
+    const int bandsPerOctave = params.bandsPerOctave;
+    const double halfBand = 0.5 / bandsPerOctave;
+
+    // Centers closest to the frequency limits
+    const int firstIndex = static_cast<int>(
+        lround(bandsPerOctave * log2(MIN_FILTER_FREQ / OCTAVE_BANK_REFERENCE)));
+    const int lastIndex = static_cast<int>(
+        lround(bandsPerOctave * log2(MAX_FILTER_FREQ / OCTAVE_BANK_REFERENCE)));
+
+    numBands = 0;
+    numStages = 1;
+    for (int stage = 0; stage < OCTAVE_BANK_MAX_STAGES; ++stage) {
+        stageFirstBand[stage] = 0;
+        stageNumBands[stage] = 0;
+    }
+
+    // Descending, so the stage of a band never increases
+    for (int index = lastIndex; index >= firstIndex; --index) {
+        const double fc = OCTAVE_BANK_REFERENCE *
+                          pow(2.0, static_cast<double>(index) / bandsPerOctave);
+        if (fc > OCTAVE_BANK_NYQUIST_LIMIT * sampleRate) {
+            continue;
+        }
+        const double highEdge =
+            std::min(fc * pow(2.0, halfBand),
+                     OCTAVE_BANK_NYQUIST_LIMIT * sampleRate);
+
+        int stage = 0;
+        while (stage + 1 < OCTAVE_BANK_MAX_STAGES &&
+               highEdge <= OCTAVE_BANK_EDGE_LIMIT * sampleRate / (2 << stage)) {
+            ++stage;
+        }
+
+        frequencies[numBands] = fc;
+        bandStages[numBands] = stage;
+        designOctaveBand(&gains[numBands * OCTAVE_BANK_SECTIONS],
+                         &b1s[numBands * OCTAVE_BANK_SECTIONS],
+                         &b2s[numBands * OCTAVE_BANK_SECTIONS],
+                         fc * pow(2.0, -halfBand), highEdge,
+                         sampleRate / (1 << stage));
+        numStages = std::max(numStages, stage + 1);
+        ++numBands;
+    }
+
+    // Ascending band order, the bands of each stage stay contiguous
+    std::reverse(frequencies.begin(), frequencies.begin() + numBands);
+    std::reverse(bandStages.begin(), bandStages.begin() + numBands);
+    for (int band = 0; band < numBands / 2; ++band) {
+        for (int section = 0; section < OCTAVE_BANK_SECTIONS; ++section) {
+            const int lower = band * OCTAVE_BANK_SECTIONS + section;
+            const int upper =
+                (numBands - 1 - band) * OCTAVE_BANK_SECTIONS + section;
+            std::swap(gains[lower], gains[upper]);
+            std::swap(b1s[lower], b1s[upper]);
+            std::swap(b2s[lower], b2s[upper]);
+        }
+    }
+
+    for (int band = numBands - 1; band >= 0; --band) {
+        stageFirstBand[bandStages[band]] = band;
+        ++stageNumBands[bandStages[band]];
+    }
+
+    std::fill(z1s.begin(), z1s.end(), 0.0);
+    std::fill(z2s.begin(), z2s.end(), 0.0);
+    std::fill(energies.begin(), energies.end(), 0.0);
+    std::fill(levels.begin(), levels.end(), 0.0);
+    for (int stage = 0; stage < OCTAVE_BANK_MAX_STAGES; ++stage) {
+        decimators[stage].reset();
+        hasPending[stage] = false;
+        pending[stage] = 0.0;
+    }
+}
+
+ADSP_INLINE void OctaveFilterBank::processGroup(int first, int count,
+                                                const double *x,
+                                                int numSamples, double weight) {
+    // Coefficients and state of the group live in local arrays, so the lane loops
+    // only touch memory the compiler knows is not aliased. Unused lanes stay silent.
+    double g[OCTAVE_BANK_SECTIONS][OCTAVE_BANK_LANES] = {};
+    double c1[OCTAVE_BANK_SECTIONS][OCTAVE_BANK_LANES] = {};
+    double c2[OCTAVE_BANK_SECTIONS][OCTAVE_BANK_LANES] = {};
+    double s1[OCTAVE_BANK_SECTIONS][OCTAVE_BANK_LANES] = {};
+    double s2[OCTAVE_BANK_SECTIONS][OCTAVE_BANK_LANES] = {};
+    double e[OCTAVE_BANK_LANES] = {};
+    for (int lane = 0; lane < count; ++lane) {
+        for (int section = 0; section < OCTAVE_BANK_SECTIONS; ++section) {
+            const int index = (first + lane) * OCTAVE_BANK_SECTIONS + section;
+            g[section][lane] = gains[index];
+            c1[section][lane] = b1s[index];
+            c2[section][lane] = b2s[index];
+            s1[section][lane] = z1s[index];
+            s2[section][lane] = z2s[index];
+        }
+    }
+
+    for (int n = 0; n < numSamples; ++n) {
+        double v[OCTAVE_BANK_LANES];
+        for (int lane = 0; lane < OCTAVE_BANK_LANES; ++lane) {
+            v[lane] = x[n];
+        }
+
+        // Transposed canonical form, the numerator is 1 - z^-2
+        for (int section = 0; section < OCTAVE_BANK_SECTIONS; ++section) {
+            for (int lane = 0; lane < OCTAVE_BANK_LANES; ++lane) {
+                const double in = g[section][lane] * v[lane];
+                const double y = in + s1[section][lane];
+                s1[section][lane] = s2[section][lane] - c1[section][lane] * y;
+                s2[section][lane] = -in - c2[section][lane] * y;
+                v[lane] = y;
+            }
+        }
+
+        for (int lane = 0; lane < OCTAVE_BANK_LANES; ++lane) {
+            e[lane] += v[lane] * v[lane];
+        }
+    }
+
+    for (int lane = 0; lane < count; ++lane) {
+        for (int section = 0; section < OCTAVE_BANK_SECTIONS; ++section) {
+            const int index = (first + lane) * OCTAVE_BANK_SECTIONS + section;
+            fixUnderflow(s1[section][lane]);
+            fixUnderflow(s2[section][lane]);
+            z1s[index] = s1[section][lane];
+            z2s[index] = s2[section][lane];
+        }
+        energies[first + lane] += weight * e[lane];
+    }
+}
+}  // namespace adsp
@@ -0,0 +1,308 @@
+/*
+  ==============================================================================
+    OctaveFilterBank.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file OctaveFilterBank.h
+*
+* @brief Multirate 1/N-octave filter bank for real-time analysers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+#include "../oversampling/HalfbandIir.h"
+#include "../utility/utility.h"
+#include "MeterBank.h"
+
+namespace adsp {
+/**
+* @brief Highest number of bands per octave
+*/
+constexpr int OCTAVE_BANK_MAX_BANDS_PER_OCTAVE = 24;
+
+/**
+* @brief Highest number of bands, MIN_FILTER_FREQ to MAX_FILTER_FREQ spans ten octaves
+*/
+constexpr int OCTAVE_BANK_MAX_BANDS = 10 * OCTAVE_BANK_MAX_BANDS_PER_OCTAVE + 2;
+
+/**
+* @brief Second-order sections per band (sixth-order Butterworth bandpass)
+*/
+constexpr int OCTAVE_BANK_SECTIONS = 3;
+
+/**
+* @brief Highest number of sample rates, each one half of the one above
+*/
+constexpr int OCTAVE_BANK_MAX_STAGES = 10;
+
+/**
+* @brief Number of bands OctaveFilterBank processes side by side
+*/
+constexpr int OCTAVE_BANK_LANES = 8;
+
+/**
+* @brief Number of input samples the stages are run for at once
+*/
+constexpr int OCTAVE_BANK_BLOCK_SIZE = 512;
+
+/**
+* @brief Octave filter bank parameter structure
+*
+*/
+struct OctaveFilterBankParams {
+    OctaveFilterBankParams() {}
+
+    OctaveFilterBankParams &operator=(
+        const OctaveFilterBankParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            bandsPerOctave = parameters.bandsPerOctave;
+            integrationTime = parameters.integrationTime;
+            return *this;
+        }
+    }
+
+    // Bands per octave, 1 for octave and 3 for third-octave bands
+    // [1, OCTAVE_BANK_MAX_BANDS_PER_OCTAVE]
+    int bandsPerOctave = 3;
+
+    // Time constant of the level averaging, 125 ms is "fast", 1000 ms "slow"
+    double integrationTime = 125.0;  // ms
+};
+
+//==============================================================================
+
+/**
+* @brief Constant-Q band splitting for spectrum and RTA displays
+*
+* Band centers follow the base-two series 1000 Hz * 2^(k / bandsPerOctave) of
+* IEC 61260 from MIN_FILTER_FREQ to MAX_FILTER_FREQ, e.g. the 31 third-octave bands
+* from 20 Hz to 20 kHz. Every band is a sixth-order Butterworth bandpass between
+* the band edges, with unity gain at the center. Bands centered above 0.45 times the
+* sample rate are left out, upper edges are limited to that frequency.
+*
+* The input runs through a chain of halfband decimators (HalfbandIir). Each band is
+* filtered at the lowest rate that keeps its upper edge below a fifth of that rate,
+* so every halving of the rate serves about one octave of bands: the octave around
+* 20 Hz runs at 1/256 of a 48 kHz sample rate. All bands of one rate are processed
+* side by side in groups of OCTAVE_BANK_LANES, the compiler computes several bands
+* per instruction. The 31 sixth-order third-octave bands of a 48 kHz channel cost
+* about a quarter of 31 second-order Bandpass filters at the full rate (GCC -O2,
+* SSE2), see the benchmark suite.
+*
+* Use one instance per channel. Band energies of the last block and time averaged
+* levels are available after each processBlock() call. The bands at the lower rates
+* lag by a few samples of their rate and see no samples at all in very short
+* blocks.
+*/
+class OctaveFilterBank {
+   public:
+    OctaveFilterBank();
+    ~OctaveFilterBank();
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate, design the bands and clear all state
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param sampleRate New sample rate
+    */
+    void reset(double sampleRate);
+
+    /**
+    * @brief Analyse a block
+    *
+    * @param in Input block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get number of bands
+    *
+    * @return Number of bands
+    */
+    int getNumBands();
+
+    /**
+    * @brief Get the exact center frequency of a band
+    *
+    * @param band Band index, ascending with frequency
+    * @return Center frequency [Hz]
+    */
+    double getBandFrequency(int band);
+
+    /**
+    * @brief Get the decimation factor a band is filtered at
+    *
+    * @param band Band index
+    * @return Sample rate divided by the band's processing rate
+    */
+    int getBandDecimation(int band);
+
+    /**
+    * @brief Get the energy of a band in the last processed block
+    *
+    * Sum of the squared band output, scaled to the full sample rate, so the band
+    * energies of a signal add up to about its own energy.
+    *
+    * @param band Band index
+    * @return Energy
+    */
+    double getBandEnergy(int band);
+
+    /**
+    * @brief Get the time averaged level of a band
+    *
+    * @param band Band index
+    * @return Level [dBFS], a full scale sine at the band center reads -3 dB
+    */
+    double getBandLeveldB(int band);
+
+    /**
+    * @brief Get the time averaged levels of all bands
+    *
+    * @param levelsdB Array of numBands levels [dBFS]
+    */
+    void getBandLevelsdB(double *levelsdB);
+
+    //==============================================================================
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Filter bank parameters
+    */
+    OctaveFilterBankParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * Real-time safe. Changing the number of bands per octave redesigns the bands and
+    * clears their state.
+    *
+    * @param parameters New filter bank parameters
+    */
+    void setParameters(const OctaveFilterBankParams &parameters);
+
+   protected:
+    /**
+    * @brief Place and design the bands, clear filter state and levels
+    */
+    void designBands();
+
+    /**
+    * @brief Filter one group of bands of the same rate
+    *
+    * @param first First band of the group
+    * @param count Number of bands in the group
+    * @param x Input at the group's rate
+    * @param numSamples Number of samples
+    * @param weight Decimation factor the energies are scaled with
+    */
+    void processGroup(int first, int count, const double *x, int numSamples,
+                      double weight);
+
+    /**
+    * @brief Filter bank parameters
+    */
+    OctaveFilterBankParams params;
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Number of bands and of decimation stages in use
+    */
+    int numBands{0};
+    int numStages{0};
+
+    /**
+    * @brief First band and number of bands of each stage
+    */
+    int stageFirstBand[OCTAVE_BANK_MAX_STAGES] = {};
+    int stageNumBands[OCTAVE_BANK_MAX_STAGES] = {};
+
+    /**
+    * @brief Halfband decimators, index s feeds stage s + 1
+    */
+    HalfbandIir decimators[OCTAVE_BANK_MAX_STAGES];
+
+    /**
+    * @brief Whether a stage holds an odd input sample for the next block, and the sample
+    */
+    bool hasPending[OCTAVE_BANK_MAX_STAGES] = {};
+    double pending[OCTAVE_BANK_MAX_STAGES] = {};
+
+    /**
+    * @brief Decimator input and the signal of each stage
+    */
+    std::vector<double> decimationBuffer;
+    std::vector<double> stageBuffers;
+
+    /**
+    * @brief Band center frequencies and stages
+    */
+    std::vector<double> frequencies;
+    std::vector<int> bandStages;
+
+    /**
+    * @brief Section coefficients and state, index band * OCTAVE_BANK_SECTIONS + section.
+    * Sections are (gain - gain z^-2) / (1 + b1 z^-1 + b2 z^-2).
+    */
+    std::vector<double> gains;
+    std::vector<double> b1s;
+    std::vector<double> b2s;
+    std::vector<double> z1s;
+    std::vector<double> z2s;
+
+    /**
+    * @brief Band energies of the last block and averaged mean squares
+    */
+    std::vector<double> energies;
+    std::vector<double> levels;
+};
+}  // namespace adsp
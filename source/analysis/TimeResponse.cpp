@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    TimeResponse.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "TimeResponse.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE TimeResponse::TimeResponse() {}
+ADSP_INLINE TimeResponse::~TimeResponse() {}
+
+ADSP_INLINE void TimeResponse::setLength(int numSamples, int _numSlots) {
+    length = std::max(numSamples, 0);
+    numSlots = std::max(_numSlots, 1);
+    responses.assign(static_cast<size_t>(length) * numSlots, 0.0);
+    keys.assign(numSlots, BiquadCoefficients{});
+    types.assign(numSlots, timeResponseType::impulse);
+    lastUsed.assign(numSlots, 0);
+
+    clear();
+}
+
+ADSP_INLINE void TimeResponse::clear() {
+    std::fill(lastUsed.begin(), lastUsed.end(), 0);
+    numRequests = 0;
+    numRendered = 0;
+}
+
+//==============================================================================
+
+ADSP_INLINE const double *TimeResponse::getResponse(
+    const double *coefficients, timeResponseType type) {
+    if (numSlots == 0) {
+        return nullptr;
+    }
+
+    ++numRequests;
+
+    // Same coefficient set and type as a cached response, otherwise the least
+    // recently used slot (empty slots first)
+    int leastRecent = 0;
+    for (int slot = 0; slot < numSlots; ++slot) {
+        if (lastUsed[slot] != 0 && types[slot] == type &&
+            std::equal(keys[slot].begin(), keys[slot].end(), coefficients)) {
+            lastUsed[slot] = numRequests;
+            return responses.data() + static_cast<size_t>(slot) * length;
+        }
+        if (lastUsed[slot] < lastUsed[leastRecent]) {
+            leastRecent = slot;
+        }
+    }
+
+    const int slot = leastRecent;
+    std::copy(coefficients, coefficients + numCoefficients, keys[slot].begin());
+    types[slot] = type;
+    lastUsed[slot] = numRequests;
+
+    double *out = responses.data() + static_cast<size_t>(slot) * length;
+    render(coefficients, type, out);
+    ++numRendered;
+
+    return out;
+}
+
+//==============================================================================
+
+ADSP_INLINE int TimeResponse::getLength() { return length; }
+
+ADSP_INLINE int TimeResponse::getNumSlots() { return numSlots; }
+
+ADSP_INLINE int TimeResponse::getNumRendered() { return numRendered; }
+
+//==============================================================================
+
+ADSP_INLINE void TimeResponse::render(const double *coefficients,
+                                      timeResponseType type, double *out) {
+    const double c0 = coefficients[a0];
+    const double c1 = coefficients[a1];
+    const double c2 = coefficients[a2];
+    const double d1 = coefficients[b1];
+    const double d2 = coefficients[b2];
+
+    // Unit impulse or unit step
+    const double hold = type == timeResponseType::step ? 1.0 : 0.0;
+
+    double z1 = 0.0;
+    double z2 = 0.0;
+    double x = 1.0;
+    for (int n = 0; n < length; ++n) {
+        // Transposed canonical form, as in Biquad
+        double y = c0 * x + z1;
+
+        fixUnderflow(y);
+
+        z1 = c1 * x - d1 * y + z2;
+        z2 = c2 * x - d2 * y;
+
+        out[n] = y;
+        x = hold;
+    }
+}
+}  // namespace adsp
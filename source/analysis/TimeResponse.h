@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+    TimeResponse.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file TimeResponse.h
+*
+* @brief Impulse and step responses of biquad coefficient sets
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../filter/Biquad.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Default number of responses TimeResponse keeps
+*/
+constexpr int TIME_RESPONSE_CACHE_SIZE = 16;
+
+/**
+* @brief Kind of response to render
+*/
+enum class timeResponseType { impulse, step };
+
+//==============================================================================
+
+/**
+* @brief Renders impulse and step responses of biquad coefficient sets, with a cache
+*
+* Responses are rendered in a single loop over the transposed canonical form with
+* coefficients and state in locals and the input generated in place, the output is
+* identical to a Biquad with biquadAlgorithm::transposedCanonical fed sample by
+* sample.
+*
+* Responses are kept together with the coefficient set they were rendered from, the
+* least recently used one is replaced when all slots are taken. Asking again for the
+* response of an unchanged coefficient set only compares five coefficients per cached
+* response, so plots can be redrawn without rendering. Use at least one slot per
+* response drawn, otherwise redrawing all of them in a loop evicts each before it is
+* asked for again:
+*
+*     response.setLength(512, numBands);
+*     for (auto &band : bands) plot(response.getImpulseResponse(band));
+*
+* Does not allocate after setLength().
+*/
+class TimeResponse {
+   public:
+    TimeResponse();
+    ~TimeResponse();
+
+    //==============================================================================
+
+    /**
+    * @brief Set the number of samples per response and the cache size, clear the
+    * cache
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param numSamples Number of samples per response
+    * @param numSlots Number of responses kept, at least 1
+    */
+    void setLength(int numSamples, int numSlots = TIME_RESPONSE_CACHE_SIZE);
+
+    /**
+    * @brief Clear the cache
+    *
+    */
+    void clear();
+
+    //==============================================================================
+
+    /**
+    * @brief Get the response of a second-order section
+    *
+    * The returned array stays valid until setLength() or clear() is called, or until
+    * the response is the least recently used one while another one is rendered.
+    * Call setLength() first.
+    *
+    * @param coefficients Array of numCoefficients filter coefficients (see filterCoefficients)
+    * @param type Impulse or step response
+    * @return Array of getLength() samples
+    */
+    const double *getResponse(const double *coefficients,
+                              timeResponseType type);
+
+    /**
+    * @brief Get the impulse response of any filter exposing getCoefficients()
+    *
+    * @tparam Filter Biquad or one of the filter wrappers
+    * @param filter Filter to evaluate
+    * @return Array of getLength() samples
+    */
+    template <typename Filter>
+    const double *getImpulseResponse(Filter &filter) {
+        return getResponse(filter.getCoefficients(), timeResponseType::impulse);
+    }
+
+    /**
+    * @brief Get the step response of any filter exposing getCoefficients()
+    *
+    * @tparam Filter Biquad or one of the filter wrappers
+    * @param filter Filter to evaluate
+    * @return Array of getLength() samples
+    */
+    template <typename Filter>
+    const double *getStepResponse(Filter &filter) {
+        return getResponse(filter.getCoefficients(), timeResponseType::step);
+    }
+
+    //==============================================================================
+
+    /**
+    * @brief Get number of samples per response
+    *
+    * @return Number of samples
+    */
+    int getLength();
+
+    /**
+    * @brief Get number of responses the cache keeps
+    *
+    * @return Number of slots
+    */
+    int getNumSlots();
+
+    /**
+    * @brief Get number of responses rendered since setLength() or clear()
+    *
+    * Requests answered from the cache are not counted.
+    *
+    * @return Number of rendered responses
+    */
+    int getNumRendered();
+
+   protected:
+    /**
+    * @brief Render a response into a buffer
+    *
+    * @param coefficients Array of numCoefficients filter coefficients
+    * @param type Impulse or step response
+    * @param out Output buffer of length samples
+    */
+    void render(const double *coefficients, timeResponseType type, double *out);
+
+    /**
+    * @brief Number of samples per response
+    */
+    int length{0};
+
+    /**
+    * @brief Number of cached responses
+    */
+    int numSlots{0};
+
+    /**
+    * @brief Cached responses, slot s at s * length
+    */
+    std::vector<double> responses;
+
+    /**
+    * @brief Coefficient set and type of each slot, and the request that last used
+    * it (0 for empty slots)
+    */
+    std::vector<BiquadCoefficients> keys;
+    std::vector<timeResponseType> types;
+    std::vector<uint64_t> lastUsed;
+
+    /**
+    * @brief Number of requests since setLength() or clear()
+    */
+    uint64_t numRequests{0};
+
+    /**
+    * @brief Number of rendered responses
+    */
+    int numRendered{0};
+};
+}  // namespace adsp
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+    Profiler.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "Profiler.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE ProfileCounters::ProfileCounters() {}
+ADSP_INLINE ProfileCounters::~ProfileCounters() {}
+
+ADSP_INLINE ProfileCounters::ProfileCounters(const ProfileCounters &) {}
+
+ADSP_INLINE ProfileCounters &ProfileCounters::operator=(
+    const ProfileCounters &) {
+    return *this;
+}
+
+ADSP_INLINE ProfileSnapshot ProfileCounters::getSnapshot() const {
+    ProfileSnapshot snapshot;
+    snapshot.samples = samples.load(std::memory_order_relaxed);
+    snapshot.coefficientUpdates =
+        coefficientUpdates.load(std::memory_order_relaxed);
+    snapshot.underflowFixes = underflowFixes.load(std::memory_order_relaxed);
+    snapshot.cycles = cycles.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+ADSP_INLINE void ProfileCounters::reset() {
+    samples.store(0, std::memory_order_relaxed);
+    coefficientUpdates.store(0, std::memory_order_relaxed);
+    underflowFixes.store(0, std::memory_order_relaxed);
+    cycles.store(0, std::memory_order_relaxed);
+}
+}  // namespace adsp
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+    Profiler.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Profiler.h
+*
+* @brief Opt-in per-instance profiling counters for the processing paths
+*
+* Define ADSP_ENABLE_PROFILING for the whole build to enable.
+* Without it, the ADSP_PROFILE_* macros compile to nothing, the counters are not
+* stored in the filter objects and getProfile() returns an empty snapshot.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace adsp {
+/**
+* @brief Read the CPU time stamp counter
+*
+* Uses the TSC on x86 and the virtual counter on AArch64, elsewhere falls back to
+* a steady clock in nanoseconds. Not serializing, meant for totals over many calls.
+*
+* @return Counter value [cycles]
+*/
+inline uint64_t readCycleCounter() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t counter;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(counter));
+    return counter;
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+/**
+* @brief Snapshot of the profiling counters of one instance
+*
+*/
+struct ProfileSnapshot {
+    // Processed samples
+    uint64_t samples = 0;
+
+    // Coefficient updates (one per coefficient recalculation of the filter wrappers)
+    uint64_t coefficientUpdates = 0;
+
+    // Results flushed to zero by fixUnderflow()
+    uint64_t underflowFixes = 0;
+
+    // Cycles spent in the process calls, see readCycleCounter()
+    uint64_t cycles = 0;
+
+    /**
+    * @brief Average cost of one sample
+    *
+    * @return Cycles per sample, 0 if nothing was processed
+    */
+    double getCyclesPerSample() const {
+        return samples > 0 ? static_cast<double>(cycles) / samples : 0.0;
+    }
+};
+
+/**
+* @brief Profiling counters of one instance
+*
+* Written by the processing thread, read and reset lock-free from any other thread.
+* All accesses are relaxed atomics, the counters are statistics and do not order
+* other memory accesses. Each counter has a single writer, so increments are a
+* relaxed load and store instead of a locked read-modify-write, which would skew
+* the measured cycles. A reset() while processing may therefore be overwritten by
+* an increment in flight, reset while the instance is idle for exact totals.
+*/
+class ProfileCounters {
+   public:
+    ProfileCounters();
+    ~ProfileCounters();
+
+    // Counters are per instance, copies start from zero
+    ProfileCounters(const ProfileCounters &);
+    ProfileCounters &operator=(const ProfileCounters &);
+
+    //==============================================================================
+
+    inline void addSamples(uint64_t numSamples) { add(samples, numSamples); }
+
+    inline void addCoefficientUpdate() { add(coefficientUpdates, 1); }
+
+    inline void addUnderflowFix() { add(underflowFixes, 1); }
+
+    inline void addUnderflowFixes(uint64_t numFixes) {
+        add(underflowFixes, numFixes);
+    }
+
+    inline void addCycles(uint64_t numCycles) { add(cycles, numCycles); }
+
+    //==============================================================================
+
+    /**
+    * @brief Read all counters
+    *
+    * The counters are read one after another, a snapshot taken while processing
+    * may mix the state of two consecutive calls.
+    *
+    * @return Counter snapshot
+    */
+    ProfileSnapshot getSnapshot() const;
+
+    /**
+    * @brief Set all counters to zero
+    *
+    */
+    void reset();
+
+   protected:
+    /**
+    * @brief Increment a counter from its only writer, without a locked instruction
+    *
+    * @param counter Counter
+    * @param value Increment
+    */
+    static inline void add(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> coefficientUpdates{0};
+    std::atomic<uint64_t> underflowFixes{0};
+    std::atomic<uint64_t> cycles{0};
+};
+
+/**
+* @brief Adds samples and elapsed cycles of the enclosing scope to a set of counters
+*
+* Use the ADSP_PROFILE_SCOPE() macro instead of instantiating this directly,
+* so the measurement disappears when profiling is disabled.
+*/
+class ProfileScope {
+   public:
+    inline ProfileScope(ProfileCounters &_counters, uint64_t _numSamples)
+        : counters(_counters),
+          numSamples(_numSamples),
+          start(readCycleCounter()) {}
+
+    inline ~ProfileScope() {
+        counters.addCycles(readCycleCounter() - start);
+        counters.addSamples(numSamples);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+   private:
+    ProfileCounters &counters;
+    const uint64_t numSamples;
+    const uint64_t start;
+};
+}  // namespace adsp
+
+//==============================================================================
+
+#ifdef ADSP_ENABLE_PROFILING
+/**
+* @brief Declare the profiling counters as class member
+*/
+#define ADSP_PROFILE_COUNTERS(name) adsp::ProfileCounters name
+
+/**
+* @brief Count samples and cycles for the rest of the enclosing scope
+*/
+#define ADSP_PROFILE_SCOPE(counters, numSamples) \
+    adsp::ProfileScope adspProfileScope { counters, numSamples }
+
+/**
+* @brief Count a coefficient update
+*/
+#define ADSP_PROFILE_COEFFICIENT_UPDATE(counters) \
+    (counters).addCoefficientUpdate()
+
+/**
+* @brief Count a result flushed to zero
+*/
+#define ADSP_PROFILE_UNDERFLOW_FIX(counters) (counters).addUnderflowFix()
+
+/**
+* @brief Count a number of results flushed to zero, e.g. returned by a block kernel
+*/
+#define ADSP_PROFILE_UNDERFLOW_FIXES(counters, numFixes) \
+    (counters).addUnderflowFixes(static_cast<uint64_t>(numFixes))
+
+/**
+* @brief Snapshot of the counters, or an empty one if profiling is disabled
+*/
+#define ADSP_PROFILE_SNAPSHOT(counters) (counters).getSnapshot()
+
+/**
+* @brief Reset the counters
+*/
+#define ADSP_PROFILE_RESET(counters) (counters).reset()
+#else
+#define ADSP_PROFILE_COUNTERS(name) static_assert(true, "")
+#define ADSP_PROFILE_SCOPE(counters, numSamples)
+#define ADSP_PROFILE_COEFFICIENT_UPDATE(counters)
+#define ADSP_PROFILE_UNDERFLOW_FIX(counters)
+#define ADSP_PROFILE_UNDERFLOW_FIXES(counters, numFixes) \
+    static_cast<void>(numFixes)
+#define ADSP_PROFILE_SNAPSHOT(counters) adsp::ProfileSnapshot()
+#define ADSP_PROFILE_RESET(counters)
+#endif
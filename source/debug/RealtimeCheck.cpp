@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+    RealtimeCheck.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+#include "../utility/inline.h"
+
+#ifdef ADSP_REALTIME_CHECKS
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+// AddressSanitizer owns the C allocator, its pointers must not reach __libc_free.
+// Allocations are then counted in operator new/delete only.
+#if defined(__SANITIZE_ADDRESS__)
+#define ADSP_REALTIME_ADDRESS_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ADSP_REALTIME_ADDRESS_SANITIZER
+#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(ADSP_REALTIME_ADDRESS_SANITIZER)
+#define ADSP_REALTIME_INTERPOSE_MALLOC
+#endif
+#endif
+
+// Initial-exec TLS avoids lazy TLS allocation (which may call malloc) on first access
+#if defined(__GNUC__) && !defined(_WIN32)
+#define ADSP_REALTIME_TLS __attribute__((tls_model("initial-exec"))) thread_local
+#else
+#define ADSP_REALTIME_TLS thread_local
+#endif
+
+namespace adsp {
+// Not in an anonymous namespace, header-only builds share one state across all
+// translation units
+namespace detail {
+// Nesting depth of realtime sections on the current thread
+ADSP_INLINE ADSP_REALTIME_TLS int realtimeDepth = 0;
+
+// Set while the handler runs, so violations caused by the handler are not reported again
+ADSP_INLINE ADSP_REALTIME_TLS bool realtimeReporting = false;
+
+ADSP_INLINE std::atomic<uint64_t> realtimeAllocations{0};
+ADSP_INLINE std::atomic<uint64_t> realtimeDeallocations{0};
+ADSP_INLINE std::atomic<uint64_t> realtimeLocks{0};
+
+ADSP_INLINE std::atomic<RealtimeViolationHandler> realtimeHandler{nullptr};
+}  // namespace detail
+
+ADSP_INLINE RealtimeSection::RealtimeSection() { ++detail::realtimeDepth; }
+ADSP_INLINE RealtimeSection::~RealtimeSection() { --detail::realtimeDepth; }
+
+ADSP_INLINE bool isInRealtimeSection() { return detail::realtimeDepth > 0; }
+
+ADSP_INLINE void reportRealtimeViolation(realtimeViolation violation) {
+    if (detail::realtimeDepth <= 0 || detail::realtimeReporting) {
+        return;
+    }
+
+    switch (violation) {
+        case realtimeViolation::allocation: {
+            detail::realtimeAllocations.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        case realtimeViolation::deallocation: {
+            detail::realtimeDeallocations.fetch_add(1,
+                                                    std::memory_order_relaxed);
+            break;
+        }
+        case realtimeViolation::lock: {
+            detail::realtimeLocks.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    const RealtimeViolationHandler handler =
+        detail::realtimeHandler.load(std::memory_order_acquire);
+    if (handler != nullptr) {
+        detail::realtimeReporting = true;
+        handler(violation);
+        detail::realtimeReporting = false;
+    }
+}
+
+ADSP_INLINE RealtimeViolations getRealtimeViolations() {
+    RealtimeViolations violations;
+    violations.allocations =
+        detail::realtimeAllocations.load(std::memory_order_relaxed);
+    violations.deallocations =
+        detail::realtimeDeallocations.load(std::memory_order_relaxed);
+    violations.locks = detail::realtimeLocks.load(std::memory_order_relaxed);
+    return violations;
+}
+
+ADSP_INLINE void resetRealtimeViolations() {
+    detail::realtimeAllocations.store(0, std::memory_order_relaxed);
+    detail::realtimeDeallocations.store(0, std::memory_order_relaxed);
+    detail::realtimeLocks.store(0, std::memory_order_relaxed);
+}
+
+ADSP_INLINE void setRealtimeViolationHandler(RealtimeViolationHandler handler) {
+    detail::realtimeHandler.store(handler, std::memory_order_release);
+}
+}  // namespace adsp
+
+//==============================================================================
+
+#ifdef ADSP_REALTIME_CHECKS
+
+#ifdef ADSP_REALTIME_INTERPOSE_MALLOC
+// Interpose the C allocator. glibc exports its implementation under __libc_* names,
+// so the wrappers need no symbol lookup and can run before any static initialization.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void __libc_free(void *pointer);
+
+void *malloc(size_t size) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::allocation);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::allocation);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::allocation);
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) {
+    if (pointer != nullptr) {
+        adsp::reportRealtimeViolation(adsp::realtimeViolation::deallocation);
+    }
+    __libc_free(pointer);
+}
+}
+#endif
+
+#if defined(__GLIBC__)
+namespace {
+typedef int (*RealtimeMutexFunction)(pthread_mutex_t *);
+
+// Next definitions of the interposed functions (the ones in libc).
+// Resolved on first use without function-local statics, their guards may lock.
+std::atomic<RealtimeMutexFunction> realtimeNextMutexLock{nullptr};
+std::atomic<RealtimeMutexFunction> realtimeNextMutexTrylock{nullptr};
+
+RealtimeMutexFunction findRealtimeMutexFunction(
+    std::atomic<RealtimeMutexFunction> &next, const char *name) {
+    RealtimeMutexFunction function = next.load(std::memory_order_acquire);
+    if (function == nullptr) {
+        function =
+            reinterpret_cast<RealtimeMutexFunction>(dlsym(RTLD_NEXT, name));
+        next.store(function, std::memory_order_release);
+    }
+    return function;
+}
+}  // namespace
+
+// Interpose mutex locking, this also catches std::mutex and the locks taken
+// inside other libraries
+extern "C" {
+int pthread_mutex_lock(pthread_mutex_t *mutex) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::lock);
+    return findRealtimeMutexFunction(realtimeNextMutexLock,
+                                     "pthread_mutex_lock")(mutex);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t *mutex) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::lock);
+    return findRealtimeMutexFunction(realtimeNextMutexTrylock,
+                                     "pthread_mutex_trylock")(mutex);
+}
+}
+#endif
+
+#ifdef ADSP_REALTIME_INTERPOSE_MALLOC
+namespace {
+void *allocateRealtimeChecked(size_t size) {
+    // The C allocator wrapper reports the allocation
+    void *pointer = malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void freeRealtimeChecked(void *pointer) { free(pointer); }
+}  // namespace
+#else
+namespace {
+void *allocateRealtimeChecked(size_t size) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::allocation);
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void freeRealtimeChecked(void *pointer) {
+    if (pointer != nullptr) {
+        adsp::reportRealtimeViolation(adsp::realtimeViolation::deallocation);
+    }
+    std::free(pointer);
+}
+}  // namespace
+#endif
+
+namespace {
+void *allocateRealtimeCheckedAligned(size_t size, std::align_val_t alignment) {
+    adsp::reportRealtimeViolation(adsp::realtimeViolation::allocation);
+
+    const size_t align = static_cast<size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    const size_t rounded = (size + align - 1) / align * align;
+#ifdef _WIN32
+    void *pointer = _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+    void *pointer = aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void freeRealtimeCheckedAligned(void *pointer) {
+#ifdef _WIN32
+    if (pointer != nullptr) {
+        adsp::reportRealtimeViolation(adsp::realtimeViolation::deallocation);
+    }
+    _aligned_free(pointer);
+#else
+    freeRealtimeChecked(pointer);
+#endif
+}
+}  // namespace
+
+// Replace the global operator new/delete family
+void *operator new(size_t size) { return allocateRealtimeChecked(size); }
+void *operator new[](size_t size) { return allocateRealtimeChecked(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocateRealtimeChecked(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocateRealtimeChecked(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    return allocateRealtimeCheckedAligned(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return allocateRealtimeCheckedAligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { freeRealtimeChecked(pointer); }
+void operator delete[](void *pointer) noexcept { freeRealtimeChecked(pointer); }
+
+void operator delete(void *pointer, size_t) noexcept {
+    freeRealtimeChecked(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    freeRealtimeChecked(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    freeRealtimeChecked(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    freeRealtimeChecked(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+    freeRealtimeCheckedAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+    freeRealtimeCheckedAligned(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+    freeRealtimeCheckedAligned(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+    freeRealtimeCheckedAligned(pointer);
+}
+#endif
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+    RealtimeCheck.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file RealtimeCheck.h
+*
+* @brief Opt-in detection of allocations and locks inside realtime processing paths
+*
+* Define ADSP_REALTIME_CHECKS for the whole build (library and host code) to enable.
+* Without it, ADSP_REALTIME_SECTION() compiles to nothing and no interposers are installed.
+*
+* When enabled, the library replaces the global operator new/delete family and, on glibc
+* targets, interposes malloc/calloc/realloc/free and pthread_mutex_lock/trylock.
+* Under AddressSanitizer the C allocator is left to the sanitizer, only operator
+* new/delete and the mutex functions are checked.
+* Every call made while the calling thread is inside a realtime section is counted
+* and passed to an optional violation handler.
+* This is a debugging aid, it is not meant to be enabled in release builds.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace adsp {
+/**
+* @brief Kinds of operations that are not allowed in realtime sections
+*/
+enum class realtimeViolation { allocation, deallocation, lock };
+
+/**
+* @brief Snapshot of the violation counters
+*
+*/
+struct RealtimeViolations {
+    // Calls to malloc/calloc/realloc/operator new
+    uint64_t allocations = 0;
+
+    // Calls to free/operator delete
+    uint64_t deallocations = 0;
+
+    // Calls to pthread_mutex_lock/trylock
+    uint64_t locks = 0;
+
+    /**
+    * @brief Total number of violations
+    *
+    * @return Sum of all counters
+    */
+    uint64_t total() const { return allocations + deallocations + locks; }
+};
+
+/**
+* @brief Function called on every violation, on the violating thread
+*
+* Must not allocate or lock itself.
+*/
+typedef void (*RealtimeViolationHandler)(realtimeViolation violation);
+
+//==============================================================================
+
+/**
+* @brief Marks the enclosing scope as realtime section on the current thread
+*
+* Sections nest, the thread leaves realtime state when the outermost one ends.
+* Use the ADSP_REALTIME_SECTION() macro instead of instantiating this directly,
+* so the marker disappears when checks are disabled.
+*/
+class RealtimeSection {
+   public:
+    RealtimeSection();
+    ~RealtimeSection();
+
+    RealtimeSection(const RealtimeSection &) = delete;
+    RealtimeSection &operator=(const RealtimeSection &) = delete;
+};
+
+/**
+* @brief Check whether the current thread is inside a realtime section
+*
+* @return true if inside at least one section
+*/
+bool isInRealtimeSection();
+
+/**
+* @brief Record a violation if the current thread is inside a realtime section
+*
+* Called by the interposers, can also be called from host code for custom checks
+* (e.g. around system calls).
+*
+* @param violation Kind of operation
+*/
+void reportRealtimeViolation(realtimeViolation violation);
+
+/**
+* @brief Get the violation counters accumulated over all threads
+*
+* @return Counter snapshot
+*/
+RealtimeViolations getRealtimeViolations();
+
+/**
+* @brief Set all violation counters to zero
+*
+*/
+void resetRealtimeViolations();
+
+/**
+* @brief Install a violation handler (e.g. to log, break into the debugger or abort)
+*
+* @param handler New handler, nullptr to only count
+*/
+void setRealtimeViolationHandler(RealtimeViolationHandler handler);
+}  // namespace adsp
+
+//==============================================================================
+
+// The interposers must be defined exactly once
+#if defined(ADSP_REALTIME_CHECKS) && defined(ADSP_HEADER_ONLY)
+#error "ADSP_REALTIME_CHECKS needs the compiled library, not ADSP_HEADER_ONLY"
+#endif
+
+#ifdef ADSP_REALTIME_CHECKS
+/**
+* @brief Mark the rest of the enclosing scope as realtime section
+*/
+#define ADSP_REALTIME_SECTION() \
+    adsp::RealtimeSection adspRealtimeSection {}
+#else
+#define ADSP_REALTIME_SECTION()
+#endif
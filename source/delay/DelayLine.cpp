@@ -0,0 +1,348 @@
+/*
+  ==============================================================================
+    DelayLine.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "DelayLine.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+/**
+* @brief Smallest power of two >= minLength
+*/
+int delayLineLength(int minLength) {
+    int length = 1;
+    while (length < minLength) {
+        length *= 2;
+    }
+    return length;
+}
+
+/**
+* @brief Smallest delay with a complete interpolation stencil
+*/
+double minimumDelay(delayInterpolation interpolation) {
+    switch (interpolation) {
+        case delayInterpolation::lagrange:
+        case delayInterpolation::cubic: {
+            return 1.0;
+        }
+        case delayInterpolation::thiran: {
+            return 0.5;
+        }
+        default: {
+            return 0.0;
+        }
+    }
+}
+
+/**
+* @brief Weights of the four-point interpolators
+*
+* Ordered from the oldest to the newest sample of the stencil, the fractional delay
+* frac is measured from the second newest sample towards the older ones.
+*/
+void fourPointWeights(delayInterpolation interpolation, double frac,
+                      double *weights) {
+    if (interpolation == delayInterpolation::lagrange) {
+        // Lagrange basis polynomials on the nodes -1, 0, 1, 2
+        const double fp1 = frac + 1.0;
+        const double fm1 = frac - 1.0;
+        const double fm2 = frac - 2.0;
+        weights[0] = fp1 * frac * fm1 / 6.0;
+        weights[1] = -fp1 * frac * fm2 * 0.5;
+        weights[2] = fp1 * fm1 * fm2 * 0.5;
+        weights[3] = -frac * fm1 * fm2 / 6.0;
+    } else {
+        // Catmull-Rom spline
+        const double f2 = frac * frac;
+        const double f3 = f2 * frac;
+        weights[0] = 0.5 * (f3 - f2);
+        weights[1] = 0.5 * frac + 2.0 * f2 - 1.5 * f3;
+        weights[2] = 1.0 - 2.5 * f2 + 1.5 * f3;
+        weights[3] = -0.5 * frac + f2 - 0.5 * f3;
+    }
+}
+}  // namespace
+
+ADSP_INLINE DelayLine::DelayLine() {}
+ADSP_INLINE DelayLine::~DelayLine() {}
+
+//==============================================================================
+
+ADSP_INLINE void DelayLine::prepare(int _maxDelay, int _maxBlockSize) {
+    maxDelay = std::max(_maxDelay, 0);
+    maxBlockSize = std::max(_maxBlockSize, 1);
+
+    // Room for the delay, the block and the interpolation stencil
+    length = delayLineLength(maxDelay + maxBlockSize + 2);
+    mask = length - 1;
+
+    buffer.assign(2 * static_cast<size_t>(length), 0.0);
+
+    reset();
+}
+
+ADSP_INLINE void DelayLine::reset() {
+    std::fill(buffer.begin(), buffer.end(), 0.0);
+    writePosition = 0;
+
+    memset(&thiranState[0], 0, sizeof(double) * MAX_DELAY_TAPS);
+}
+
+//==============================================================================
+
+ADSP_INLINE void DelayLine::write(double x) {
+    ADSP_REALTIME_SECTION();
+
+    if (buffer.empty()) {
+        return;
+    }
+
+    writePosition = (writePosition + 1) & mask;
+    buffer[writePosition] = x;
+    buffer[writePosition + length] = x;
+}
+
+ADSP_INLINE double DelayLine::read(double delay) {
+    double y;
+    readTap(&y, delay, 1, 0);
+    return y;
+}
+
+ADSP_INLINE double DelayLine::process(double x, double delay) {
+    write(x);
+    return read(delay);
+}
+
+//==============================================================================
+
+ADSP_INLINE void DelayLine::writeBlock(const double *in, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    // Refuse blocks that do not fit the ring, and calls before prepare()
+    if (!fitsBlock(numSamples)) {
+        return;
+    }
+
+    const int first = (writePosition + 1) & mask;
+
+    // At most two segments, the second one starts at the beginning of the ring
+    const int numFirst = std::min(numSamples, length - first);
+    const int numSecond = numSamples - numFirst;
+
+    double *data = buffer.data();
+    memcpy(data + first, in, sizeof(double) * numFirst);
+    memcpy(data + first + length, in, sizeof(double) * numFirst);
+    memcpy(data, in + numFirst, sizeof(double) * numSecond);
+    memcpy(data + length, in + numFirst, sizeof(double) * numSecond);
+
+    writePosition = (writePosition + numSamples) & mask;
+}
+
+ADSP_INLINE void DelayLine::readBlock(double *out, int numSamples,
+                                      double delay) {
+    readTap(out, delay, numSamples, 0);
+}
+
+ADSP_INLINE void DelayLine::readBlockModulated(double *out,
+                                               const double *delays,
+                                               int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (!fitsBlock(numSamples)) {
+        clearBlock(out, numSamples);
+        return;
+    }
+
+    const delayInterpolation interpolation = params.interpolation;
+    const double minDelay = minimumDelay(interpolation);
+    const double *data = buffer.data();
+
+    // Position of the first output sample
+    const int first = writePosition - numSamples + 1;
+
+    for (int n = 0; n < numSamples; ++n) {
+        const double delay =
+            clip(delays[n], minDelay, static_cast<double>(maxDelay));
+        int whole = static_cast<int>(delay);
+        double frac = delay - whole;
+
+        switch (interpolation) {
+            case delayInterpolation::none: {
+                out[n] = data[(first + n - whole) & mask];
+                break;
+            }
+            case delayInterpolation::linear: {
+                const double *p = data + ((first + n - whole - 1) & mask);
+                out[n] = frac * p[0] + (1.0 - frac) * p[1];
+                break;
+            }
+            case delayInterpolation::lagrange:
+            case delayInterpolation::cubic: {
+                double weights[4];
+                fourPointWeights(interpolation, frac, weights);
+                const double *p = data + ((first + n - whole - 2) & mask);
+                out[n] = weights[0] * p[0] + weights[1] * p[1] +
+                         weights[2] * p[2] + weights[3] * p[3];
+                break;
+            }
+            case delayInterpolation::thiran: {
+                // Fractional part in [0.5, 1.5[ keeps the allpass pole away from -1
+                if (frac < 0.5) {
+                    whole -= 1;
+                    frac += 1.0;
+                }
+                const double eta = (1.0 - frac) / (1.0 + frac);
+                const double *p = data + ((first + n - whole - 1) & mask);
+                thiranState[0] = eta * (p[1] - thiranState[0]) + p[0];
+                out[n] = thiranState[0];
+                break;
+            }
+        }
+    }
+}
+
+ADSP_INLINE void DelayLine::readTaps(double *const *out, const double *delays,
+                                     int numTaps, int numSamples) {
+    // Every tap needs an interpolator state of its own
+    if (numTaps > MAX_DELAY_TAPS) {
+        for (int tap = 0; tap < numTaps; ++tap) {
+            clearBlock(out[tap], numSamples);
+        }
+        return;
+    }
+
+    for (int tap = 0; tap < numTaps; ++tap) {
+        readTap(out[tap], delays[tap], numSamples, tap);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE int DelayLine::getMaxDelay() { return maxDelay; }
+
+ADSP_INLINE DelayLineParams DelayLine::getParameters() { return params; }
+
+ADSP_INLINE void DelayLine::setParameters(const DelayLineParams &parameters) {
+    // If new parameters differ..
+    if (parameters.interpolation != params.interpolation) {
+        params = parameters;
+
+        memset(&thiranState[0], 0, sizeof(double) * MAX_DELAY_TAPS);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE bool DelayLine::fitsBlock(int numSamples) {
+    return numSamples >= 0 && numSamples <= maxBlockSize && !buffer.empty();
+}
+
+ADSP_INLINE void DelayLine::clearBlock(double *out, int numSamples) {
+    if (numSamples > 0) {
+        memset(out, 0, sizeof(double) * numSamples);
+    }
+}
+
+ADSP_INLINE void DelayLine::readTap(double *out, double delay, int numSamples,
+                                    int tap) {
+    ADSP_REALTIME_SECTION();
+
+    if (!fitsBlock(numSamples)) {
+        clearBlock(out, numSamples);
+        return;
+    }
+
+    const delayInterpolation interpolation = params.interpolation;
+    delay = clip(delay, minimumDelay(interpolation),
+                 static_cast<double>(maxDelay));
+    int whole = static_cast<int>(delay);
+    double frac = delay - whole;
+
+    // Position of the first output sample
+    const int first = writePosition - numSamples + 1;
+
+    // All windows below are contiguous thanks to the mirrored buffer
+    switch (interpolation) {
+        case delayInterpolation::none: {
+            memcpy(out, buffer.data() + ((first - whole) & mask),
+                   sizeof(double) * numSamples);
+            break;
+        }
+        case delayInterpolation::linear: {
+            const double *p = buffer.data() + ((first - whole - 1) & mask);
+            const double w0 = frac;
+            const double w1 = 1.0 - frac;
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = w0 * p[n] + w1 * p[n + 1];
+            }
+            break;
+        }
+        case delayInterpolation::lagrange:
+        case delayInterpolation::cubic: {
+            double weights[4];
+            fourPointWeights(interpolation, frac, weights);
+            const double w0 = weights[0];
+            const double w1 = weights[1];
+            const double w2 = weights[2];
+            const double w3 = weights[3];
+
+            const double *p = buffer.data() + ((first - whole - 2) & mask);
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = w0 * p[n] + w1 * p[n + 1] + w2 * p[n + 2] +
+                         w3 * p[n + 3];
+            }
+            break;
+        }
+        case delayInterpolation::thiran: {
+            // Fractional part in [0.5, 1.5[ keeps the allpass pole away from -1
+            if (frac < 0.5) {
+                whole -= 1;
+                frac += 1.0;
+            }
+            const double eta = (1.0 - frac) / (1.0 + frac);
+
+            // y[n] = eta*x[n-M] + x[n-M-1] - eta*y[n-1], recursive
+            const double *p = buffer.data() + ((first - whole - 1) & mask);
+            double y = thiranState[tap];
+            for (int n = 0; n < numSamples; ++n) {
+                y = eta * (p[n + 1] - y) + p[n];
+                out[n] = y;
+            }
+            thiranState[tap] = y;
+            break;
+        }
+    }
+}
+}  // namespace adsp
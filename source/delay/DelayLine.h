@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+    DelayLine.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file DelayLine.h
+*
+* @brief Ring-buffer delay line with fractional delay interpolation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Interpolation methods for fractional delays
+*
+* | Method   | Points | Minimum delay | Notes                                       |
+* |----------|--------|---------------|---------------------------------------------|
+* | none     | 1      | 0             | Delay rounded down to whole samples         |
+* | linear   | 2      | 0             | Lowpass for fractional delays around 0.5    |
+* | lagrange | 4      | 1             | Third-order Lagrange, flatter passband      |
+* | cubic    | 4      | 1             | Catmull-Rom cubic, smooth under modulation  |
+* | thiran   | 2      | 0.5           | First-order allpass, flat magnitude, state  |
+*
+* Thiran interpolation is recursive: each tap keeps one state register and has to be read
+* exactly once per sample, with a slowly varying delay. It suits fixed and slowly
+* modulated delays in feedback loops (combs, allpass diffusers), not jumps.
+* Smaller delays than the minimum are clamped to it.
+*/
+enum class delayInterpolation { none, linear, lagrange, cubic, thiran };
+
+/**
+* @brief Maximum number of taps read by one call to readTaps()
+*/
+constexpr int MAX_DELAY_TAPS = 16;
+
+/**
+* @brief Delay line parameter structure
+*
+*/
+struct DelayLineParams {
+    DelayLineParams() {}
+
+    DelayLineParams &operator=(const DelayLineParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            interpolation = parameters.interpolation;
+            return *this;
+        }
+    }
+
+    // Interpolation method for fractional delays
+    delayInterpolation interpolation = delayInterpolation::linear;
+};
+
+//==============================================================================
+
+/**
+* @brief Delay line on a power-of-two ring buffer
+*
+* Indices wrap with a bit mask instead of a modulo. Every sample is stored twice, at its
+* ring position and one buffer length above, so any window of up to one buffer length
+* is contiguous in memory. Block writes are two memcpy calls per segment and block
+* reads run branch-free dot products over contiguous memory which the compiler
+* vectorizes, no index wraps inside the loops.
+*
+* Delays are measured from the newest written sample: after write(x[n]), a delay of
+* D returns x[n - D]. For blocks, writeBlock() followed by readBlock() with delay D
+* returns the written block delayed by D samples.
+*
+* Nothing allocates after prepare(). Blocks larger than maxBlockSize, more than
+* MAX_DELAY_TAPS taps and all calls before prepare() are rejected: writes are
+* ignored and reads return silence.
+*/
+class DelayLine {
+   public:
+    DelayLine();
+    ~DelayLine();
+
+    //==============================================================================
+
+    /**
+    * @brief Allocate the ring buffer and clear it
+    *
+    * Not real-time safe.
+    *
+    * @param maxDelay Longest delay that will be read [samples]
+    * @param maxBlockSize Largest block passed to writeBlock() and the block reads
+    */
+    void prepare(int maxDelay, int maxBlockSize = 1);
+
+    /**
+    * @brief Clear the buffer and the interpolator states
+    *
+    */
+    void reset();
+
+    //==============================================================================
+
+    /**
+    * @brief Write a single sample
+    *
+    * @param x Input sample
+    */
+    void write(double x);
+
+    /**
+    * @brief Read a single sample
+    *
+    * Uses the interpolator state of tap 0 for Thiran interpolation.
+    *
+    * @param delay Delay relative to the newest sample, at most maxDelay [samples]
+    * @return Delayed sample
+    */
+    double read(double delay);
+
+    /**
+    * @brief Write a sample and read it back delayed
+    *
+    * @param x Input sample
+    * @param delay Delay [samples]
+    * @return Delayed sample
+    */
+    double process(double x, double delay);
+
+    //==============================================================================
+
+    /**
+    * @brief Write a block
+    *
+    * @param in Input block
+    * @param numSamples Number of samples, at most maxBlockSize
+    */
+    void writeBlock(const double *in, int numSamples);
+
+    /**
+    * @brief Read the last written block with a constant delay
+    *
+    * Uses the interpolator state of tap 0 for Thiran interpolation.
+    *
+    * @param out Output block
+    * @param numSamples Number of samples, at most maxBlockSize
+    * @param delay Delay [samples]
+    */
+    void readBlock(double *out, int numSamples, double delay);
+
+    /**
+    * @brief Read the last written block with one delay per sample (modulated delay)
+    *
+    * @param out Output block
+    * @param delays Delay of each output sample [samples]
+    * @param numSamples Number of samples, at most maxBlockSize
+    */
+    void readBlockModulated(double *out, const double *delays, int numSamples);
+
+    /**
+    * @brief Read the last written block at several constant delays
+    *
+    * The interpolation weights are computed once per tap and block, the loop over the
+    * samples is a short FIR over contiguous memory.
+    *
+    * @param out Array of numTaps output blocks
+    * @param delays Array of numTaps delays [samples]
+    * @param numTaps Number of taps, at most MAX_DELAY_TAPS
+    * @param numSamples Number of samples, at most maxBlockSize
+    */
+    void readTaps(double *const *out, const double *delays, int numTaps,
+                  int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get the longest delay that can be read
+    *
+    * @return Maximum delay [samples]
+    */
+    int getMaxDelay();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Delay line parameters
+    */
+    DelayLineParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * Clears the interpolator states if the interpolation changes. Real-time safe.
+    *
+    * @param parameters New delay line parameters
+    */
+    void setParameters(const DelayLineParams &parameters);
+
+   protected:
+    /**
+    * @brief Check a block size against the ring allocated in prepare()
+    *
+    * @param numSamples Number of samples
+    * @return True if the block can be written and read
+    */
+    bool fitsBlock(int numSamples);
+
+    /**
+    * @brief Output silence for a rejected read
+    *
+    * @param out Output block
+    * @param numSamples Number of samples, nothing is written if not positive
+    */
+    void clearBlock(double *out, int numSamples);
+
+    /**
+    * @brief Read one tap of numSamples samples starting at the oldest sample of the last
+    * numSamples written samples
+    */
+    void readTap(double *out, double delay, int numSamples, int tap);
+
+    /**
+    * @brief Delay line parameters
+    */
+    DelayLineParams params;
+
+    /**
+    * @brief Mirrored ring buffer, 2 * length samples
+    */
+    std::vector<double> buffer;
+
+    /**
+    * @brief Ring buffer length (power of two) and its index mask
+    */
+    int length{0};
+    int mask{0};
+
+    /**
+    * @brief Ring position of the newest sample
+    */
+    int writePosition{0};
+
+    /**
+    * @brief Longest readable delay
+    */
+    int maxDelay{0};
+
+    /**
+    * @brief Largest block passed to the block functions
+    */
+    int maxBlockSize{0};
+
+    /**
+    * @brief Last outputs of the Thiran interpolators, one per tap
+    */
+    double thiranState[MAX_DELAY_TAPS] = {};
+};
+}  // namespace adsp
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+    Dynamics.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Dynamics.cpp
+*
+* @brief Compressor, limiter and expander with look-ahead and channel linking
+*/
+
+#include "Dynamics.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+/**
+* @brief Decibels to log2 of the amplitude, 1 / (20 * log10(2))
+*/
+constexpr double DB_TO_LOG2 = 0.16609640474436811739;
+
+/**
+* @brief Lowest detected level, about -200 dBFS, keeps fastLog2() in range
+*/
+constexpr double DYNAMICS_MIN_LEVEL = 1e-10;
+
+/**
+* @brief Largest gain reduction, -150 dB [log2 of the gain factor]
+*/
+constexpr double DYNAMICS_MIN_GAIN = -150.0 * DB_TO_LOG2;
+}  // namespace
+
+ADSP_INLINE Dynamics::Dynamics() { calculateCoefficients(); }
+ADSP_INLINE Dynamics::~Dynamics() {}
+
+//==============================================================================
+
+ADSP_INLINE void Dynamics::reset(int _numChannels, double _sampleRate) {
+    numChannels = _numChannels;
+    sampleRate = _sampleRate;
+
+    const size_t channels = static_cast<size_t>(numChannels);
+    levels.assign(channels * DYNAMICS_BLOCK_SIZE, 0.0);
+    gainState.assign(channels, 0.0);
+
+    // Whole sample delays, no interpolation
+    DelayLineParams delayParams;
+    delayParams.interpolation = delayInterpolation::none;
+    const int maxLookAhead =
+        static_cast<int>(ceil(DYNAMICS_MAX_LOOKAHEAD * 0.001 * sampleRate));
+
+    delayLines.resize(channels);
+    for (auto &delayLine : delayLines) {
+        delayLine.prepare(maxLookAhead, DYNAMICS_BLOCK_SIZE);
+        delayLine.setParameters(delayParams);
+    }
+
+    calculateCoefficients();
+}
+
+ADSP_INLINE void Dynamics::process(double *const *channels, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    int offset = 0;
+    while (offset < numSamples) {
+        const int numBlock = std::min(DYNAMICS_BLOCK_SIZE, numSamples - offset);
+        processBlock(channels, offset, numBlock);
+        offset += numBlock;
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE double Dynamics::getStaticGaindB(double leveldB) {
+    return (calculateStaticGain(leveldB * DB_TO_LOG2) + makeupLog2) /
+           DB_TO_LOG2;
+}
+
+ADSP_INLINE double Dynamics::getGainReductiondB(int channel) {
+    return gainState[channel] / DB_TO_LOG2;
+}
+
+ADSP_INLINE int Dynamics::getLatency() { return lookAheadSamples; }
+
+ADSP_INLINE int Dynamics::getNumChannels() { return numChannels; }
+
+ADSP_INLINE DynamicsParams Dynamics::getParameters() { return params; }
+
+ADSP_INLINE void Dynamics::setParameters(const DynamicsParams &parameters) {
+    // If new parameters differ..
+    if (parameters.mode != params.mode ||
+        parameters.threshold != params.threshold ||
+        parameters.ratio != params.ratio || parameters.knee != params.knee ||
+        parameters.attack != params.attack ||
+        parameters.release != params.release ||
+        parameters.makeup != params.makeup ||
+        parameters.lookAhead != params.lookAhead ||
+        parameters.link != params.link) {
+        params = parameters;
+
+        calculateCoefficients();
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void Dynamics::processBlock(double *const *channels, int offset,
+                                        int numSamples) {
+    // Detector levels, and the loudest channel for linking
+    double loudest[DYNAMICS_BLOCK_SIZE];
+    std::fill(loudest, loudest + numSamples, -HUGE_VAL);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        const double *x = channels[channel] + offset;
+        double *level = &levels[channel * DYNAMICS_BLOCK_SIZE];
+
+        for (int n = 0; n < numSamples; ++n) {
+            level[n] = fastLog2(
+                static_cast<float>(fmax(fabs(x[n]), DYNAMICS_MIN_LEVEL)));
+            loudest[n] = fmax(loudest[n], level[n]);
+        }
+    }
+
+    const double link = clip(params.link, 0.0, 1.0);
+    const double attack = attackCoefficient;
+    const double release = releaseCoefficient;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        double *x = channels[channel] + offset;
+        const double *level = &levels[channel * DYNAMICS_BLOCK_SIZE];
+
+        // Gain computer and smoother
+        double gain[DYNAMICS_BLOCK_SIZE];
+        double state = gainState[channel];
+        for (int n = 0; n < numSamples; ++n) {
+            const double detected = level[n] + link * (loudest[n] - level[n]);
+            const double target = calculateStaticGain(detected);
+
+            // Attack while the gain reduction grows, release while it shrinks
+            const double coefficient = target < state ? attack : release;
+            state = coefficient * (state - target) + target;
+
+            gain[n] = fastExp2(state + makeupLog2);
+        }
+        fixUnderflow(state);
+        gainState[channel] = state;
+
+        // Signal path, delayed behind the detector
+        DelayLine &delayLine = delayLines[channel];
+        delayLine.writeBlock(x, numSamples);
+        if (lookAheadSamples > 0) {
+            delayLine.readBlock(x, numSamples, lookAheadSamples);
+        }
+
+        for (int n = 0; n < numSamples; ++n) {
+            x[n] *= gain[n];
+        }
+    }
+}
+
+ADSP_INLINE double Dynamics::calculateStaticGain(double level) {
+    const double over = level - thresholdLog2;
+    const double halfKnee = halfKneeLog2;
+    double gain;
+
+    if (params.mode == dynamicsMode::expander) {
+        if (over >= halfKnee) {
+            gain = 0.0;
+        } else if (over > -halfKnee) {
+            // Quadratic knee, continuous slope at both ends
+            const double d = over - halfKnee;
+            gain = -slope * d * d / (4.0 * halfKnee);
+        } else {
+            gain = slope * over;
+        }
+    } else {
+        if (over <= -halfKnee) {
+            gain = 0.0;
+        } else if (over < halfKnee) {
+            const double d = over + halfKnee;
+            gain = -slope * d * d / (4.0 * halfKnee);
+        } else {
+            gain = -slope * over;
+        }
+    }
+
+    return std::max(gain, DYNAMICS_MIN_GAIN);
+}
+
+ADSP_INLINE void Dynamics::calculateCoefficients() {
+    thresholdLog2 = params.threshold * DB_TO_LOG2;
+    halfKneeLog2 = 0.5 * std::max(params.knee, 0.0) * DB_TO_LOG2;
+    makeupLog2 = params.makeup * DB_TO_LOG2;
+
+    // Gain change per unit of level beyond the threshold
+    const double ratio = std::max(params.ratio, 1.0);
+    switch (params.mode) {
+        case dynamicsMode::limiter: {
+            slope = 1.0;
+            break;
+        }
+        case dynamicsMode::expander: {
+            slope = ratio - 1.0;
+            break;
+        }
+        default: {
+            slope = 1.0 - 1.0 / ratio;
+            break;
+        }
+    }
+
+    // One-pole time constants, 0 ms gives an instant response
+    attackCoefficient = params.attack > 0.0
+                            ? exp(-1000.0 / (params.attack * sampleRate))
+                            : 0.0;
+    releaseCoefficient = params.release > 0.0
+                             ? exp(-1000.0 / (params.release * sampleRate))
+                             : 0.0;
+
+    lookAheadSamples = static_cast<int>(
+        lround(clip(params.lookAhead, 0.0, DYNAMICS_MAX_LOOKAHEAD) * 0.001 *
+               sampleRate));
+}
+}  // namespace adsp
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+    Allpass.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Allpass.h
+*
+* @brief All-pass filter, second-order
+*/
+
+#pragma once
+
+#include "RbjDesign.h"
+
+namespace adsp {
+/**
+* @brief Allpass parameter structure
+*
+*/
+struct AllpassParams {
+    AllpassParams(){};
+
+    AllpassParams &operator=(const AllpassParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            fc = parameters.fc;
+            q = parameters.q;
+            return *this;
+        }
+    }
+
+    // Center frequency
+    double fc = 1000.0;  // Hz
+
+    // Width of the phase transition
+    double q = 0.70710678118654752440;
+};
+
+/**
+* @brief All-pass filter, second-order
+*
+* RBJ Audio EQ Cookbook design by means of a prewarped bilinear transformation.
+* Unity gain at all frequencies, the phase turns by 2 pi around the center frequency.
+*/
+class Allpass {
+   public:
+    Allpass();
+    ~Allpass();
+
+    //==============================================================================
+
+    /**
+    * @brief Clear internal state, set sample rate and recalculate coefficients
+    *
+    * @param sampleRate New sample rate
+    */
+    void reset(double sampleRate);
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    double process(double x);
+
+    /**
+    * @brief Process a block, in place if in == out
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart, e.g. one channel of an
+    * interleaved buffer in place
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate, recalculate coefficients
+    *
+    * @param sampleRate New sample rate
+    */
+    void setSampleRate(double sampleRate);
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Filter parameters
+    */
+    AllpassParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * @param parameters New filter parameters
+    */
+    void setParameters(const AllpassParams &parameters);
+
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Array of coefficients
+    */
+    double *getCoefficients();
+
+    /**
+    * @brief Get the profiling counters of the filter (requires ADSP_ENABLE_PROFILING)
+    *
+    * Coefficient updates count the coefficient recalculations.
+    * Lock-free, can be called from any thread while processing.
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
+   protected:
+    // Sets sample rate and coefficients of many filters at once
+    friend class FilterGroup;
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Object implementing the difference equation
+    */
+    Biquad biquad;
+
+    /**
+    * @brief Filter coefficients
+    */
+    double coefficientsArray[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+    /**
+    * @brief Filter parameters
+    */
+    AllpassParams params;
+
+    /**
+    * @brief Recalculate coefficients, is called when filter parameters change
+    */
+    void calculateFilterCoefficients();
+};
+}  // namespace adsp
@@ -33,120 +33,313 @@
 */
 
 #include "Biquad.h"
+#include "../utility/inline.h"
+#include "BiquadKernels.h"
 
 namespace adsp {
-Biquad::Biquad() {}
-Biquad::~Biquad() {}
+namespace {
+/**
+* @brief Check whether an algorithm uses the derived coefficients
+*/
+inline bool usesDerivedCoefficients(biquadAlgorithm algorithm) {
+    return algorithm == biquadAlgorithm::errorFeedbackDirect ||
+           algorithm == biquadAlgorithm::stateVariable;
+}
+}  // namespace
+
+ADSP_INLINE void calculateDerivedCoefficients(const double *coefficients,
+                                              double *derived) {
+    // Denominator at z = 1 and z = -1, both positive for stable filters
+    const double dc = 1.0 + coefficients[b1] + coefficients[b2];
+    const double nyquist = 1.0 - coefficients[b1] + coefficients[b2];
+
+    // Numerator in powers of (1 - z^-1)
+    derived[ef_n0] = coefficients[a0] + coefficients[a1] + coefficients[a2];
+    derived[ef_n1] = -coefficients[a1] - 2.0 * coefficients[a2];
+    derived[ef_n2] = coefficients[a2];
+    derived[ef_dc] = dc;
+    derived[ef_b2] = coefficients[b2] - 1.0;
+
+    if (dc <= 0.0 || nyquist <= 0.0) {
+        // Not realizable as state-variable filter, output silence
+        memset(&derived[svf_a1], 0,
+               sizeof(double) * (numDerivedCoefficients - svf_a1));
+        return;
+    }
+
+    // The bilinear transform maps the denominator to s^2 + g*k*s + g^2,
+    // with g the prewarped cutoff and k the damping of the state-variable filter
+    const double g = sqrt(dc / nyquist);
+    const double k = 2.0 * (1.0 - coefficients[b2]) / (nyquist * g);
+
+    // Highpass, bandpass and lowpass gains of the mapped numerator
+    const double highpass =
+        (coefficients[a0] - coefficients[a1] + coefficients[a2]) / nyquist;
+    const double bandpass =
+        2.0 * (coefficients[a0] - coefficients[a2]) / (nyquist * g);
+    const double lowpass = derived[ef_n0] / dc;
+
+    derived[svf_a1] = 1.0 / (1.0 + g * (g + k));
+    derived[svf_a2] = g * derived[svf_a1];
+    derived[svf_a3] = g * derived[svf_a2];
+
+    // Mix of input, bandpass and lowpass state (highpass = x - k*bp - lp)
+    derived[svf_m0] = highpass;
+    derived[svf_m1] = bandpass - k * highpass;
+    derived[svf_m2] = lowpass - highpass;
+}
 
 //==============================================================================
 
-void Biquad::reset() {
+ADSP_INLINE Biquad::Biquad() {}
+ADSP_INLINE Biquad::~Biquad() {}
+
+//==============================================================================
+
+ADSP_INLINE void Biquad::reset() {
     memset(&stateArray[0], 0, sizeof(double) * numRegisters);
 }
 
-double Biquad::process(double x) {
-    switch (parameters.calculationType) {
-        // Direct form
-        case biquadAlgorithm::direct: {
-            // y[n] = a0*x[n] + a1*x[n-1] + a2*x[n-2] - b1*y[n-1] - b2*y[n-2]
-            double y = coefficientsArray[a0] * x +
-                       coefficientsArray[a1] * stateArray[x_z1] +
-                       coefficientsArray[a2] * stateArray[x_z2] -
-                       coefficientsArray[b1] * stateArray[y_z1] -
-                       coefficientsArray[b2] * stateArray[y_z2];
+ADSP_INLINE double Biquad::process(double x) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, 1);
+
+    bool underflow = false;
+    const double y =
+        processBiquadSample(parameters.calculationType, coefficientsArray,
+                            derivedArray, stateArray, x, underflow);
+
+    if (underflow) {
+        ADSP_PROFILE_UNDERFLOW_FIX(profileCounters);
+    }
+
+    return y;
+}
+
+ADSP_INLINE void Biquad::processBlock(const double *in, double *out,
+                                      int numSamples) {
+    processStrided(in, out, 1, numSamples);
+}
 
-            fixUnderflow(y);
+ADSP_INLINE void Biquad::processStrided(const double *in, double *out,
+                                        int stride, int numSamples) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, static_cast<uint64_t>(numSamples));
 
-            // Update state registers
-            stateArray[x_z2] = stateArray[x_z1];
-            stateArray[x_z1] = x;
+    const int numUnderflows = processBiquadBlock(
+        parameters.calculationType, coefficientsArray, derivedArray,
+        stateArray, in, out, stride, numSamples);
 
-            stateArray[y_z2] = stateArray[y_z1];
-            stateArray[y_z1] = y;
+    ADSP_PROFILE_UNDERFLOW_FIXES(profileCounters, numUnderflows);
+}
 
-            // Output
-            return y;
+ADSP_INLINE void Biquad::processInterleaved(Biquad *biquads, int numChannels,
+                                            double *data, int frameStride,
+                                            int numFrames) {
+    ADSP_REALTIME_SECTION();
+
+    int channel = 0;
+    while (channel < numChannels) {
+        if (isLaneGroup(biquads + channel, numChannels - channel,
+                        BIQUAD_LANES)) {
+            processLanes<BIQUAD_LANES>(biquads + channel, data + channel,
+                                       frameStride, numFrames);
+            channel += BIQUAD_LANES;
+        } else if (isLaneGroup(biquads + channel, numChannels - channel,
+                               BIQUAD_LANES / 2)) {
+            processLanes<BIQUAD_LANES / 2>(biquads + channel, data + channel,
+                                           frameStride, numFrames);
+            channel += BIQUAD_LANES / 2;
+        } else {
+            biquads[channel].processStrided(data + channel, data + channel,
+                                            frameStride, numFrames);
+            ++channel;
         }
+    }
+}
 
-        // Canonical form, uses only two state registers
-        case biquadAlgorithm::canonical: {
-            // w[n] = x[n] - b1*w[n-1] - b2*w[n-2]
-            double w = x - coefficientsArray[b1] * stateArray[x_z1] -
-                       coefficientsArray[b2] * stateArray[x_z2];
+//==============================================================================
 
-            // y[n] = a0*w[n] + a1*w[n-1] + a2*w[n-2]
-            double y = coefficientsArray[a0] * w +
-                       coefficientsArray[a1] * stateArray[x_z1] +
-                       coefficientsArray[a2] * stateArray[x_z2];
+ADSP_INLINE BiquadParams Biquad::getParameters() { return parameters; }
 
-            fixUnderflow(y);
+ADSP_INLINE void Biquad::setParameters(BiquadParams &_parameters) {
+    parameters = _parameters;
 
-            // Update state registers
-            stateArray[x_z2] = stateArray[x_z1];
-            stateArray[x_z1] = w;
+    updateDerivedCoefficients();
+}
 
-            // Output
-            return y;
-        }
+ADSP_INLINE void Biquad::setCoefficients(double *coefficients) {
+    memcpy(&coefficientsArray[0], &coefficients[0],
+           sizeof(double) * numCoefficients);
+
+    updateDerivedCoefficients();
 
-        // Transposed direct form
-        case biquadAlgorithm::transposedDirect: {
-            // w[n] =  x[n] + stateArray[y_z1]
-            double w = x + stateArray[y_z1];
-            // y[n] = a0*w[n] + stateArray[x_z1]
-            double y = coefficientsArray[a0] * w + stateArray[x_z1];
+    ADSP_PROFILE_COEFFICIENT_UPDATE(profileCounters);
+}
 
-            fixUnderflow(y);
+ADSP_INLINE double *Biquad::getCoefficients() { return &coefficientsArray[0]; }
 
-            // Update state registers
-            stateArray[y_z1] = stateArray[y_z2] - coefficientsArray[b1] * w;
-            stateArray[y_z2] = -coefficientsArray[b2] * w;
+ADSP_INLINE double *Biquad::getStateArray() { return &stateArray[0]; }
 
-            stateArray[x_z1] = stateArray[x_z2] + coefficientsArray[a1] * w;
-            stateArray[x_z2] = coefficientsArray[a2] * w;
+ADSP_INLINE ProfileSnapshot Biquad::getProfile() {
+    return ADSP_PROFILE_SNAPSHOT(profileCounters);
+}
 
-            // Output
-            return y;
+ADSP_INLINE void Biquad::resetProfile() { ADSP_PROFILE_RESET(profileCounters); }
+
+ADSP_INLINE void Biquad::updateDerivedCoefficients() {
+    if (usesDerivedCoefficients(parameters.calculationType)) {
+        calculateDerivedCoefficients(coefficientsArray, derivedArray);
+    }
+}
+
+ADSP_INLINE bool Biquad::isLaneGroup(const Biquad *biquads, int numChannels,
+                                     int lanes) {
+    if (numChannels < lanes) {
+        return false;
+    }
+    for (int lane = 0; lane < lanes; ++lane) {
+        if (biquads[lane].parameters.calculationType !=
+            biquadAlgorithm::transposedCanonical) {
+            return false;
         }
+    }
+    return true;
+}
+
+template <int lanes>
+inline void Biquad::processLanes(Biquad *biquads, double *data,
+                                 int frameStride, int numFrames) {
+    // Coefficients and state of the group live in locals and every loop has the
+    // fixed trip count lanes, so the lane loop vectorizes
+    double c0[lanes], c1[lanes], c2[lanes], d1[lanes], d2[lanes];
+    double z1[lanes], z2[lanes];
+    for (int lane = 0; lane < lanes; ++lane) {
+        const double *c = biquads[lane].coefficientsArray;
+        c0[lane] = c[a0];
+        c1[lane] = c[a1];
+        c2[lane] = c[a2];
+        d1[lane] = c[b1];
+        d2[lane] = c[b2];
+        z1[lane] = biquads[lane].stateArray[x_z1];
+        z2[lane] = biquads[lane].stateArray[x_z2];
+    }
 
-        // Transposed canonical form
-        case biquadAlgorithm::transposedCanonical: {
-            // y[n] = a0*x[n] + stateArray[x_z1]
-            double y = coefficientsArray[a0] * x + stateArray[x_z1];
+    for (int n = 0; n < numFrames; ++n) {
+        double *frame = data + static_cast<size_t>(n) * frameStride;
 
-            fixUnderflow(y);
+        double x[lanes];
+        for (int lane = 0; lane < lanes; ++lane) {
+            x[lane] = frame[lane];
+        }
 
-            // Update state registers
-            stateArray[x_z1] = coefficientsArray[a1] * x -
-                               coefficientsArray[b1] * y + stateArray[x_z2];
+        double y[lanes];
+        for (int lane = 0; lane < lanes; ++lane) {
+            // Transposed canonical form, as in processBiquadSample()
+            y[lane] = c0[lane] * x[lane] + z1[lane];
 
-            stateArray[x_z2] =
-                coefficientsArray[a2] * x - coefficientsArray[b2] * y;
+            // Flush underflow to zero, as fixUnderflow() but without a branch
+            y[lane] = fabs(y[lane]) < MIN_FLOAT_VAL_POS ? 0.0 : y[lane];
 
-            // Output
-            return y;
+            z1[lane] = c1[lane] * x[lane] - d1[lane] * y[lane] + z2[lane];
+            z2[lane] = c2[lane] * x[lane] - d2[lane] * y[lane];
         }
 
-        default: {
-            return x;  // Did not process sample
+        for (int lane = 0; lane < lanes; ++lane) {
+            frame[lane] = y[lane];
         }
     }
+
+    for (int lane = 0; lane < lanes; ++lane) {
+        biquads[lane].stateArray[x_z1] = z1[lane];
+        biquads[lane].stateArray[x_z2] = z2[lane];
+    }
 }
 
 //==============================================================================
 
-BiquadParams Biquad::getParameters() { return parameters; }
+ADSP_INLINE BiquadFloat::BiquadFloat() {}
+ADSP_INLINE BiquadFloat::~BiquadFloat() {}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadFloat::reset() {
+    memset(&stateArray[0], 0, sizeof(float) * numRegisters);
+}
+
+ADSP_INLINE float BiquadFloat::process(float x) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, 1);
+
+    bool underflow = false;
+    const float y =
+        processBiquadSample(parameters.calculationType, processingArray,
+                            derivedArray, stateArray, x, underflow);
+
+    if (underflow) {
+        ADSP_PROFILE_UNDERFLOW_FIX(profileCounters);
+    }
+
+    return y;
+}
+
+ADSP_INLINE void BiquadFloat::processBlock(const float *in, float *out,
+                                           int numSamples) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, static_cast<uint64_t>(numSamples));
+
+    const int numUnderflows = processBiquadBlock(
+        parameters.calculationType, processingArray, derivedArray, stateArray,
+        in, out, 1, numSamples);
+
+    ADSP_PROFILE_UNDERFLOW_FIXES(profileCounters, numUnderflows);
+}
 
-void Biquad::setParameters(BiquadParams &_parameters) {
+//==============================================================================
+
+ADSP_INLINE BiquadParams BiquadFloat::getParameters() { return parameters; }
+
+ADSP_INLINE void BiquadFloat::setParameters(BiquadParams &_parameters) {
     parameters = _parameters;
+
+    updateProcessingCoefficients();
 }
 
-void Biquad::setCoefficients(double *coefficients) {
+ADSP_INLINE void BiquadFloat::setCoefficients(double *coefficients) {
     memcpy(&coefficientsArray[0], &coefficients[0],
            sizeof(double) * numCoefficients);
+
+    updateProcessingCoefficients();
+
+    ADSP_PROFILE_COEFFICIENT_UPDATE(profileCounters);
+}
+
+ADSP_INLINE double *BiquadFloat::getCoefficients() {
+    return &coefficientsArray[0];
 }
 
-double *Biquad::getCoefficients() { return &coefficientsArray[0]; }
+ADSP_INLINE float *BiquadFloat::getStateArray() { return &stateArray[0]; }
 
-double *Biquad::getStateArray() { return &stateArray[0]; }
+ADSP_INLINE ProfileSnapshot BiquadFloat::getProfile() {
+    return ADSP_PROFILE_SNAPSHOT(profileCounters);
+}
+
+ADSP_INLINE void BiquadFloat::resetProfile() {
+    ADSP_PROFILE_RESET(profileCounters);
+}
+
+ADSP_INLINE void BiquadFloat::updateProcessingCoefficients() {
+    for (int i = 0; i < numCoefficients; ++i) {
+        processingArray[i] = static_cast<float>(coefficientsArray[i]);
+    }
+
+    if (usesDerivedCoefficients(parameters.calculationType)) {
+        // Derive in double precision, then round
+        double derived[numDerivedCoefficients];
+        calculateDerivedCoefficients(coefficientsArray, derived);
+        for (int i = 0; i < numDerivedCoefficients; ++i) {
+            derivedArray[i] = static_cast<float>(derived[i]);
+        }
+    }
+}
 }  // namespace adsp
\ No newline at end of file
@@ -40,9 +40,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
 
+#include "../debug/Profiler.h"
+#include "../debug/RealtimeCheck.h"
 #include "../utility/utility.h"
 
 namespace adsp {
@@ -59,23 +63,82 @@ namespace adsp {
 */
 enum filterCoefficients { a0, a1, a2, b1, b2, numCoefficients };
 
+/**
+* @brief Filter coefficients by value, indexed with filterCoefficients
+*
+* Returned by the constexpr designs (designRcLp1() etc.) so coefficients can be
+* computed at compile time, see ConstantBiquad.
+*/
+typedef std::array<double, numCoefficients> BiquadCoefficients;
+
 /**
 * @brief State registers for a second-order filter (only two needed for canonical forms)
 *
 * For use with an array of state registers.
+* e_z1 and e_z2 hold the rounding errors of the error feedback form.
 */
-enum stateRegisters { x_z1, x_z2, y_z1, y_z2, numRegisters };
+enum stateRegisters { x_z1, x_z2, y_z1, y_z2, e_z1, e_z2, numRegisters };
+
+/**
+* @brief Coefficients derived from the filter coefficients for the robust algorithms
+*
+* Error feedback direct form, with the difference operator @f$ \Delta = 1 - z^{-1} @f$:  
+* @f$ N(z) = n_0 + n_1 \Delta + n_2 \Delta^2 @f$,
+* ef_dc = @f$ 1 + b_1 + b_2 @f$ and ef_b2 = @f$ b_2 - 1 @f$.  
+*
+* State-variable form: svf_a1, svf_a2, svf_a3 are the coefficients of the trapezoidal
+* state-variable filter, svf_m0, svf_m1, svf_m2 mix its input, band- and lowpass signals.
+*/
+enum derivedCoefficients {
+    ef_n0,
+    ef_n1,
+    ef_n2,
+    ef_dc,
+    ef_b2,
+    svf_a1,
+    svf_a2,
+    svf_a3,
+    svf_m0,
+    svf_m1,
+    svf_m2,
+    numDerivedCoefficients
+};
 
 /**
 * @brief Different structures (algorithms) implementing the second-order difference equation
+*
+* The direct and transposed forms lose precision for poles close to z = 1 (low cutoff
+* frequencies at high sample rates): b1 and b2 approach -2 and 1, the information about
+* the pole position is in their last bits and rounding noise is amplified by the
+* recursion. In double precision this is harmless, in single precision (BiquadFloat) a
+* 20 Hz lowpass at 192 kHz has a noise floor around -30 dBFS.
+*
+* The two robust forms store coefficients relative to z = 1 and keep their noise floor
+* low enough for single precision:
+*
+* - errorFeedbackDirect: direct form I in the difference operator basis. The rounding
+*   error of the output sum is captured exactly and fed back through the recursion.
+*   Best suited for lowpass sections, where the feed-forward terms are small
+*   (below -130 dBFS for a 20 Hz lowpass at 192 kHz in single precision). Requires
+*   IEEE arithmetic, do not compile with -ffast-math or similar.
+* - stateVariable: the transfer function realized by a trapezoidal state-variable filter
+*   and an output mix. Suited for all responses (below -95 dBFS down to 20 Hz at
+*   192 kHz in single precision), requires stable coefficients.
 */
 enum class biquadAlgorithm {
     direct,
     canonical,
     transposedDirect,
-    transposedCanonical
+    transposedCanonical,
+    errorFeedbackDirect,
+    stateVariable
 };
 
+/**
+* @brief Number of channels Biquad::processInterleaved() filters side by side
+*/
+constexpr int BIQUAD_LANES = 8;
+
 /**
 * @brief Biquad parameter structure
 * 
@@ -96,6 +159,16 @@ struct BiquadParams {
     biquadAlgorithm calculationType = biquadAlgorithm::direct;
 };
 
+/**
+* @brief Calculate the coefficients of the robust algorithms
+*
+* Evaluated in double precision, from double precision filter coefficients.
+*
+* @param coefficients Array of numCoefficients filter coefficients
+* @param derived Array of numDerivedCoefficients derived coefficients
+*/
+void calculateDerivedCoefficients(const double *coefficients, double *derived);
+
 //==============================================================================
 
 /**
@@ -104,6 +177,9 @@ struct BiquadParams {
 * Second-order structure to filter input signals given a set of filter coefficients.  
 * Different algorithms implementing the difference equation can be chosen.  
 * Higher order filters are usually built up from multiple biquad stages.  
+*
+* Processing runs the kernels of BiquadKernels.h on the arrays of the object. For
+* state kept outside of the object, e.g. voice pools, call the kernels directly.
 */
 class Biquad {
    public:
@@ -128,6 +204,53 @@ class Biquad {
     */
     double process(double x);
 
+    /**
+    * @brief Process a block
+    *
+    * The algorithm is selected once per block instead of once per sample. In-place
+    * processing (in == out) is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart
+    *
+    * Filters e.g. one channel of an interleaved buffer in place, without copying it
+    * out. In-place processing (in == out) is allowed.
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
+    /**
+    * @brief Process interleaved channels in place, one Biquad per channel
+    *
+    * Groups of BIQUAD_LANES or BIQUAD_LANES / 2 adjacent channels that all use
+    * biquadAlgorithm::transposedCanonical (the default of the filter wrappers) are
+    * filtered side by side with their state in local arrays, so the compiler
+    * computes several channels per instruction. Other channels run through
+    * processStrided(). The output is the same as processStrided() per channel.
+    * Channels filtered in groups are not seen by the profiling counters.
+    *
+    * @param biquads Array of numChannels biquads
+    * @param numChannels Number of channels
+    * @param data First sample of the first channel
+    * @param frameStride Distance between two frames, numChannels for interleaved
+    * buffers, more for frames with a header or padding
+    * @param numFrames Number of frames
+    */
+    static void processInterleaved(Biquad *biquads, int numChannels,
+                                   double *data, int frameStride,
+                                   int numFrames);
+
     //==============================================================================
 
     /**
@@ -165,22 +288,197 @@ class Biquad {
     */
     double *getStateArray();
 
+    /**
+    * @brief Get the profiling counters (requires ADSP_ENABLE_PROFILING)
+    *
+    * Lock-free, can be called from any thread while processing.
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
     //==============================================================================
 
    protected:
+    /**
+     * @brief Calculate the derived coefficients if the selected algorithm uses them
+     */
+    void updateDerivedCoefficients();
+
+    /**
+     * @brief Check whether the next lanes biquads exist and can be filtered side by side
+     */
+    static bool isLaneGroup(const Biquad *biquads, int numChannels, int lanes);
+
+    /**
+     * @brief Filter a group of interleaved channels side by side
+     */
+    template <int lanes>
+    static void processLanes(Biquad *biquads, double *data, int frameStride,
+                             int numFrames);
+
     /**
      * @brief Array of filter coefficients
      */
     double coefficientsArray[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
 
+    /**
+     * @brief Array of derived coefficients, only up to date for the robust algorithms
+     */
+    double derivedArray[numDerivedCoefficients] = {};
+
+    /**
+     * @brief State array
+     */
+    double stateArray[numRegisters] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    /**
+     * @brief Biquad parameters
+     */
+    BiquadParams parameters;
+
+    /**
+     * @brief Profiling counters, only present with ADSP_ENABLE_PROFILING
+     */
+    ADSP_PROFILE_COUNTERS(profileCounters);
+};
+
+//==============================================================================
+
+/**
+* @brief Single precision biquadratic filter
+*
+* Same structures as Biquad, with single precision state and arithmetic for float
+* pipelines. Coefficients are passed in double precision, the derived coefficients
+* of the robust algorithms are calculated from them before rounding to float.
+*
+* Use biquadAlgorithm::stateVariable (or errorFeedbackDirect for lowpass sections)
+* for cutoff frequencies below a few hundred Hz, see biquadAlgorithm.
+*/
+class BiquadFloat {
+   public:
+    BiquadFloat();
+    ~BiquadFloat();
+
+    //==============================================================================
+
+    /**
+    * @brief Sets all state registers to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    float process(float x);
+
+    /**
+    * @brief Process a block
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const float *in, float *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get the biquad parameters
+    *
+    * @return Parameters
+    */
+    BiquadParams getParameters();
+
+    /**
+    * @brief Set new Parameters
+    *
+    * @param _parameters New biquad parameters
+    */
+    void setParameters(BiquadParams &_parameters);
+
+    /**
+    * @brief Set new coefficients
+    *
+    * @param coefficients Array of double precision filter coefficients
+    */
+    void setCoefficients(double *coefficients);
+
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Array of double precision coefficients as passed to setCoefficients()
+    */
+    double *getCoefficients();
+
+    /**
+    * @brief Get current state array
+    *
+    * @return State array
+    */
+    float *getStateArray();
+
+    /**
+    * @brief Get the profiling counters (requires ADSP_ENABLE_PROFILING)
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
+    //==============================================================================
+
+   protected:
+    /**
+     * @brief Round the coefficients of the selected algorithm to single precision
+     */
+    void updateProcessingCoefficients();
+
+    /**
+     * @brief Array of filter coefficients as passed in
+     */
+    double coefficientsArray[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+    /**
+     * @brief Single precision filter coefficients
+     */
+    float processingArray[numCoefficients] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    /**
+     * @brief Single precision derived coefficients, only up to date for the robust algorithms
+     */
+    float derivedArray[numDerivedCoefficients] = {};
+
     /**
      * @brief State array
      */
-    double stateArray[numRegisters] = {0.0, 0.0, 0.0, 0.0};
+    float stateArray[numRegisters] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
 
     /**
      * @brief Biquad parameters
      */
     BiquadParams parameters;
+
+    /**
+     * @brief Profiling counters, only present with ADSP_ENABLE_PROFILING
+     */
+    ADSP_PROFILE_COUNTERS(profileCounters);
 };
 }  // namespace adsp
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    BiquadCascade.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE BiquadCascade::BiquadCascade() {
+    // All sections start as identity
+    for (int section = 0; section < MAX_CASCADE_SECTIONS; ++section) {
+        coefficients[section][a0] = 1.0;
+    }
+}
+
+ADSP_INLINE BiquadCascade::~BiquadCascade() {}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadCascade::reset() {
+    memset(&state[0][0], 0, sizeof(state));
+}
+
+ADSP_INLINE double BiquadCascade::process(double x) {
+    ADSP_REALTIME_SECTION();
+
+    for (int section = 0; section < numSections; ++section) {
+        const double *c = coefficients[section];
+        double *s = state[section];
+
+        // y[n] = a0*x[n] + s1, transposed canonical form as in Biquad
+        double y = c[a0] * x + s[0];
+
+        fixUnderflow(y);
+
+        s[0] = c[a1] * x - c[b1] * y + s[1];
+        s[1] = c[a2] * x - c[b2] * y;
+
+        x = y;
+    }
+
+    return x;
+}
+
+ADSP_INLINE void BiquadCascade::processBlock(const double *in, double *out,
+                                             int numSamples) {
+    processStrided(in, out, 1, numSamples);
+}
+
+ADSP_INLINE void BiquadCascade::processStrided(const double *in, double *out,
+                                               int stride, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (in != out && stride == 1) {
+        memcpy(out, in, sizeof(double) * numSamples);
+    } else if (in != out) {
+        for (int n = 0; n < numSamples; ++n) {
+            out[n * stride] = in[n * stride];
+        }
+    }
+
+    for (int section = 0; section < numSections; ++section) {
+        // Coefficients and state in locals for the whole block
+        const double c0 = coefficients[section][a0];
+        const double c1 = coefficients[section][a1];
+        const double c2 = coefficients[section][a2];
+        const double d1 = coefficients[section][b1];
+        const double d2 = coefficients[section][b2];
+        double s0 = state[section][0];
+        double s1 = state[section][1];
+
+        for (int n = 0; n < numSamples; ++n) {
+            const double x = out[n * stride];
+            const double y = c0 * x + s0;
+            s0 = c1 * x - d1 * y + s1;
+            s1 = c2 * x - d2 * y;
+            out[n * stride] = y;
+        }
+
+        // Flushing the states once per block keeps them out of the denormal range
+        fixUnderflow(s0);
+        fixUnderflow(s1);
+        state[section][0] = s0;
+        state[section][1] = s1;
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadCascade::setNumSections(int _numSections) {
+    numSections = _numSections < MAX_CASCADE_SECTIONS ? _numSections
+                                                      : MAX_CASCADE_SECTIONS;
+}
+
+ADSP_INLINE int BiquadCascade::getNumSections() { return numSections; }
+
+ADSP_INLINE void BiquadCascade::setSection(int section,
+                                           const double *_coefficients) {
+    memcpy(&coefficients[section][0], _coefficients,
+           sizeof(double) * numCoefficients);
+}
+
+ADSP_INLINE double *BiquadCascade::getSectionCoefficients(int section) {
+    return &coefficients[section][0];
+}
+}  // namespace adsp
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+    BiquadCascade.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file BiquadCascade.h
+*
+* @brief Fused cascade of second-order sections
+*/
+
+#pragma once
+
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Maximum number of sections in a BiquadCascade
+*/
+constexpr int MAX_CASCADE_SECTIONS = 16;
+
+/**
+* @brief Cascade of second-order sections in transposed canonical form
+*
+* Coefficients and states of all sections are stored in fixed arrays inside the object,
+* so the cascade never allocates and runs as one loop instead of one Biquad call per section.
+* The block path runs every section over the whole block in turn, keeping the
+* coefficients of one section in registers.
+*/
+class BiquadCascade {
+   public:
+    BiquadCascade();
+    ~BiquadCascade();
+
+    //==============================================================================
+
+    /**
+    * @brief Sets all state registers to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Process a single sample through all sections
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    double process(double x);
+
+    /**
+    * @brief Process a block through all sections
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart, e.g. one channel of an
+    * interleaved buffer in place
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set number of active sections, new sections pass the signal unchanged
+    *
+    * @param numSections Number of sections, at most MAX_CASCADE_SECTIONS
+    */
+    void setNumSections(int numSections);
+
+    /**
+    * @brief Get number of active sections
+    *
+    * @return Number of sections
+    */
+    int getNumSections();
+
+    /**
+    * @brief Set coefficients of one section
+    *
+    * @param section Section index
+    * @param coefficients Array of numCoefficients filter coefficients
+    */
+    void setSection(int section, const double *coefficients);
+
+    /**
+    * @brief Get coefficients of one section
+    *
+    * @param section Section index
+    * @return Array of numCoefficients filter coefficients
+    */
+    double *getSectionCoefficients(int section);
+
+   protected:
+    /**
+    * @brief Number of active sections
+    */
+    int numSections{0};
+
+    /**
+    * @brief Coefficients of all sections
+    */
+    double coefficients[MAX_CASCADE_SECTIONS][numCoefficients] = {};
+
+    /**
+    * @brief State registers of all sections
+    */
+    double state[MAX_CASCADE_SECTIONS][2] = {};
+};
+}  // namespace adsp
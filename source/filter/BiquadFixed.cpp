@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+    BiquadFixed.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "BiquadFixed.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+// Quantize a coefficient to the given number of fractional bits, saturating
+int64_t quantizeFixedCoefficient(double coefficient, int fractionalBits,
+                                 int64_t min, int64_t max) {
+    const int64_t q = llround(ldexp(coefficient, fractionalBits));
+    return q < min ? min : q > max ? max : q;
+}
+
+// Shift the accumulator back to sample scale, with optional error feedback
+inline int64_t requantizeFixed(int64_t accumulator, int shift,
+                               bool errorFeedback, int64_t &error) {
+    if (errorFeedback) {
+        accumulator += error;
+    }
+
+    // Arithmetic shift rounds towards minus infinity, the remainder is >= 0
+    const int64_t y = accumulator >> shift;
+    error = accumulator - y * (static_cast<int64_t>(1) << shift);
+    return y;
+}
+}  // namespace
+
+ADSP_INLINE int calculateFixedPostShift(const double *coefficients) {
+    const double feedback =
+        fmax(fabs(coefficients[b1]), fabs(coefficients[b2]));
+    const double feedForward = fabs(coefficients[a0]) +
+                               fabs(coefficients[a1]) +
+                               fabs(coefficients[a2]);
+    const double bound = fmax(feedback, feedForward);
+
+    int shift = 0;
+    while (shift < 15 && bound >= ldexp(1.0, shift)) {
+        ++shift;
+    }
+    return shift;
+}
+
+//==============================================================================
+
+ADSP_INLINE BiquadQ31::BiquadQ31() {}
+ADSP_INLINE BiquadQ31::~BiquadQ31() {}
+
+ADSP_INLINE void BiquadQ31::reset() {
+    memset(&stateArray[0], 0, sizeof(int32_t) * numRegisters);
+    error = 0;
+}
+
+ADSP_INLINE int32_t BiquadQ31::process(int32_t x) {
+    ADSP_REALTIME_SECTION();
+
+    // Unsigned accumulation wraps around without undefined behaviour,
+    // the final sum fits into 64 bits for any stable filter
+    uint64_t accumulator = static_cast<uint64_t>(
+        static_cast<int64_t>(coefficientsArray[a0]) * x);
+    accumulator += static_cast<uint64_t>(
+        static_cast<int64_t>(coefficientsArray[a1]) * stateArray[x_z1]);
+    accumulator += static_cast<uint64_t>(
+        static_cast<int64_t>(coefficientsArray[a2]) * stateArray[x_z2]);
+    accumulator -= static_cast<uint64_t>(
+        static_cast<int64_t>(coefficientsArray[b1]) * stateArray[y_z1]);
+    accumulator -= static_cast<uint64_t>(
+        static_cast<int64_t>(coefficientsArray[b2]) * stateArray[y_z2]);
+
+    int64_t y = requantizeFixed(static_cast<int64_t>(accumulator),
+                                31 - postShift, parameters.errorFeedback,
+                                error);
+
+    // Saturate
+    y = y > INT32_MAX ? INT32_MAX : y < INT32_MIN ? INT32_MIN : y;
+
+    // Update state registers
+    stateArray[x_z2] = stateArray[x_z1];
+    stateArray[x_z1] = x;
+
+    stateArray[y_z2] = stateArray[y_z1];
+    stateArray[y_z1] = static_cast<int32_t>(y);
+
+    return static_cast<int32_t>(y);
+}
+
+ADSP_INLINE void BiquadQ31::processBlock(const int32_t *in, int32_t *out,
+                                         int numSamples) {
+    for (int n = 0; n < numSamples; ++n) {
+        out[n] = process(in[n]);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadQ31::setCoefficients(const double *coefficients) {
+    postShift = calculateFixedPostShift(coefficients);
+
+    for (int i = 0; i < numCoefficients; ++i) {
+        coefficientsArray[i] = static_cast<int32_t>(quantizeFixedCoefficient(
+            coefficients[i], 31 - postShift, INT32_MIN, INT32_MAX));
+    }
+}
+
+ADSP_INLINE const int32_t *BiquadQ31::getCoefficients() {
+    return &coefficientsArray[0];
+}
+
+ADSP_INLINE int BiquadQ31::getPostShift() { return postShift; }
+
+ADSP_INLINE BiquadFixedParams BiquadQ31::getParameters() { return parameters; }
+
+ADSP_INLINE void BiquadQ31::setParameters(
+    const BiquadFixedParams &_parameters) {
+    parameters = _parameters;
+}
+
+//==============================================================================
+
+ADSP_INLINE BiquadQ15::BiquadQ15() {}
+ADSP_INLINE BiquadQ15::~BiquadQ15() {}
+
+ADSP_INLINE void BiquadQ15::reset() {
+    memset(&stateArray[0], 0, sizeof(int16_t) * numRegisters);
+    error = 0;
+}
+
+ADSP_INLINE int16_t BiquadQ15::process(int16_t x) {
+    ADSP_REALTIME_SECTION();
+
+    const int32_t feedForward =
+        static_cast<int32_t>(coefficientsArray[a0]) * x +
+        static_cast<int32_t>(coefficientsArray[a1]) * stateArray[x_z1] +
+        static_cast<int32_t>(coefficientsArray[a2]) * stateArray[x_z2];
+
+    stateArray[x_z2] = stateArray[x_z1];
+    stateArray[x_z1] = x;
+
+    return processFeedback(feedForward);
+}
+
+ADSP_INLINE void BiquadQ15::processBlock(const int16_t *in, int16_t *out,
+                                         int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    const int32_t c0 = coefficientsArray[a0];
+    const int32_t c1 = coefficientsArray[a1];
+    const int32_t c2 = coefficientsArray[a2];
+
+    for (int start = 0; start < numSamples; start += BIQUAD_Q15_CHUNK) {
+        const int count = numSamples - start < BIQUAD_Q15_CHUNK
+                              ? numSamples - start
+                              : BIQUAD_Q15_CHUNK;
+
+        // Input with two samples of history in front
+        int16_t x[BIQUAD_Q15_CHUNK + 2];
+        x[0] = stateArray[x_z2];
+        x[1] = stateArray[x_z1];
+        memcpy(&x[2], &in[start], sizeof(int16_t) * count);
+
+        // Feed-forward part, no recursion, vectorizes
+        int32_t feedForward[BIQUAD_Q15_CHUNK];
+        for (int n = 0; n < count; ++n) {
+            feedForward[n] = c0 * x[n + 2] + c1 * x[n + 1] + c2 * x[n];
+        }
+
+        stateArray[x_z2] = x[count];
+        stateArray[x_z1] = x[count + 1];
+
+        // Feedback part, sample by sample
+        for (int n = 0; n < count; ++n) {
+            out[start + n] = processFeedback(feedForward[n]);
+        }
+    }
+}
+
+ADSP_INLINE int16_t BiquadQ15::processFeedback(int32_t feedForward) {
+    const int64_t accumulator =
+        static_cast<int64_t>(feedForward) -
+        static_cast<int64_t>(coefficientsArray[b1]) * stateArray[y_z1] -
+        static_cast<int64_t>(coefficientsArray[b2]) * stateArray[y_z2];
+
+    int64_t y = requantizeFixed(accumulator, 15 - postShift,
+                                parameters.errorFeedback, error);
+
+    // Saturate
+    y = y > INT16_MAX ? INT16_MAX : y < INT16_MIN ? INT16_MIN : y;
+
+    stateArray[y_z2] = stateArray[y_z1];
+    stateArray[y_z1] = static_cast<int16_t>(y);
+
+    return static_cast<int16_t>(y);
+}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadQ15::setCoefficients(const double *coefficients) {
+    postShift = calculateFixedPostShift(coefficients);
+
+    for (int i = 0; i < numCoefficients; ++i) {
+        coefficientsArray[i] = static_cast<int16_t>(quantizeFixedCoefficient(
+            coefficients[i], 15 - postShift, INT16_MIN, INT16_MAX));
+    }
+}
+
+ADSP_INLINE const int16_t *BiquadQ15::getCoefficients() {
+    return &coefficientsArray[0];
+}
+
+ADSP_INLINE int BiquadQ15::getPostShift() { return postShift; }
+
+ADSP_INLINE BiquadFixedParams BiquadQ15::getParameters() { return parameters; }
+
+ADSP_INLINE void BiquadQ15::setParameters(
+    const BiquadFixedParams &_parameters) {
+    parameters = _parameters;
+}
+}  // namespace adsp
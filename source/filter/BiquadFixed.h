@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+    BiquadFixed.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file BiquadFixed.h
+*
+* @brief Fixed-point biquads for int32 (Q31) and int16 (Q15) streams
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Fixed-point biquad parameter structure
+*
+*/
+struct BiquadFixedParams {
+    BiquadFixedParams() {}
+
+    BiquadFixedParams &operator=(const BiquadFixedParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            errorFeedback = parameters.errorFeedback;
+            return *this;
+        }
+    }
+
+    // Feed the truncation error of the accumulator back into the next sample.
+    // Shapes the requantization noise with a zero at DC, which matters most for
+    // low cutoff frequencies where the poles sit close to z = 1.
+    bool errorFeedback = true;
+};
+
+/**
+* @brief Number of fractional bits lost to fit the coefficients, see BiquadQ31
+*
+* Smallest shift s >= 0 with max(|b1|, |b2|) < 2^s and |a0| + |a1| + |a2| < 2^s.
+*
+* @param coefficients Array of numCoefficients filter coefficients
+* @return Post shift s
+*/
+int calculateFixedPostShift(const double *coefficients);
+
+//==============================================================================
+
+/**
+* @brief Direct form I biquad on Q31 samples
+*
+* Coefficients are quantized to Q(31 - s) with the post shift s of
+* calculateFixedPostShift(), products are summed in a 64-bit accumulator and the
+* result is shifted back by 31 - s bits and saturated to the int32 range.
+* Intermediate sums wrap around harmlessly (unsigned arithmetic), only the final sum
+* has to fit, which holds for every stable filter.
+*
+* Compared to the double precision Biquad, the output deviates by less than a few
+* LSB plus the coefficient quantization error, which is below 2^(s - 31) per coefficient.
+*/
+class BiquadQ31 {
+   public:
+    BiquadQ31();
+    ~BiquadQ31();
+
+    //==============================================================================
+
+    /**
+    * @brief Sets all state registers and the error feedback to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample (Q31)
+    * @return Output sample (Q31)
+    */
+    int32_t process(int32_t x);
+
+    /**
+    * @brief Process a block
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block (Q31)
+    * @param out Output block (Q31)
+    * @param numSamples Number of samples
+    */
+    void processBlock(const int32_t *in, int32_t *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Quantize and set new coefficients
+    *
+    * @param coefficients Array of numCoefficients floating point filter coefficients
+    */
+    void setCoefficients(const double *coefficients);
+
+    /**
+    * @brief Get the quantized coefficients
+    *
+    * @return Array of numCoefficients Q(31 - postShift) coefficients
+    */
+    const int32_t *getCoefficients();
+
+    /**
+    * @brief Get the post shift of the current coefficients
+    *
+    * @return Post shift
+    */
+    int getPostShift();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Parameters
+    */
+    BiquadFixedParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * @param parameters New parameters
+    */
+    void setParameters(const BiquadFixedParams &parameters);
+
+   protected:
+    /**
+    * @brief Quantized coefficients
+    */
+    int32_t coefficientsArray[numCoefficients] = {0, 0, 0, 0, 0};
+
+    /**
+    * @brief State registers
+    */
+    int32_t stateArray[numRegisters] = {0, 0, 0, 0};
+
+    /**
+    * @brief Fractional bits of the accumulator dropped in the last sample
+    */
+    int64_t error{0};
+
+    /**
+    * @brief Post shift of the coefficients
+    */
+    int postShift{0};
+
+    /**
+    * @brief Parameters
+    */
+    BiquadFixedParams parameters;
+};
+
+//==============================================================================
+
+/**
+* @brief Number of samples the Q15 block path processes per chunk
+*/
+constexpr int BIQUAD_Q15_CHUNK = 64;
+
+/**
+* @brief Direct form I biquad on Q15 samples
+*
+* Same structure as BiquadQ31 with Q(15 - s) coefficients.
+* The block path splits the filter: the feed-forward part has no recursion and is
+* computed for a whole chunk in 32-bit integers, a loop the compiler vectorizes.
+* The post shift bounds its sum below 2^31. Only the feedback part runs sample by sample.
+*/
+class BiquadQ15 {
+   public:
+    BiquadQ15();
+    ~BiquadQ15();
+
+    //==============================================================================
+
+    /**
+    * @brief Sets all state registers and the error feedback to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample (Q15)
+    * @return Output sample (Q15)
+    */
+    int16_t process(int16_t x);
+
+    /**
+    * @brief Process a block
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block (Q15)
+    * @param out Output block (Q15)
+    * @param numSamples Number of samples
+    */
+    void processBlock(const int16_t *in, int16_t *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Quantize and set new coefficients
+    *
+    * @param coefficients Array of numCoefficients floating point filter coefficients
+    */
+    void setCoefficients(const double *coefficients);
+
+    /**
+    * @brief Get the quantized coefficients
+    *
+    * @return Array of numCoefficients Q(15 - postShift) coefficients
+    */
+    const int16_t *getCoefficients();
+
+    /**
+    * @brief Get the post shift of the current coefficients
+    *
+    * @return Post shift
+    */
+    int getPostShift();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Parameters
+    */
+    BiquadFixedParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * @param parameters New parameters
+    */
+    void setParameters(const BiquadFixedParams &parameters);
+
+   protected:
+    /**
+    * @brief Feedback part of one sample given the feed-forward sum
+    */
+    int16_t processFeedback(int32_t feedForward);
+
+    /**
+    * @brief Quantized coefficients
+    */
+    int16_t coefficientsArray[numCoefficients] = {0, 0, 0, 0, 0};
+
+    /**
+    * @brief State registers
+    */
+    int16_t stateArray[numRegisters] = {0, 0, 0, 0};
+
+    /**
+    * @brief Fractional bits of the accumulator dropped in the last sample
+    */
+    int64_t error{0};
+
+    /**
+    * @brief Post shift of the coefficients
+    */
+    int postShift{0};
+
+    /**
+    * @brief Parameters
+    */
+    BiquadFixedParams parameters;
+};
+}  // namespace adsp
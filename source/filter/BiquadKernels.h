@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+    BiquadKernels.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file BiquadKernels.h
+*
+* @brief Stateless second-order filter kernels over external coefficients and state
+*/
+
+#pragma once
+
+#include "Biquad.h"
+
+namespace adsp {
+/*
+* The kernels Biquad and BiquadFloat are built on, as free functions over plain
+* arrays, for state kept outside of a filter object: pools of voices laid out by
+* the caller, or state that is snapshot and restored (voice stealing, rollback) by
+* copying numRegisters values. Nothing is allocated or copied besides the state of
+* the filter being processed.
+*
+* Arrays:
+* - c: numCoefficients coefficients, indexed with filterCoefficients
+* - d: numDerivedCoefficients coefficients from calculateDerivedCoefficients(),
+*   only read by errorFeedbackDirect and stateVariable, may be a null pointer of
+*   type const T * otherwise
+* - state: numRegisters registers, indexed with stateRegisters, all zero to reset
+*
+* The kernels produce the same output as the class with the same algorithm, sample
+* for sample, and flush results below MIN_FLOAT_VAL_POS to zero the same way.
+*/
+
+/**
+* @brief Process one sample of the selected structure
+*
+* @tparam T double or float
+* @param algorithm Structure
+* @param c Filter coefficients
+* @param d Derived coefficients, not read by the direct and transposed forms
+* @param state State registers, updated
+* @param x Input sample
+* @param underflow Set to true if the output was flushed to zero
+* @return Output sample
+*/
+template <typename T>
+inline T processBiquadSample(biquadAlgorithm algorithm, const T *c, const T *d,
+                             T *state, T x, bool &underflow) {
+    switch (algorithm) {
+        // Direct form
+        case biquadAlgorithm::direct: {
+            // y[n] = a0*x[n] + a1*x[n-1] + a2*x[n-2] - b1*y[n-1] - b2*y[n-2]
+            T y = c[a0] * x + c[a1] * state[x_z1] + c[a2] * state[x_z2] -
+                  c[b1] * state[y_z1] - c[b2] * state[y_z2];
+
+            underflow = fixUnderflow(y);
+
+            // Update state registers
+            state[x_z2] = state[x_z1];
+            state[x_z1] = x;
+
+            state[y_z2] = state[y_z1];
+            state[y_z1] = y;
+
+            // Output
+            return y;
+        }
+
+        // Canonical form, uses only two state registers
+        case biquadAlgorithm::canonical: {
+            // w[n] = x[n] - b1*w[n-1] - b2*w[n-2]
+            T w = x - c[b1] * state[x_z1] - c[b2] * state[x_z2];
+
+            // y[n] = a0*w[n] + a1*w[n-1] + a2*w[n-2]
+            T y = c[a0] * w + c[a1] * state[x_z1] + c[a2] * state[x_z2];
+
+            underflow = fixUnderflow(y);
+
+            // Update state registers
+            state[x_z2] = state[x_z1];
+            state[x_z1] = w;
+
+            // Output
+            return y;
+        }
+
+        // Transposed direct form
+        case biquadAlgorithm::transposedDirect: {
+            // w[n] =  x[n] + stateArray[y_z1]
+            T w = x + state[y_z1];
+            // y[n] = a0*w[n] + stateArray[x_z1]
+            T y = c[a0] * w + state[x_z1];
+
+            underflow = fixUnderflow(y);
+
+            // Update state registers
+            state[y_z1] = state[y_z2] - c[b1] * w;
+            state[y_z2] = -c[b2] * w;
+
+            state[x_z1] = state[x_z2] + c[a1] * w;
+            state[x_z2] = c[a2] * w;
+
+            // Output
+            return y;
+        }
+
+        // Transposed canonical form
+        case biquadAlgorithm::transposedCanonical: {
+            // y[n] = a0*x[n] + stateArray[x_z1]
+            T y = c[a0] * x + state[x_z1];
+
+            underflow = fixUnderflow(y);
+
+            // Update state registers
+            state[x_z1] = c[a1] * x - c[b1] * y + state[x_z2];
+
+            state[x_z2] = c[a2] * x - c[b2] * y;
+
+            // Output
+            return y;
+        }
+
+        // Direct form I in the difference basis with error feedback
+        case biquadAlgorithm::errorFeedbackDirect: {
+            // Differences of neighbouring samples are exact for low frequency signals
+            const T dx = x - state[x_z1];
+            const T dx1 = state[x_z1] - state[x_z2];
+            const T dy1 = state[y_z1] - state[y_z2];
+
+            // y[n] = y[n-1] + t[n], with all terms of t small for poles near z = 1:
+            // t[n] = N(z)x[n] - (1 + b1 + b2)*y[n-1] + b2*(y[n-1] - y[n-2])
+            // The rounding errors of the past outputs run through the recursion
+            const T t = d[ef_n2] * (dx - dx1) + d[ef_n1] * dx + d[ef_n0] * x -
+                        d[ef_dc] * state[y_z1] + (dy1 + d[ef_b2] * dy1) -
+                        c[b1] * state[e_z1] - c[b2] * state[e_z2];
+
+            T y = state[y_z1] + t;
+
+            // Rounding error of the last sum (two-sum, exact in IEEE arithmetic)
+            const T tRounded = y - state[y_z1];
+            const T e = (state[y_z1] - (y - tRounded)) + (t - tRounded);
+
+            underflow = fixUnderflow(y);
+
+            // Update state registers
+            state[x_z2] = state[x_z1];
+            state[x_z1] = x;
+
+            state[y_z2] = state[y_z1];
+            state[y_z1] = y;
+
+            state[e_z2] = state[e_z1];
+            state[e_z1] = e;
+
+            // Output
+            return y;
+        }
+
+        // Trapezoidal state-variable filter with output mix, x_z1 and x_z2
+        // hold the integrator states
+        case biquadAlgorithm::stateVariable: {
+            const T v3 = x - state[x_z2];
+            const T v1 = d[svf_a1] * state[x_z1] + d[svf_a2] * v3;
+            const T v2 =
+                state[x_z2] + d[svf_a2] * state[x_z1] + d[svf_a3] * v3;
+
+            // Update state registers
+            state[x_z1] = 2 * v1 - state[x_z1];
+            state[x_z2] = 2 * v2 - state[x_z2];
+
+            T y = d[svf_m0] * x + d[svf_m1] * v1 + d[svf_m2] * v2;
+
+            underflow = fixUnderflow(y);
+
+            // Output
+            return y;
+        }
+
+        default: {
+            return x;  // Did not process sample
+        }
+    }
+}
+
+/**
+* @brief Process a block of one structure, samples stride apart
+*
+* The state is copied into a local array for the block, so it can live in registers
+* while in and out may alias it otherwise. In-place processing (in == out) is fine.
+*
+* @tparam algorithm Structure, fixed at compile time
+* @tparam T double or float
+* @param c Filter coefficients
+* @param d Derived coefficients, not read by the direct and transposed forms
+* @param state State registers, updated
+* @param in Input samples
+* @param out Output samples
+* @param stride Distance between consecutive samples, 1 for contiguous blocks
+* @param numSamples Number of samples
+* @return Number of outputs flushed to zero
+*/
+template <biquadAlgorithm algorithm, typename T>
+inline int processBiquadBlock(const T *c, const T *d, T *state, const T *in,
+                              T *out, int stride, int numSamples) {
+    T registers[numRegisters];
+    std::copy(state, state + numRegisters, registers);
+
+    int numUnderflows = 0;
+    for (int n = 0; n < numSamples; ++n) {
+        bool underflow = false;
+        out[n * stride] = processBiquadSample(algorithm, c, d, registers,
+                                              in[n * stride], underflow);
+        numUnderflows += underflow;
+    }
+
+    std::copy(registers, registers + numRegisters, state);
+    return numUnderflows;
+}
+
+/**
+* @brief Process a block of the selected structure, chosen once per block
+*
+* @tparam T double or float
+* @param algorithm Structure
+* @param c Filter coefficients
+* @param d Derived coefficients, not read by the direct and transposed forms
+* @param state State registers, updated
+* @param in Input samples
+* @param out Output samples
+* @param stride Distance between consecutive samples, 1 for contiguous blocks
+* @param numSamples Number of samples
+* @return Number of outputs flushed to zero
+*/
+template <typename T>
+inline int processBiquadBlock(biquadAlgorithm algorithm, const T *c, const T *d,
+                              T *state, const T *in, T *out, int stride,
+                              int numSamples) {
+    switch (algorithm) {
+        case biquadAlgorithm::direct:
+            return processBiquadBlock<biquadAlgorithm::direct>(
+                c, d, state, in, out, stride, numSamples);
+        case biquadAlgorithm::canonical:
+            return processBiquadBlock<biquadAlgorithm::canonical>(
+                c, d, state, in, out, stride, numSamples);
+        case biquadAlgorithm::transposedDirect:
+            return processBiquadBlock<biquadAlgorithm::transposedDirect>(
+                c, d, state, in, out, stride, numSamples);
+        case biquadAlgorithm::transposedCanonical:
+            return processBiquadBlock<biquadAlgorithm::transposedCanonical>(
+                c, d, state, in, out, stride, numSamples);
+        case biquadAlgorithm::errorFeedbackDirect:
+            return processBiquadBlock<biquadAlgorithm::errorFeedbackDirect>(
+                c, d, state, in, out, stride, numSamples);
+        case biquadAlgorithm::stateVariable:
+            return processBiquadBlock<biquadAlgorithm::stateVariable>(
+                c, d, state, in, out, stride, numSamples);
+    }
+    return 0;
+}
+}  // namespace adsp
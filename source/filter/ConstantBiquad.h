@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+    ConstantBiquad.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file ConstantBiquad.h
+*
+* @brief Second-order filter with coefficients fixed at compile time
+*/
+
+#pragma once
+
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Second-order filter with coefficients fixed at compile time
+*
+* For filters whose cutoff and sample rate are known when building, e.g. DC
+* blockers or pre-filters of a fixed-rate stage. The coefficients are template
+* arguments, the compiler folds them into the instructions and leaves out the
+* terms whose coefficient is zero, so a first-order design costs two
+* multiplications and one state register update less than in Biquad. Nothing is
+* computed at runtime, not even on construction.
+*
+* The coefficients must be a constexpr BiquadCoefficients object with static
+* storage duration, usually the result of one of the constexpr designs:
+*
+*     constexpr adsp::BiquadCoefficients dcBlocker =
+*         adsp::designRcHp1(5.0, 48000.0);
+*     adsp::ConstantBiquad<dcBlocker> filter;
+*
+* Implements the transposed canonical form, the default structure of the filter
+* wrappers, and gives the same output as a Biquad set to that structure.
+*
+* @tparam coefficients Filter coefficients, indexed with filterCoefficients
+*/
+template <const BiquadCoefficients &coefficients>
+class ConstantBiquad {
+   public:
+    /**
+    * @brief Clear internal state
+    *
+    */
+    void reset() {
+        z1 = 0.0;
+        z2 = 0.0;
+    }
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    double process(double x) {
+        constexpr double c0 = coefficients[a0];
+        constexpr double c1 = coefficients[a1];
+        constexpr double c2 = coefficients[a2];
+        constexpr double d1 = coefficients[b1];
+        constexpr double d2 = coefficients[b2];
+
+        // y[n] = a0*x[n] + z1
+        double y = c0 * x + z1;
+
+        fixUnderflow(y);
+
+        // Update state registers, zero terms are left out (0 * x is not 0 for
+        // all x, the compiler can not do this by itself)
+        if constexpr (c2 != 0.0 || d2 != 0.0) {
+            z1 = c1 * x - d1 * y + z2;
+            z2 = c2 * x - d2 * y;
+        } else {
+            z1 = c1 * x - d1 * y;
+        }
+
+        // Output
+        return y;
+    }
+
+    /**
+    * @brief Process a block of samples
+    *
+    * In-place processing is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples) {
+        for (int n = 0; n < numSamples; ++n) {
+            out[n] = process(in[n]);
+        }
+    }
+
+    /**
+    * @brief Get the coefficients
+    *
+    * @return Array of coefficients
+    */
+    static const double *getCoefficients() { return coefficients.data(); }
+
+   protected:
+    /**
+    * @brief State registers of the transposed canonical form
+    */
+    double z1{0.0};
+    double z2{0.0};
+};
+}  // namespace adsp
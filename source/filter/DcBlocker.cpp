@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+    DcBlocker.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "DcBlocker.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE DcBlocker::DcBlocker() {}
+ADSP_INLINE DcBlocker::~DcBlocker() {}
+
+//==============================================================================
+
+ADSP_INLINE void DcBlocker::reset(int numChannels, double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    bank.reset(numChannels);
+
+    calculateFilterCoefficients();
+}
+
+ADSP_INLINE void DcBlocker::process(double *const *channels, int numSamples) {
+    bank.process(channels, numSamples);
+}
+
+ADSP_INLINE void DcBlocker::processInterleaved(double *inOut, int numFrames) {
+    bank.processInterleaved(inOut, numFrames);
+}
+
+//==============================================================================
+
+ADSP_INLINE void DcBlocker::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    // Calculate new coefficients
+    calculateFilterCoefficients();
+}
+
+ADSP_INLINE DcBlockerParams DcBlocker::getParameters() { return params; }
+
+ADSP_INLINE void DcBlocker::setParameters(const DcBlockerParams &parameters) {
+    // If new parameters differ..
+    if (params.fc != parameters.fc) {
+        // Update the parameters
+        params = parameters;
+
+        // Calculate coefficients with new parameters
+        calculateFilterCoefficients();
+    } else {
+        // Otherwise do nothing
+        return;
+    }
+}
+
+ADSP_INLINE double *DcBlocker::getCoefficients() {
+    return &coefficientsArray[0];
+}
+
+ADSP_INLINE void DcBlocker::calculateFilterCoefficients() {
+    // Calculate coefficients
+    const BiquadCoefficients coefficients = designRcHp1(params.fc, sampleRate);
+
+    // Update coefficient array
+    std::copy(coefficients.begin(), coefficients.end(), coefficientsArray);
+
+    bank.setCoefficients(coefficientsArray);
+}
+}  // namespace adsp
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+    DcBlocker.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file DcBlocker.h
+*
+* @brief Multichannel DC blocking filter
+*/
+
+#pragma once
+
+#include "FirstOrder.h"
+#include "RcHp1.h"
+
+namespace adsp {
+/**
+* @brief DcBlocker parameter structure
+*
+*/
+struct DcBlockerParams {
+    DcBlockerParams() {}
+
+    DcBlockerParams &operator=(const DcBlockerParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            fc = parameters.fc;
+            return *this;
+        }
+    }
+
+    // Cutoff frequency, 5 Hz costs 0.26 dB at 20 Hz
+    double fc = 5.0;  // Hz
+};
+
+//==============================================================================
+
+/**
+* @brief DC blocking filter for any number of channels
+*
+* First-order highpass of the RcHp1 design, its zero lies exactly at DC
+* (a1 = -a0), so constant offsets are removed completely. Runs on a FirstOrderBank:
+* channels are filtered side by side in groups of FIRST_ORDER_LANES, which pays off
+* from eight channels up. Nothing allocates after reset().
+*/
+class DcBlocker {
+   public:
+    DcBlocker();
+    ~DcBlocker();
+
+    //==============================================================================
+
+    /**
+    * @brief Set number of channels and sample rate, clear all state
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param numChannels Number of channels
+    * @param sampleRate New sample rate
+    */
+    void reset(int numChannels, double sampleRate);
+
+    /**
+    * @brief Process planar channels in place
+    *
+    * @param channels Array of numChannels channel buffers
+    * @param numSamples Number of samples per channel
+    */
+    void process(double *const *channels, int numSamples);
+
+    /**
+    * @brief Process interleaved channels in place
+    *
+    * @param inOut Interleaved buffer, numChannels samples per frame
+    * @param numFrames Number of frames
+    */
+    void processInterleaved(double *inOut, int numFrames);
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate, recalculate coefficients
+    *
+    * @param _sampleRate New sample rate
+    */
+    void setSampleRate(double _sampleRate);
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Filter parameters
+    */
+    DcBlockerParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * Real-time safe, the filter state is kept.
+    *
+    * @param parameters New filter parameters
+    */
+    void setParameters(const DcBlockerParams &parameters);
+
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Array of coefficients
+    */
+    double *getCoefficients();
+
+   protected:
+    /**
+    * @brief Recalculate coefficients, is called when filter parameters change
+    */
+    void calculateFilterCoefficients();
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Filter parameters
+    */
+    DcBlockerParams params;
+
+    /**
+    * @brief Filter coefficients
+    */
+    double coefficientsArray[numCoefficients] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+    /**
+    * @brief Object implementing the difference equation for all channels
+    */
+    FirstOrderBank bank;
+};
+}  // namespace adsp
@@ -0,0 +1,653 @@
+/*
+  ==============================================================================
+    FilterDesigner.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "FilterDesigner.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+typedef std::complex<double> DesignComplex;
+
+// Number of Landen transformations, enough for double precision for all moduli
+constexpr int DESIGN_LANDEN_STEPS = 7;
+
+// Poles and finite zeros of an analog prototype with cutoff 1 rad/s
+struct DesignPrototype {
+    DesignComplex poles[MAX_DESIGN_ORDER];
+    int numPoles = 0;
+
+    DesignComplex zeros[MAX_DESIGN_ORDER];
+    int numZeros = 0;
+
+    // Gain at the passband reference frequency
+    double passbandGain = 1.0;
+};
+
+//==============================================================================
+// Prototypes
+
+void designButterworth(DesignPrototype &prototype, int order) {
+    for (int k = 0; k < order; ++k) {
+        const double theta = PI * (2.0 * k + order + 1.0) / (2.0 * order);
+        prototype.poles[prototype.numPoles++] = std::polar(1.0, theta);
+    }
+}
+
+void designChebyshev1(DesignPrototype &prototype, int order, double ripple) {
+    const double epsilon = sqrt(pow(10.0, 0.1 * ripple) - 1.0);
+    const double mu = asinh(1.0 / epsilon) / order;
+
+    for (int k = 1; k <= order; ++k) {
+        const double theta = PI * (2.0 * k - 1.0) / (2.0 * order);
+        prototype.poles[prototype.numPoles++] =
+            DesignComplex(-sinh(mu) * sin(theta), cosh(mu) * cos(theta));
+    }
+
+    // Even orders start at the bottom of the ripple
+    if (order % 2 == 0) {
+        prototype.passbandGain = 1.0 / sqrt(1.0 + epsilon * epsilon);
+    }
+}
+
+// |H(jw)|^2 of an all-pole prototype with unity gain at DC
+double designAllPoleGain2(const DesignPrototype &prototype, double w) {
+    double gain2 = 1.0;
+    for (int i = 0; i < prototype.numPoles; ++i) {
+        gain2 *= std::norm(prototype.poles[i]) /
+                 std::norm(DesignComplex(0.0, w) - prototype.poles[i]);
+    }
+    return gain2;
+}
+
+void designBessel(DesignPrototype &prototype, int order) {
+    // Reverse Bessel polynomial, a[k] = (2N - k)! / (2^(N - k) k! (N - k)!), from
+    // a[N] = 1 and a[k] / a[k + 1] = (2N - k)(k + 1) / (2(N - k)).
+    // The roots are badly conditioned at high orders. Extended precision keeps them
+    // accurate up to MAX_DESIGN_ORDER on x86 with GCC and Clang; where long double
+    // equals double (e.g. MSVC) the cutoff drifts above order 24.
+    typedef std::complex<long double> BesselComplex;
+
+    long double c[MAX_DESIGN_ORDER + 1];
+    c[order] = 1.0L;
+    for (int k = order - 1; k >= 0; --k) {
+        c[k] = c[k + 1] * (2.0L * order - k) * (k + 1.0L) /
+               (2.0L * (order - k));
+    }
+
+    // Aberth-Ehrlich iteration, all roots at once. Starting points on a circle
+    // with the radius of the geometric mean of the roots, slightly rotated to
+    // avoid symmetric stalls.
+    const long double radius = powl(c[0], 1.0L / order);
+    BesselComplex roots[MAX_DESIGN_ORDER];
+    for (int i = 0; i < order; ++i) {
+        roots[i] = std::polar(radius, 2.0L * PI * (i + 0.25L) / order + 0.4L);
+    }
+
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        long double change = 0.0L;
+        for (int i = 0; i < order; ++i) {
+            // Polynomial and derivative by Horner's scheme
+            BesselComplex value = c[order];
+            BesselComplex derivative = 0.0L;
+            for (int k = order - 1; k >= 0; --k) {
+                derivative = derivative * roots[i] + value;
+                value = value * roots[i] + c[k];
+            }
+
+            BesselComplex repulsion = 0.0L;
+            for (int j = 0; j < order; ++j) {
+                if (j != i) {
+                    repulsion += 1.0L / (roots[i] - roots[j]);
+                }
+            }
+
+            const BesselComplex ratio = value / derivative;
+            const BesselComplex delta = ratio / (1.0L - ratio * repulsion);
+            roots[i] -= delta;
+            change = fmaxl(change, std::abs(delta) / std::abs(roots[i]));
+        }
+
+        if (change < 1e-18L) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < order; ++i) {
+        // Remove rounding residue from real roots
+        DesignComplex pole(static_cast<double>(roots[i].real()),
+                           static_cast<double>(roots[i].imag()));
+        if (fabs(pole.imag()) < 1e-10 * std::abs(pole)) {
+            pole.imag(0.0);
+        }
+        prototype.poles[prototype.numPoles++] = pole;
+    }
+
+    // Normalize to -3 dB at 1 rad/s, the magnitude falls monotonically
+    double low = 1e-3;
+    double high = 1e3;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        const double mid = sqrt(low * high);
+        if (designAllPoleGain2(prototype, mid) > 0.5) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    const double w3dB = sqrt(low * high);
+    for (int i = 0; i < prototype.numPoles; ++i) {
+        prototype.poles[i] /= w3dB;
+    }
+}
+
+//==============================================================================
+// Jacobian elliptic functions by Landen transformations, after
+// S. J. Orfanidis, "Lecture Notes on Elliptic Filter Design", 2006
+
+void designLanden(double k, double *v) {
+    for (int n = 0; n < DESIGN_LANDEN_STEPS; ++n) {
+        k = k / (1.0 + sqrt(1.0 - k * k));
+        k *= k;
+        v[n] = k;
+    }
+}
+
+// cd(u K, k)
+DesignComplex designCde(DesignComplex u, double k) {
+    double v[DESIGN_LANDEN_STEPS];
+    designLanden(k, v);
+
+    DesignComplex w = std::cos(u * (0.5 * PI));
+    for (int n = DESIGN_LANDEN_STEPS - 1; n >= 0; --n) {
+        w = (1.0 + v[n]) * w / (1.0 + v[n] * w * w);
+    }
+    return w;
+}
+
+// sn(u K, k)
+DesignComplex designSne(DesignComplex u, double k) {
+    double v[DESIGN_LANDEN_STEPS];
+    designLanden(k, v);
+
+    DesignComplex w = std::sin(u * (0.5 * PI));
+    for (int n = DESIGN_LANDEN_STEPS - 1; n >= 0; --n) {
+        w = (1.0 + v[n]) * w / (1.0 + v[n] * w * w);
+    }
+    return w;
+}
+
+// Complete elliptic integral of the first kind K(k)
+double designEllipk(double k) {
+    double v[DESIGN_LANDEN_STEPS];
+    designLanden(k, v);
+
+    double K = 0.5 * PI;
+    for (int n = 0; n < DESIGN_LANDEN_STEPS; ++n) {
+        K *= 1.0 + v[n];
+    }
+    return K;
+}
+
+// Symmetric remainder, x - y * round(x / y)
+double designSrem(double x, double y) { return x - y * round(x / y); }
+
+// Inverse of cd(u K, k), in units of K
+DesignComplex designAcde(DesignComplex w, double k) {
+    double v[DESIGN_LANDEN_STEPS];
+    designLanden(k, v);
+
+    for (int n = 0; n < DESIGN_LANDEN_STEPS; ++n) {
+        const double previous = n == 0 ? k : v[n - 1];
+        w = w / (1.0 + std::sqrt(1.0 - w * w * (previous * previous))) * 2.0 /
+            (1.0 + v[n]);
+    }
+
+    const DesignComplex u = std::acos(w) * (2.0 / PI);
+
+    // Reduce into the fundamental period rectangle
+    const double R = designEllipk(sqrt(1.0 - k * k)) / designEllipk(k);
+    return DesignComplex(designSrem(u.real(), 4.0),
+                         designSrem(u.imag(), 2.0 * R));
+}
+
+// Inverse of sn(u K, k), in units of K
+DesignComplex designAsne(DesignComplex w, double k) {
+    return 1.0 - designAcde(w, k);
+}
+
+// Solve the degree equation for the selectivity modulus k given N and k1
+double designEllipdeg(int order, double k1) {
+    const double kp1 = sqrt(1.0 - k1 * k1);
+
+    double kp = pow(kp1, order);
+    for (int i = 1; i <= order / 2; ++i) {
+        const double s = designSne((2.0 * i - 1.0) / order, kp1).real();
+        kp *= s * s * s * s;
+    }
+    return sqrt(1.0 - kp * kp);
+}
+
+void designElliptic(DesignPrototype &prototype, int order, double ripple,
+                    double attenuation) {
+    const double ep = sqrt(pow(10.0, 0.1 * ripple) - 1.0);
+    const double es = sqrt(pow(10.0, 0.1 * attenuation) - 1.0);
+    const double k1 = ep / es;
+    const double k = designEllipdeg(order, k1);
+
+    const DesignComplex j(0.0, 1.0);
+    const DesignComplex v0 = -j * designAsne(j / ep, k1) / static_cast<double>(order);
+
+    for (int i = 1; i <= order / 2; ++i) {
+        const double u = (2.0 * i - 1.0) / order;
+
+        // Zeros on the imaginary axis in the stopband
+        const DesignComplex zero = j / (k * designCde(u, k));
+        prototype.zeros[prototype.numZeros++] = zero;
+        prototype.zeros[prototype.numZeros++] = std::conj(zero);
+
+        DesignComplex pole = j * designCde(u - j * v0, k);
+        pole.real(-fabs(pole.real()));
+        prototype.poles[prototype.numPoles++] = pole;
+        prototype.poles[prototype.numPoles++] = std::conj(pole);
+    }
+
+    if (order % 2 == 1) {
+        const DesignComplex pole = j * designSne(j * v0, k);
+        prototype.poles[prototype.numPoles++] = -fabs(pole.real());
+    }
+
+    // Even orders start at the bottom of the ripple
+    if (order % 2 == 0) {
+        prototype.passbandGain = 1.0 / sqrt(1.0 + ep * ep);
+    }
+}
+
+//==============================================================================
+// Pairing
+
+// Root of a section, conjugate pairs are stored by their upper half-plane member
+struct DesignRoot {
+    DesignComplex value;
+    bool isPair = false;
+    bool used = false;
+};
+
+int designCollectRoots(const DesignComplex *values, int numValues,
+                       DesignRoot *roots) {
+    int numRoots = 0;
+    for (int i = 0; i < numValues; ++i) {
+        const DesignComplex value = values[i];
+        const double tolerance = 1e-9 * (1.0 + std::abs(value));
+
+        if (fabs(value.imag()) <= tolerance) {
+            roots[numRoots].value = value.real();
+            roots[numRoots].isPair = false;
+            roots[numRoots].used = false;
+            ++numRoots;
+        } else if (value.imag() > 0.0) {
+            // Conjugate is implied
+            roots[numRoots].value = value;
+            roots[numRoots].isPair = true;
+            roots[numRoots].used = false;
+            ++numRoots;
+        }
+    }
+    return numRoots;
+}
+
+// Index of the unused zero closest to target, preferring pairs or single roots
+int designNearestZero(const DesignRoot *zeros, int numZeros,
+                      DesignComplex target, bool wantPair) {
+    int best = -1;
+    double bestDistance = 0.0;
+    for (int pass = 0; pass < 2 && best < 0; ++pass) {
+        // First pass only accepts the preferred kind
+        for (int i = 0; i < numZeros; ++i) {
+            if (zeros[i].used || (pass == 0 && zeros[i].isPair != wantPair)) {
+                continue;
+            }
+            const double distance = std::abs(zeros[i].value - target);
+            if (best < 0 || distance < bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+    }
+    return best;
+}
+}  // namespace
+
+//==============================================================================
+
+ADSP_INLINE void FilterDesign::applyTo(BiquadCascade &cascade) const {
+    cascade.setNumSections(numSections);
+    for (int section = 0; section < numSections; ++section) {
+        cascade.setSection(section, sections[section]);
+    }
+}
+
+ADSP_INLINE FilterDesign designFilter(const FilterDesignParams &parameters) {
+    const int order = parameters.order < 1 ? 1
+                      : parameters.order > MAX_DESIGN_ORDER
+                          ? MAX_DESIGN_ORDER
+                          : parameters.order;
+
+    DesignPrototype prototype;
+    switch (parameters.family) {
+        case designFamily::chebyshev1: {
+            designChebyshev1(prototype, order, parameters.passbandRipple);
+            break;
+        }
+        case designFamily::bessel: {
+            designBessel(prototype, order);
+            break;
+        }
+        case designFamily::elliptic: {
+            designElliptic(prototype, order, parameters.passbandRipple,
+                           parameters.stopbandAttenuation);
+            break;
+        }
+        case designFamily::butterworth:
+        default: {
+            designButterworth(prototype, order);
+            break;
+        }
+    }
+
+    // Prewarped bilinear transformation
+    const double maxFc = 0.49 * parameters.sampleRate;
+    const double fc = parameters.fc < maxFc ? parameters.fc : maxFc;
+    const double T = 2.0 * parameters.sampleRate;
+    const double wc = T * tan(PI * fc / parameters.sampleRate);
+    const bool highpass = parameters.response == designResponse::highpass;
+
+    DesignComplex poles[MAX_DESIGN_ORDER];
+    DesignComplex zeros[MAX_DESIGN_ORDER];
+    for (int i = 0; i < prototype.numPoles; ++i) {
+        const DesignComplex s =
+            highpass ? wc / prototype.poles[i] : wc * prototype.poles[i];
+        poles[i] = (T + s) / (T - s);
+    }
+    for (int i = 0; i < prototype.numPoles; ++i) {
+        if (i < prototype.numZeros) {
+            const DesignComplex s =
+                highpass ? wc / prototype.zeros[i] : wc * prototype.zeros[i];
+            zeros[i] = (T + s) / (T - s);
+        } else {
+            // Zeros at infinity (low-pass) or DC (high-pass)
+            zeros[i] = highpass ? 1.0 : -1.0;
+        }
+    }
+
+    DesignRoot poleRoots[MAX_DESIGN_ORDER];
+    DesignRoot zeroRoots[MAX_DESIGN_ORDER];
+    const int numPoleRoots =
+        designCollectRoots(poles, prototype.numPoles, poleRoots);
+    const int numZeroRoots =
+        designCollectRoots(zeros, prototype.numPoles, zeroRoots);
+
+    // Pair poles with zeros, poles closest to the unit circle first
+    struct DesignSection {
+        double radius;
+        double coefficients[numCoefficients];
+    };
+    DesignSection sections[MAX_CASCADE_SECTIONS];
+    int numSections = 0;
+
+    while (true) {
+        // Unused pole with the largest radius
+        int pole = -1;
+        for (int i = 0; i < numPoleRoots; ++i) {
+            if (!poleRoots[i].used &&
+                (pole < 0 || std::abs(poleRoots[i].value) >
+                                 std::abs(poleRoots[pole].value))) {
+                pole = i;
+            }
+        }
+        if (pole < 0) {
+            break;
+        }
+        poleRoots[pole].used = true;
+
+        DesignSection &section = sections[numSections++];
+        section.radius = std::abs(poleRoots[pole].value);
+
+        double *c = section.coefficients;
+        const DesignComplex p = poleRoots[pole].value;
+        const DesignComplex target = p;
+
+        // Denominator and numerator as 1 + d1 z^-1 + d2 z^-2
+        double d1, d2, n1, n2;
+        if (poleRoots[pole].isPair) {
+            d1 = -2.0 * p.real();
+            d2 = std::norm(p);
+        } else {
+            // Combine two real poles into one section if available
+            int other = -1;
+            for (int i = 0; i < numPoleRoots; ++i) {
+                if (!poleRoots[i].used && !poleRoots[i].isPair &&
+                    (other < 0 || std::abs(poleRoots[i].value) >
+                                      std::abs(poleRoots[other].value))) {
+                    other = i;
+                }
+            }
+            if (other >= 0) {
+                poleRoots[other].used = true;
+                const double q = poleRoots[other].value.real();
+                d1 = -(p.real() + q);
+                d2 = p.real() * q;
+            } else {
+                d1 = -p.real();
+                d2 = 0.0;
+            }
+        }
+        const bool secondOrder = poleRoots[pole].isPair || d2 != 0.0;
+
+        // Matching zeros
+        const int zero =
+            designNearestZero(zeroRoots, numZeroRoots, target, secondOrder);
+        zeroRoots[zero].used = true;
+        const DesignComplex z = zeroRoots[zero].value;
+        if (zeroRoots[zero].isPair) {
+            n1 = -2.0 * z.real();
+            n2 = std::norm(z);
+        } else if (secondOrder) {
+            const int second =
+                designNearestZero(zeroRoots, numZeroRoots, target, false);
+            zeroRoots[second].used = true;
+            const double q = zeroRoots[second].value.real();
+            n1 = -(z.real() + q);
+            n2 = z.real() * q;
+        } else {
+            n1 = -z.real();
+            n2 = 0.0;
+        }
+
+        // Unity gain at DC (low-pass) or Nyquist (high-pass)
+        const double r = highpass ? -1.0 : 1.0;
+        const double gain = (1.0 + d1 * r + d2) / (1.0 + n1 * r + n2);
+
+        c[a0] = gain;
+        c[a1] = gain * n1;
+        c[a2] = gain * n2;
+        c[b1] = d1;
+        c[b2] = d2;
+    }
+
+    // Rising pole radius, the sharpest resonance comes last
+    for (int i = 1; i < numSections; ++i) {
+        for (int k = i; k > 0 && sections[k].radius < sections[k - 1].radius;
+             --k) {
+            const DesignSection swap = sections[k];
+            sections[k] = sections[k - 1];
+            sections[k - 1] = swap;
+        }
+    }
+
+    FilterDesign design;
+    design.numSections = numSections;
+    for (int section = 0; section < numSections; ++section) {
+        memcpy(design.sections[section], sections[section].coefficients,
+               sizeof(double) * numCoefficients);
+    }
+
+    // Passband ripple offset on the first section
+    design.sections[0][a0] *= prototype.passbandGain;
+    design.sections[0][a1] *= prototype.passbandGain;
+    design.sections[0][a2] *= prototype.passbandGain;
+
+    return design;
+}
+
+//==============================================================================
+
+ADSP_INLINE FilterDesigner::FilterDesigner() {}
+ADSP_INLINE FilterDesigner::~FilterDesigner() {}
+
+ADSP_INLINE size_t FilterDesigner::ParamsHash::operator()(
+    const FilterDesignParams &parameters) const {
+    size_t hash = std::hash<int>()(static_cast<int>(parameters.family));
+
+    // Boost-style hash combination
+    auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<int>()(static_cast<int>(parameters.response)));
+    combine(std::hash<int>()(parameters.order));
+    combine(std::hash<double>()(parameters.fc));
+    combine(std::hash<double>()(parameters.sampleRate));
+    combine(std::hash<double>()(parameters.passbandRipple));
+    combine(std::hash<double>()(parameters.stopbandAttenuation));
+    return hash;
+}
+
+ADSP_INLINE FilterDesign FilterDesigner::design(
+    const FilterDesignParams &parameters) {
+    const FilterDesignParams key = getCacheKey(parameters);
+
+    FilterDesign result;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (findCached(key, result)) {
+            return result;
+        }
+    }
+
+    // Design without the lock, other threads keep getting cached designs
+    result = designFilter(key);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ++numDesigned;
+
+    // Another thread may have added the same design in the meantime
+    FilterDesign cached;
+    if (findCached(key, cached)) {
+        return cached;
+    }
+
+    shrinkCache(maxCacheSize - 1);
+    recency.emplace_front(key, result);
+    cache.emplace(key, recency.begin());
+    return result;
+}
+
+ADSP_INLINE void FilterDesigner::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.clear();
+    recency.clear();
+    numDesigned = 0;
+}
+
+ADSP_INLINE int FilterDesigner::getCacheSize() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return static_cast<int>(cache.size());
+}
+
+ADSP_INLINE void FilterDesigner::setMaxCacheSize(int _maxCacheSize) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    maxCacheSize = std::max(_maxCacheSize, 1);
+    shrinkCache(maxCacheSize);
+}
+
+ADSP_INLINE int FilterDesigner::getMaxCacheSize() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return maxCacheSize;
+}
+
+ADSP_INLINE int FilterDesigner::getNumDesigned() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return numDesigned;
+}
+
+//==============================================================================
+
+ADSP_INLINE FilterDesignParams
+FilterDesigner::getCacheKey(const FilterDesignParams &parameters) {
+    FilterDesignParams key;
+    key = parameters;
+
+    key.order = std::min(std::max(parameters.order, 1), MAX_DESIGN_ORDER);
+
+    // Parameters the family does not use
+    if (key.family != designFamily::chebyshev1 &&
+        key.family != designFamily::elliptic) {
+        key.passbandRipple = 0.0;
+    }
+    if (key.family != designFamily::elliptic) {
+        key.stopbandAttenuation = 0.0;
+    }
+
+    return key;
+}
+
+ADSP_INLINE void FilterDesigner::shrinkCache(int size) {
+    while (static_cast<int>(cache.size()) > size) {
+        cache.erase(recency.back().first);
+        recency.pop_back();
+    }
+}
+
+ADSP_INLINE bool FilterDesigner::findCached(const FilterDesignParams &key,
+                                            FilterDesign &design) {
+    auto cached = cache.find(key);
+    if (cached == cache.end()) {
+        return false;
+    }
+
+    // Move to the front, the entry stays where it is in memory
+    recency.splice(recency.begin(), recency, cached->second);
+    design = cached->second->second;
+    return true;
+}
+}  // namespace adsp
@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+    FilterDesigner.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file FilterDesigner.h
+*
+* @brief Butterworth, Chebyshev type I, Bessel and elliptic designs of arbitrary order
+*/
+
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "BiquadCascade.h"
+
+namespace adsp {
+/**
+* @brief Highest order a design can have (one section per pole pair)
+*/
+constexpr int MAX_DESIGN_ORDER = 2 * MAX_CASCADE_SECTIONS;
+
+/**
+* @brief Default number of designs a FilterDesigner keeps
+*/
+constexpr int DESIGN_CACHE_SIZE = 256;
+
+/**
+* @brief Analog prototype of a design
+*/
+enum class designFamily { butterworth, chebyshev1, bessel, elliptic };
+
+/**
+* @brief Filter response of a design
+*/
+enum class designResponse { lowpass, highpass };
+
+/**
+* @brief Parameters of a filter design
+*
+*/
+struct FilterDesignParams {
+    FilterDesignParams() {}
+
+    FilterDesignParams &operator=(const FilterDesignParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            family = parameters.family;
+            response = parameters.response;
+            order = parameters.order;
+            fc = parameters.fc;
+            sampleRate = parameters.sampleRate;
+            passbandRipple = parameters.passbandRipple;
+            stopbandAttenuation = parameters.stopbandAttenuation;
+            return *this;
+        }
+    }
+
+    bool operator==(const FilterDesignParams &parameters) const {
+        return family == parameters.family &&
+               response == parameters.response && order == parameters.order &&
+               fc == parameters.fc && sampleRate == parameters.sampleRate &&
+               passbandRipple == parameters.passbandRipple &&
+               stopbandAttenuation == parameters.stopbandAttenuation;
+    }
+
+    // Analog prototype
+    designFamily family = designFamily::butterworth;
+
+    // Low-pass or high-pass
+    designResponse response = designResponse::lowpass;
+
+    // Filter order, 1 to MAX_DESIGN_ORDER
+    int order = 4;
+
+    // Cutoff frequency: -3 dB point for Butterworth and Bessel, passband edge for
+    // Chebyshev and elliptic
+    double fc = 1000.0;  // Hz
+
+    // Sample rate
+    double sampleRate = 48000.0;  // Hz
+
+    // Passband ripple of Chebyshev and elliptic designs
+    double passbandRipple = 1.0;  // dB
+
+    // Stopband attenuation of elliptic designs
+    double stopbandAttenuation = 60.0;  // dB
+};
+
+/**
+* @brief Result of a filter design, a cascade of second-order sections
+*
+* Stored in fixed arrays, copying a design does not allocate.
+*/
+struct FilterDesign {
+    // Number of sections, (order + 1) / 2
+    int numSections = 0;
+
+    // Normalized section coefficients (see filterCoefficients), first-order sections have a2 = b2 = 0
+    double sections[MAX_CASCADE_SECTIONS][numCoefficients] = {};
+
+    /**
+    * @brief Load the sections into a cascade
+    *
+    * @param cascade Cascade to configure, its state is kept
+    */
+    void applyTo(BiquadCascade &cascade) const;
+};
+
+/**
+* @brief Design a filter
+*
+* The analog prototype poles (and zeros) are mapped with the prewarped bilinear
+* transformation. Poles are paired with their nearest zeros, starting with the
+* poles closest to the unit circle, and the sections are ordered with rising pole
+* radius, so the sharpest resonance comes last. Every section has unity gain in
+* the passband, the passband ripple of even-order Chebyshev and elliptic designs
+* is applied to the first section.
+*
+* Allocation free, but comparably expensive for elliptic and Bessel designs.
+*
+* @param parameters Design parameters
+* @return Filter design
+*/
+FilterDesign designFilter(const FilterDesignParams &parameters);
+
+//==============================================================================
+
+/**
+* @brief Filter designer with a cache of previous designs
+*
+* Designs are looked up by the parameters their family uses (e.g. the ripple and
+* attenuation of Butterworth designs are ignored, the order is clamped as in
+* designFilter()), repeated requests (e.g. when a preset is loaded into many
+* instances) cost one hash lookup. The cache holds at most getMaxCacheSize()
+* designs, when full the least recently used design is dropped for the new one.
+* Thread safe, the cache is protected by a mutex that is not held while designing,
+* so a slow design does not hold up cache hits on other threads. Not real-time
+* safe: new designs allocate a cache entry.
+*/
+class FilterDesigner {
+   public:
+    FilterDesigner();
+    ~FilterDesigner();
+
+    //==============================================================================
+
+    /**
+    * @brief Get a design, from the cache if it was requested before
+    *
+    * @param parameters Design parameters
+    * @return Filter design
+    */
+    FilterDesign design(const FilterDesignParams &parameters);
+
+    /**
+    * @brief Remove all cached designs
+    *
+    */
+    void clearCache();
+
+    /**
+    * @brief Get number of cached designs
+    *
+    * @return Number of designs
+    */
+    int getCacheSize();
+
+    /**
+    * @brief Set the number of designs the cache holds at most, drops designs above it
+    *
+    * @param maxCacheSize Number of designs, at least 1
+    */
+    void setMaxCacheSize(int maxCacheSize);
+
+    /**
+    * @brief Get the number of designs the cache holds at most
+    *
+    * @return Number of designs
+    */
+    int getMaxCacheSize();
+
+    /**
+    * @brief Get number of designs computed since construction or clearCache()
+    *
+    * Requests answered from the cache are not counted.
+    *
+    * @return Number of computed designs
+    */
+    int getNumDesigned();
+
+   protected:
+    /**
+    * @brief Hash over all design parameters
+    */
+    struct ParamsHash {
+        size_t operator()(const FilterDesignParams &parameters) const;
+    };
+
+    /**
+    * @brief Reduce parameters to those the design depends on
+    *
+    * @param parameters Design parameters
+    * @return Cache key
+    */
+    static FilterDesignParams getCacheKey(const FilterDesignParams &parameters);
+
+    /**
+    * @brief Drop the least recently used designs until at most a number are left
+    *
+    * @param size Number of designs to keep
+    */
+    void shrinkCache(int size);
+
+    /**
+    * @brief Look up a design and mark it as most recently used, call with the mutex
+    * held
+    *
+    * @param key Cache key
+    * @param design Receives the design if it is cached
+    * @return True if the design is cached
+    */
+    bool findCached(const FilterDesignParams &key, FilterDesign &design);
+
+    using CacheList = std::list<std::pair<FilterDesignParams, FilterDesign>>;
+
+    /**
+    * @brief Cached designs, most recently used first
+    */
+    CacheList recency;
+
+    /**
+    * @brief Position of every cached design in the recency list
+    */
+    std::unordered_map<FilterDesignParams, CacheList::iterator, ParamsHash>
+        cache;
+    int maxCacheSize{DESIGN_CACHE_SIZE};
+    int numDesigned{0};
+
+    /**
+    * @brief Protects the cache
+    */
+    std::mutex cacheMutex;
+};
+}  // namespace adsp
@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+    FilterGroup.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "FilterGroup.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE FilterGroup::FilterGroup() {}
+ADSP_INLINE FilterGroup::~FilterGroup() {}
+
+//==============================================================================
+
+ADSP_INLINE void FilterGroup::add(RcLp1 &filter) {
+    addEntry(groupFilter::rcLp1, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(RcHp1 &filter) {
+    addEntry(groupFilter::rcHp1, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(SkLp2 &filter) {
+    addEntry(groupFilter::skLp2, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(SkHp2 &filter) {
+    addEntry(groupFilter::skHp2, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(Peak &filter) {
+    addEntry(groupFilter::peak, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(LowShelf &filter) {
+    addEntry(groupFilter::lowShelf, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(HighShelf &filter) {
+    addEntry(groupFilter::highShelf, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(Notch &filter) {
+    addEntry(groupFilter::notch, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(Bandpass &filter) {
+    addEntry(groupFilter::bandpass, &filter);
+}
+
+ADSP_INLINE void FilterGroup::add(Allpass &filter) {
+    addEntry(groupFilter::allpass, &filter);
+}
+
+ADSP_INLINE void FilterGroup::clear() {
+    entries.clear();
+
+    prepareSampleRates(nullptr, 0);
+}
+
+ADSP_INLINE int FilterGroup::getNumFilters() {
+    return static_cast<int>(entries.size());
+}
+
+//==============================================================================
+
+ADSP_INLINE void FilterGroup::prepareSampleRates(const double *sampleRates,
+                                                 int numRates) {
+    const int numFilters = static_cast<int>(entries.size());
+
+    preparedRates.assign(sampleRates, sampleRates + numRates);
+    preparedCoefficients.resize(numRates * numFilters * numCoefficients);
+
+    // Remember the parameters
+    preparedParameters.resize(numFilters * 3);
+    for (int i = 0; i < numFilters; ++i) {
+        getEntryParameters(i, &preparedParameters[i * 3]);
+    }
+
+    for (int rate = 0; rate < numRates; ++rate) {
+        for (int i = 0; i < numFilters; ++i) {
+            designEntry(i, sampleRates[rate],
+                        preparedCoefficients.data() +
+                            (rate * numFilters + i) * numCoefficients);
+        }
+    }
+}
+
+ADSP_INLINE int FilterGroup::getNumPreparedRates() {
+    return static_cast<int>(preparedRates.size());
+}
+
+template <typename Filter>
+inline void FilterGroup::applyCoefficients(Filter &filter) {
+    filter.biquad.setCoefficients(filter.coefficientsArray);
+}
+
+ADSP_INLINE void FilterGroup::applyCoefficients(RcLp1 &filter) {
+    filter.firstOrder.setCoefficients(filter.coefficientsArray);
+}
+
+ADSP_INLINE void FilterGroup::applyCoefficients(RcHp1 &filter) {
+    filter.firstOrder.setCoefficients(filter.coefficientsArray);
+}
+
+template <typename Filter>
+inline void FilterGroup::updateEntry(Filter &filter, int index,
+                                     double sampleRate,
+                                     const double *prepared) {
+    if (prepared != nullptr) {
+        double parameters[3];
+        getEntryParameters(index, parameters);
+
+        // Copy the prepared coefficients if they are still valid
+        if (parameters[0] == preparedParameters[index * 3] &&
+            parameters[1] == preparedParameters[index * 3 + 1] &&
+            parameters[2] == preparedParameters[index * 3 + 2]) {
+            filter.sampleRate = sampleRate;
+            memcpy(filter.coefficientsArray, &prepared[index * numCoefficients],
+                   sizeof(double) * numCoefficients);
+            applyCoefficients(filter);
+            return;
+        }
+    }
+
+    filter.setSampleRate(sampleRate);
+}
+
+ADSP_INLINE void FilterGroup::setSampleRate(double sampleRate) {
+    ADSP_REALTIME_SECTION();
+
+    const int numFilters = static_cast<int>(entries.size());
+
+    // Look for a prepared rate
+    const double *prepared = nullptr;
+    for (size_t rate = 0; rate < preparedRates.size(); ++rate) {
+        if (preparedRates[rate] == sampleRate) {
+            prepared = preparedCoefficients.data() +
+                       rate * numFilters * numCoefficients;
+            break;
+        }
+    }
+
+    for (int i = 0; i < numFilters; ++i) {
+        const Entry &entry = entries[i];
+
+        switch (entry.type) {
+            case groupFilter::rcLp1:
+                updateEntry(*static_cast<RcLp1 *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::rcHp1:
+                updateEntry(*static_cast<RcHp1 *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::skLp2:
+                updateEntry(*static_cast<SkLp2 *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::skHp2:
+                updateEntry(*static_cast<SkHp2 *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::peak:
+                updateEntry(*static_cast<Peak *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::lowShelf:
+                updateEntry(*static_cast<LowShelf *>(entry.filter), i,
+                            sampleRate, prepared);
+                break;
+            case groupFilter::highShelf:
+                updateEntry(*static_cast<HighShelf *>(entry.filter), i,
+                            sampleRate, prepared);
+                break;
+            case groupFilter::notch:
+                updateEntry(*static_cast<Notch *>(entry.filter), i, sampleRate,
+                            prepared);
+                break;
+            case groupFilter::bandpass:
+                updateEntry(*static_cast<Bandpass *>(entry.filter), i,
+                            sampleRate, prepared);
+                break;
+            case groupFilter::allpass:
+                updateEntry(*static_cast<Allpass *>(entry.filter), i,
+                            sampleRate, prepared);
+                break;
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void FilterGroup::addEntry(groupFilter type, void *filter) {
+    entries.push_back({type, filter});
+
+    // The prepared coefficients do not cover the new filter, drop them without
+    // reading the parameters of the others
+    preparedRates.clear();
+    preparedCoefficients.clear();
+    preparedParameters.clear();
+}
+
+ADSP_INLINE void FilterGroup::getEntryParameters(int index,
+                                                 double *parameters) {
+    const Entry &entry = entries[index];
+
+    parameters[0] = 0.0;
+    parameters[1] = 0.0;
+    parameters[2] = 0.0;
+
+    switch (entry.type) {
+        case groupFilter::rcLp1:
+            parameters[0] = static_cast<RcLp1 *>(entry.filter)->params.fc;
+            break;
+        case groupFilter::rcHp1:
+            parameters[0] = static_cast<RcHp1 *>(entry.filter)->params.fc;
+            break;
+        case groupFilter::skLp2:
+            parameters[0] = static_cast<SkLp2 *>(entry.filter)->params.fc;
+            break;
+        case groupFilter::skHp2:
+            parameters[0] = static_cast<SkHp2 *>(entry.filter)->params.fc;
+            break;
+        case groupFilter::peak: {
+            const PeakParams &params =
+                static_cast<Peak *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            parameters[2] = params.gain;
+            break;
+        }
+        case groupFilter::lowShelf: {
+            const LowShelfParams &params =
+                static_cast<LowShelf *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            parameters[2] = params.gain;
+            break;
+        }
+        case groupFilter::highShelf: {
+            const HighShelfParams &params =
+                static_cast<HighShelf *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            parameters[2] = params.gain;
+            break;
+        }
+        case groupFilter::notch: {
+            const NotchParams &params =
+                static_cast<Notch *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            break;
+        }
+        case groupFilter::bandpass: {
+            const BandpassParams &params =
+                static_cast<Bandpass *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            break;
+        }
+        case groupFilter::allpass: {
+            const AllpassParams &params =
+                static_cast<Allpass *>(entry.filter)->params;
+            parameters[0] = params.fc;
+            parameters[1] = params.q;
+            break;
+        }
+    }
+}
+
+ADSP_INLINE void FilterGroup::designEntry(int index, double sampleRate,
+                                          double *out) {
+    double parameters[3];
+    getEntryParameters(index, parameters);
+
+    BiquadCoefficients coefficients = {};
+    switch (entries[index].type) {
+        case groupFilter::rcLp1:
+            coefficients = designRcLp1(parameters[0], sampleRate);
+            break;
+        case groupFilter::rcHp1:
+            coefficients = designRcHp1(parameters[0], sampleRate);
+            break;
+        case groupFilter::skLp2:
+            coefficients = designSkLp2(parameters[0], sampleRate);
+            break;
+        case groupFilter::skHp2:
+            coefficients = designSkHp2(parameters[0], sampleRate);
+            break;
+        case groupFilter::peak:
+            calculateRbjCoefficients(out, rbjFilter::peak, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+        case groupFilter::lowShelf:
+            calculateRbjCoefficients(out, rbjFilter::lowShelf, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+        case groupFilter::highShelf:
+            calculateRbjCoefficients(out, rbjFilter::highShelf, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+        case groupFilter::notch:
+            calculateRbjCoefficients(out, rbjFilter::notch, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+        case groupFilter::bandpass:
+            calculateRbjCoefficients(out, rbjFilter::bandpass, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+        case groupFilter::allpass:
+            calculateRbjCoefficients(out, rbjFilter::allpass, parameters[0],
+                                     parameters[1], parameters[2], sampleRate);
+            return;
+    }
+
+    std::copy(coefficients.begin(), coefficients.end(), out);
+}
+}  // namespace adsp
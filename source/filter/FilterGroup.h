@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+    FilterGroup.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file FilterGroup.h
+*
+* @brief Sample rate changes for many filters at once
+*/
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+#include "Allpass.h"
+#include "Bandpass.h"
+#include "Biquad.h"
+#include "HighShelf.h"
+#include "LowShelf.h"
+#include "Notch.h"
+#include "Peak.h"
+#include "RbjDesign.h"
+#include "RcHp1.h"
+#include "RcLp1.h"
+#include "SkHp2.h"
+#include "SkLp2.h"
+
+namespace adsp {
+/**
+* @brief Filter types a FilterGroup updates
+*/
+enum class groupFilter {
+    rcLp1,
+    rcHp1,
+    skLp2,
+    skHp2,
+    peak,
+    lowShelf,
+    highShelf,
+    notch,
+    bandpass,
+    allpass
+};
+
+/**
+* @brief Registry that sets the sample rate of many filters in one call
+*
+* setSampleRate() updates all registered filters, with the same coefficients the
+* filters' own setSampleRate() computes. Supports RcLp1, RcHp1,
+* SkLp2, SkHp2 and the RBJ designs (Peak, LowShelf, HighShelf, Notch, Bandpass,
+* Allpass).
+*
+* Without prepared rates this costs about as much as calling setSampleRate() on
+* every filter, most of the time goes into writing the coefficients of the filter
+* objects rather than into the designs. For sample rates known in advance, prepareSampleRates()
+* stores the coefficients of every filter for each rate. Switching to a prepared
+* rate then only copies coefficients, which is several times faster for the RBJ
+* designs (see the benchmark suite). Filters whose parameters changed since
+* preparing are designed again.
+*
+* The registered filters are referenced, not copied, they must not move or be
+* destroyed while registered. setSampleRate() does not allocate, but it writes the
+* coefficients of filters that may be processing on another thread: call it from
+* the audio thread or while processing is stopped. Filter state is kept, call
+* reset() on the filters to clear it.
+*/
+class FilterGroup {
+   public:
+    FilterGroup();
+    ~FilterGroup();
+
+    //==============================================================================
+
+    /**
+    * @brief Register a filter
+    *
+    * Allocates, call from a non-realtime thread. Discards the prepared sample rates.
+    *
+    * @param filter Filter to add, must outlive the group or be removed with clear()
+    */
+    void add(RcLp1 &filter);
+    void add(RcHp1 &filter);
+    void add(SkLp2 &filter);
+    void add(SkHp2 &filter);
+    void add(Peak &filter);
+    void add(LowShelf &filter);
+    void add(HighShelf &filter);
+    void add(Notch &filter);
+    void add(Bandpass &filter);
+    void add(Allpass &filter);
+
+    /**
+    * @brief Remove all filters and prepared sample rates
+    *
+    */
+    void clear();
+
+    /**
+    * @brief Get number of registered filters
+    *
+    * @return Number of filters
+    */
+    int getNumFilters();
+
+    //==============================================================================
+
+    /**
+    * @brief Store the coefficients of all filters for a list of sample rates
+    *
+    * Allocates, call from a non-realtime thread after all filters have been added.
+    * Replaces previously prepared rates. Uses the filter parameters at the time of
+    * the call.
+    *
+    * @param sampleRates Array of sample rates
+    * @param numRates Number of sample rates
+    */
+    void prepareSampleRates(const double *sampleRates, int numRates);
+
+    /**
+    * @brief Get number of prepared sample rates
+    *
+    * @return Number of sample rates
+    */
+    int getNumPreparedRates();
+
+    /**
+    * @brief Set the sample rate of all filters and update their coefficients
+    *
+    * Real-time safe. Copies the stored coefficients if the rate has been prepared,
+    * otherwise computes them.
+    *
+    * @param sampleRate New sample rate
+    */
+    void setSampleRate(double sampleRate);
+
+   protected:
+    /**
+    * @brief A registered filter
+    */
+    struct Entry {
+        groupFilter type;
+        void *filter;
+    };
+
+    /**
+    * @brief Register a filter, discard the prepared sample rates
+    *
+    * @param type Filter type
+    * @param filter Filter object
+    */
+    void addEntry(groupFilter type, void *filter);
+
+    /**
+    * @brief Get the parameters the coefficients of a filter depend on
+    *
+    * @param index Filter index
+    * @param parameters Array of cutoff or center frequency, quality factor and gain,
+    * 0 for those the filter does not have
+    */
+    void getEntryParameters(int index, double *parameters);
+
+    /**
+    * @brief Compute the coefficients of one filter with its current parameters
+    *
+    * @param index Filter index
+    * @param sampleRate Sample rate
+    * @param out Array of numCoefficients coefficients
+    */
+    void designEntry(int index, double sampleRate, double *out);
+
+    /**
+    * @brief Set the sample rate of one filter
+    *
+    * @tparam Filter Filter type
+    * @param filter Filter object
+    * @param index Filter index
+    * @param sampleRate New sample rate
+    * @param prepared Prepared coefficients of all filters for the new rate, nullptr if
+    * there are none
+    */
+    template <typename Filter>
+    void updateEntry(Filter &filter, int index, double sampleRate,
+                     const double *prepared);
+
+    /**
+    * @brief Pass the coefficient array of a filter on to its processing stage
+    *
+    * @tparam Filter Filter type
+    * @param filter Filter object
+    */
+    template <typename Filter>
+    static void applyCoefficients(Filter &filter);
+    static void applyCoefficients(RcLp1 &filter);
+    static void applyCoefficients(RcHp1 &filter);
+
+    /**
+    * @brief Registered filters
+    */
+    std::vector<Entry> entries;
+
+    /**
+    * @brief Prepared sample rates and coefficients, one block of filters per rate
+    */
+    std::vector<double> preparedRates;
+    std::vector<double> preparedCoefficients;
+
+    /**
+    * @brief Filter parameters the prepared coefficients were computed with, three
+    * per filter as returned by getEntryParameters()
+    */
+    std::vector<double> preparedParameters;
+};
+}  // namespace adsp
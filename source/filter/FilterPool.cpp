@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+    FilterPool.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "FilterPool.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE BiquadStatePool::BiquadStatePool() {}
+ADSP_INLINE BiquadStatePool::~BiquadStatePool() { release(); }
+
+//==============================================================================
+
+ADSP_INLINE void BiquadStatePool::allocate(int _numStates) {
+    release();
+    if (_numStates <= 0) {
+        return;
+    }
+
+    states = static_cast<double *>(::operator new(
+        sizeof(double) * BIQUAD_STATE_STRIDE * _numStates,
+        std::align_val_t{FILTER_POOL_ALIGNMENT}));
+    numStates = _numStates;
+
+    reset();
+}
+
+ADSP_INLINE void BiquadStatePool::release() {
+    ::operator delete(states, std::align_val_t{FILTER_POOL_ALIGNMENT});
+    states = nullptr;
+    numStates = 0;
+}
+
+//==============================================================================
+
+ADSP_INLINE void BiquadStatePool::reset() {
+    if (states == nullptr) {
+        return;
+    }
+
+    memset(states, 0, sizeof(double) * BIQUAD_STATE_STRIDE * numStates);
+}
+
+ADSP_INLINE void BiquadStatePool::resetState(int index) {
+    memset(getState(index), 0, sizeof(double) * BIQUAD_STATE_STRIDE);
+}
+
+//==============================================================================
+
+ADSP_INLINE double *BiquadStatePool::getState(int index) {
+    return states + static_cast<size_t>(index) * BIQUAD_STATE_STRIDE;
+}
+
+ADSP_INLINE int BiquadStatePool::getNumStates() { return numStates; }
+}  // namespace adsp
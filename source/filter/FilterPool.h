@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+    FilterPool.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file FilterPool.h
+*
+* @brief Contiguous storage for many filters and filter states
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Alignment of the pool slabs and of every slot in them [bytes], one cache line
+*/
+constexpr size_t FILTER_POOL_ALIGNMENT = 64;
+
+/**
+* @brief Doubles per state in a BiquadStatePool, numRegisters padded to one cache line
+*/
+constexpr int BIQUAD_STATE_STRIDE = 8;
+
+static_assert(BIQUAD_STATE_STRIDE >= numRegisters,
+              "A biquad state must fit into its slot");
+
+//==============================================================================
+
+/**
+* @brief Many filters of one type in a single aligned slab
+*
+* For sessions with hundreds or thousands of filters, e.g. one SkLp2 per track.
+* allocate() makes one allocation for all filters instead of one per object, every
+* filter starts on a cache line of its own and neighbours are adjacent in memory,
+* so iterating over the filters of a session walks memory linearly. Each filter
+* carries its coefficients and state as usual, the filters are ordinary objects.
+*
+* The slab is only reallocated by allocate() and release(), references to the
+* filters stay valid in between. The bulk reset() functions do not allocate.
+*
+* @tparam Filter Filter wrapper, Biquad, FirstOrder or any default constructible
+* class
+*/
+template <typename Filter>
+class FilterPool {
+   public:
+    FilterPool() {}
+    ~FilterPool() { release(); }
+
+    FilterPool(const FilterPool &) = delete;
+    FilterPool &operator=(const FilterPool &) = delete;
+
+    //==============================================================================
+
+    /**
+    * @brief Construct a number of filters in one slab, replacing the previous ones
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param _numFilters Number of filters
+    */
+    void allocate(int _numFilters) {
+        release();
+        if (_numFilters <= 0) {
+            return;
+        }
+
+        slots = static_cast<Slot *>(::operator new(
+            sizeof(Slot) * static_cast<size_t>(_numFilters),
+            std::align_val_t{FILTER_POOL_ALIGNMENT}));
+        for (int i = 0; i < _numFilters; ++i) {
+            new (&slots[i]) Slot();
+        }
+        numFilters = _numFilters;
+    }
+
+    /**
+    * @brief Destroy all filters and free the slab
+    *
+    */
+    void release() {
+        for (int i = 0; i < numFilters; ++i) {
+            slots[i].~Slot();
+        }
+        ::operator delete(slots, std::align_val_t{FILTER_POOL_ALIGNMENT});
+        slots = nullptr;
+        numFilters = 0;
+    }
+
+    //==============================================================================
+
+    /**
+    * @brief Call reset() of all filters, for classes whose reset() clears the state
+    * (Biquad, FirstOrder, ...)
+    *
+    */
+    void reset() {
+        for (int i = 0; i < numFilters; ++i) {
+            slots[i].filter.reset();
+        }
+    }
+
+    /**
+    * @brief Call reset(sampleRate) of all filters, for the filter wrappers
+    *
+    * Clears the state and computes the coefficients of every filter, e.g. after
+    * loading a session.
+    *
+    * @param sampleRate Sample rate
+    */
+    void reset(double sampleRate) {
+        for (int i = 0; i < numFilters; ++i) {
+            slots[i].filter.reset(sampleRate);
+        }
+    }
+
+    //==============================================================================
+
+    /**
+    * @brief Get a filter
+    *
+    * @param index Filter index
+    * @return Filter
+    */
+    Filter &getFilter(int index) { return slots[index].filter; }
+
+    /**
+    * @brief Get number of filters
+    *
+    * @return Number of filters
+    */
+    int getNumFilters() { return numFilters; }
+
+   protected:
+    /**
+    * @brief A filter padded to whole cache lines
+    */
+    struct alignas(FILTER_POOL_ALIGNMENT) Slot {
+        Filter filter;
+    };
+
+    Slot *slots{nullptr};
+    int numFilters{0};
+};
+
+//==============================================================================
+
+/**
+* @brief States of many biquads in a single aligned slab, for the kernels of
+* BiquadKernels.h
+*
+* State i holds numRegisters values at getState(i), states are BIQUAD_STATE_STRIDE
+* doubles apart and each starts on a cache line. Coefficients are not stored, voices
+* with the same filter share one coefficient array.
+*/
+class BiquadStatePool {
+   public:
+    BiquadStatePool();
+    ~BiquadStatePool();
+
+    BiquadStatePool(const BiquadStatePool &) = delete;
+    BiquadStatePool &operator=(const BiquadStatePool &) = delete;
+
+    //==============================================================================
+
+    /**
+    * @brief Allocate a number of cleared states, replacing the previous ones
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param _numStates Number of states
+    */
+    void allocate(int _numStates);
+
+    /**
+    * @brief Free the slab
+    *
+    */
+    void release();
+
+    //==============================================================================
+
+    /**
+    * @brief Clear all states
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Clear one state, e.g. when a voice is stolen
+    *
+    * @param index State index
+    */
+    void resetState(int index);
+
+    //==============================================================================
+
+    /**
+    * @brief Get a state
+    *
+    * @param index State index
+    * @return Array of numRegisters state registers
+    */
+    double *getState(int index);
+
+    /**
+    * @brief Get number of states
+    *
+    * @return Number of states
+    */
+    int getNumStates();
+
+   protected:
+    double *states{nullptr};
+    int numStates{0};
+};
+}  // namespace adsp
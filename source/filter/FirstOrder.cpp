@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+    FirstOrder.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "FirstOrder.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE FirstOrder::FirstOrder() {}
+ADSP_INLINE FirstOrder::~FirstOrder() {}
+
+//==============================================================================
+
+ADSP_INLINE void FirstOrder::reset() { z1 = 0.0; }
+
+ADSP_INLINE double FirstOrder::process(double x) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, 1);
+
+    // y[n] = a0*x[n] + z1
+    double y = c0 * x + z1;
+
+    if (fixUnderflow(y)) {
+        ADSP_PROFILE_UNDERFLOW_FIX(profileCounters);
+    }
+
+    // Update state register
+    z1 = c1 * x - d1 * y;
+
+    // Output
+    return y;
+}
+
+ADSP_INLINE void FirstOrder::processBlock(const double *in, double *out,
+                                          int numSamples) {
+    processStrided(in, out, 1, numSamples);
+}
+
+ADSP_INLINE void FirstOrder::processStrided(const double *in, double *out,
+                                            int stride, int numSamples) {
+    ADSP_REALTIME_SECTION();
+    ADSP_PROFILE_SCOPE(profileCounters, static_cast<uint64_t>(numSamples));
+
+    // State in a local, the output may alias it otherwise
+    double z = z1;
+    for (int n = 0; n < numSamples; ++n) {
+        const double x = in[n * stride];
+        double y = c0 * x + z;
+
+        if (fixUnderflow(y)) {
+            ADSP_PROFILE_UNDERFLOW_FIX(profileCounters);
+        }
+
+        z = c1 * x - d1 * y;
+        out[n * stride] = y;
+    }
+    z1 = z;
+}
+
+//==============================================================================
+
+ADSP_INLINE void FirstOrder::setCoefficients(const double *coefficients) {
+    c0 = coefficients[a0];
+    c1 = coefficients[a1];
+    d1 = coefficients[b1];
+
+    ADSP_PROFILE_COEFFICIENT_UPDATE(profileCounters);
+}
+
+ADSP_INLINE ProfileSnapshot FirstOrder::getProfile() {
+    return ADSP_PROFILE_SNAPSHOT(profileCounters);
+}
+
+ADSP_INLINE void FirstOrder::resetProfile() {
+    ADSP_PROFILE_RESET(profileCounters);
+}
+
+//==============================================================================
+
+ADSP_INLINE FirstOrderBank::FirstOrderBank() {}
+ADSP_INLINE FirstOrderBank::~FirstOrderBank() {}
+
+//==============================================================================
+
+ADSP_INLINE void FirstOrderBank::reset(int _numChannels) {
+    numChannels = std::max(_numChannels, 0);
+    state.assign(numChannels, 0.0);
+}
+
+ADSP_INLINE void FirstOrderBank::clear() {
+    std::fill(state.begin(), state.end(), 0.0);
+}
+
+ADSP_INLINE void FirstOrderBank::process(double *const *channels,
+                                         int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    int channel = 0;
+    for (; channel + FIRST_ORDER_LANES <= numChannels;
+         channel += FIRST_ORDER_LANES) {
+        processGroup(channel, channels + channel, 1, numSamples);
+    }
+    for (; channel < numChannels; ++channel) {
+        processChannel(channel, channels[channel], 1, numSamples);
+    }
+}
+
+ADSP_INLINE void FirstOrderBank::processInterleaved(double *inOut,
+                                                    int numFrames) {
+    ADSP_REALTIME_SECTION();
+
+    int channel = 0;
+    for (; channel + FIRST_ORDER_LANES <= numChannels;
+         channel += FIRST_ORDER_LANES) {
+        double *lanes[FIRST_ORDER_LANES];
+        for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+            lanes[lane] = inOut + channel + lane;
+        }
+
+        processGroup(channel, lanes, numChannels, numFrames);
+    }
+    for (; channel < numChannels; ++channel) {
+        processChannel(channel, inOut + channel, numChannels, numFrames);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void FirstOrderBank::setCoefficients(const double *coefficients) {
+    c0 = coefficients[a0];
+    c1 = coefficients[a1];
+    d1 = coefficients[b1];
+}
+
+ADSP_INLINE int FirstOrderBank::getNumChannels() { return numChannels; }
+
+//==============================================================================
+
+ADSP_INLINE void FirstOrderBank::processGroup(int first,
+                                              double *const *lanes, int stride,
+                                              int numSamples) {
+    // Coefficients and state of the group live in locals and every loop has
+    // the fixed trip count FIRST_ORDER_LANES, so the lane loop vectorizes
+    const double k0 = c0;
+    const double k1 = c1;
+    const double l1 = d1;
+
+    double z[FIRST_ORDER_LANES];
+    for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+        z[lane] = state[first + lane];
+    }
+
+    for (int n = 0; n < numSamples; ++n) {
+        double x[FIRST_ORDER_LANES];
+        for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+            x[lane] = lanes[lane][n * stride];
+        }
+
+        double y[FIRST_ORDER_LANES];
+        for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+            y[lane] = k0 * x[lane] + z[lane];
+
+            // Flush underflow to zero, as fixUnderflow() but without a branch
+            y[lane] = fabs(y[lane]) < MIN_FLOAT_VAL_POS ? 0.0 : y[lane];
+
+            z[lane] = k1 * x[lane] - l1 * y[lane];
+        }
+
+        for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+            lanes[lane][n * stride] = y[lane];
+        }
+    }
+
+    for (int lane = 0; lane < FIRST_ORDER_LANES; ++lane) {
+        state[first + lane] = z[lane];
+    }
+}
+
+ADSP_INLINE void FirstOrderBank::processChannel(int channel, double *data,
+                                                int stride, int numSamples) {
+    double z = state[channel];
+    for (int n = 0; n < numSamples; ++n) {
+        const double x = data[n * stride];
+        double y = c0 * x + z;
+        fixUnderflow(y);
+
+        z = c1 * x - d1 * y;
+        data[n * stride] = y;
+    }
+    state[channel] = z;
+}
+}  // namespace adsp
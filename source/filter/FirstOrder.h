@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+    FirstOrder.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file FirstOrder.h
+*
+* @brief First-order filter stage, single and multichannel
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../debug/Profiler.h"
+#include "../debug/RealtimeCheck.h"
+#include "../utility/utility.h"
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Number of channels FirstOrderBank processes side by side
+*/
+constexpr int FIRST_ORDER_LANES = 8;
+
+/**
+* @brief First-order filter
+*
+* @f$ H(z) = (a_0 + a_1 z^{-1}) / (1 + b_1 z^{-1}) @f$ in transposed direct form,
+* one state register. Gives the same output as a Biquad with a2 = b2 = 0 and the
+* transposed canonical form, for two multiplications and one state update less per
+* sample.
+*/
+class FirstOrder {
+   public:
+    FirstOrder();
+    ~FirstOrder();
+
+    //==============================================================================
+
+    /**
+    * @brief Sets the state register to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    double process(double x);
+
+    /**
+    * @brief Process a block of samples
+    *
+    * In-place processing is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart
+    *
+    * In-place processing is allowed.
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set new coefficients
+    *
+    * @param coefficients Array of numCoefficients filter coefficients, a2 and b2 are
+    * ignored
+    */
+    void setCoefficients(const double *coefficients);
+
+    /**
+    * @brief Get the profiling counters (requires ADSP_ENABLE_PROFILING)
+    *
+    * Lock-free, can be called from any thread while processing.
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
+   protected:
+    /**
+    * @brief Filter coefficients a0, a1 and b1
+    */
+    double c0{0.0};
+    double c1{0.0};
+    double d1{0.0};
+
+    /**
+    * @brief State register
+    */
+    double z1{0.0};
+
+    /**
+    * @brief Profiling counters, only present with ADSP_ENABLE_PROFILING
+    */
+    ADSP_PROFILE_COUNTERS(profileCounters);
+};
+
+//==============================================================================
+
+/**
+* @brief The same first-order filter on many channels
+*
+* Channels are processed in groups of FIRST_ORDER_LANES with the state of a group in
+* local arrays, so the compiler computes several channels per instruction. The
+* channels left over by the groups run one by one, at the cost of a FirstOrder.
+* A channel costs about 65 % of a FirstOrder at eight and 45 % at 64 channels (GCC
+* -O2, SSE2), see the benchmark suite. Outputs of the groups below MIN_FLOAT_VAL_POS are
+* flushed to zero without branching. Nothing allocates after reset().
+*/
+class FirstOrderBank {
+   public:
+    FirstOrderBank();
+    ~FirstOrderBank();
+
+    //==============================================================================
+
+    /**
+    * @brief Set number of channels and clear all state
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param numChannels Number of channels
+    */
+    void reset(int numChannels);
+
+    /**
+    * @brief Clear all state
+    *
+    */
+    void clear();
+
+    /**
+    * @brief Process planar channels in place
+    *
+    * @param channels Array of numChannels channel buffers
+    * @param numSamples Number of samples per channel
+    */
+    void process(double *const *channels, int numSamples);
+
+    /**
+    * @brief Process interleaved channels in place
+    *
+    * @param inOut Interleaved buffer, numChannels samples per frame
+    * @param numFrames Number of frames
+    */
+    void processInterleaved(double *inOut, int numFrames);
+
+    //==============================================================================
+
+    /**
+    * @brief Set new coefficients for all channels
+    *
+    * @param coefficients Array of numCoefficients filter coefficients, a2 and b2 are
+    * ignored
+    */
+    void setCoefficients(const double *coefficients);
+
+    /**
+    * @brief Get number of channels
+    *
+    * @return Number of channels
+    */
+    int getNumChannels();
+
+   protected:
+    /**
+    * @brief Filter FIRST_ORDER_LANES channels side by side
+    *
+    * @param first First channel of the group
+    * @param lanes Channel pointers of the group
+    * @param stride Distance between two samples of a channel
+    * @param numSamples Number of samples per channel
+    */
+    void processGroup(int first, double *const *lanes, int stride,
+                      int numSamples);
+
+    /**
+    * @brief Filter a single channel, for the channels left over by the groups
+    *
+    * @param channel Channel index
+    * @param data First sample of the channel
+    * @param stride Distance between two samples of the channel
+    * @param numSamples Number of samples
+    */
+    void processChannel(int channel, double *data, int stride, int numSamples);
+
+    /**
+    * @brief Filter coefficients a0, a1 and b1
+    */
+    double c0{0.0};
+    double c1{0.0};
+    double d1{0.0};
+
+    /**
+    * @brief Number of channels
+    */
+    int numChannels{0};
+
+    /**
+    * @brief State register of each channel
+    */
+    std::vector<double> state;
+};
+}  // namespace adsp
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+    Notch.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "Notch.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE Notch::Notch() {}
+ADSP_INLINE Notch::~Notch() {}
+
+ADSP_INLINE void Notch::reset(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    // Setup biquad object
+
+    // Default implementation
+    BiquadParams biquadParams = biquad.getParameters();
+    biquadParams.calculationType = biquadAlgorithm::transposedCanonical;
+    biquad.setParameters(biquadParams);
+
+    // Clear biquad state array
+    biquad.reset();
+
+    // Calculate coefficients for the new sample rate
+    calculateFilterCoefficients();
+}
+
+ADSP_INLINE double Notch::process(double x) { return biquad.process(x); }
+
+ADSP_INLINE void Notch::processBlock(const double *in, double *out,
+                                     int numSamples) {
+    biquad.processBlock(in, out, numSamples);
+}
+
+ADSP_INLINE void Notch::processStrided(const double *in, double *out,
+                                       int stride, int numSamples) {
+    biquad.processStrided(in, out, stride, numSamples);
+}
+
+//==============================================================================
+
+ADSP_INLINE void Notch::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    // Calculate new coefficients
+    calculateFilterCoefficients();
+}
+
+ADSP_INLINE NotchParams Notch::getParameters() { return params; }
+
+ADSP_INLINE void Notch::setParameters(const NotchParams &parameters) {
+    // If new parameters differ..
+    if (params.fc != parameters.fc || params.q != parameters.q) {
+        // Update the parameters
+        params = parameters;
+
+        // Calculate coefficients with new parameters
+        calculateFilterCoefficients();
+    } else {
+        // Otherwise do nothing
+        return;
+    }
+}
+
+ADSP_INLINE double *Notch::getCoefficients() { return &coefficientsArray[0]; }
+
+ADSP_INLINE ProfileSnapshot Notch::getProfile() { return biquad.getProfile(); }
+
+ADSP_INLINE void Notch::resetProfile() { biquad.resetProfile(); }
+
+ADSP_INLINE void Notch::calculateFilterCoefficients() {
+    calculateRbjCoefficients(coefficientsArray, rbjFilter::notch, params.fc,
+                             params.q, 0.0, sampleRate);
+
+    biquad.setCoefficients(coefficientsArray);
+}
+}  // namespace adsp
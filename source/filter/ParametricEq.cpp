@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+    ParametricEq.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "ParametricEq.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE ParametricEq::ParametricEq() {}
+ADSP_INLINE ParametricEq::~ParametricEq() {}
+
+ADSP_INLINE void ParametricEq::reset(double _sampleRate, int _numBands) {
+    sampleRate = _sampleRate;
+    numBands = _numBands < MAX_EQ_BANDS ? _numBands : MAX_EQ_BANDS;
+
+    cascade.setNumSections(numBands);
+    cascade.reset();
+
+    for (int band = 0; band < numBands; ++band) {
+        calculateBandCoefficients(band);
+    }
+}
+
+ADSP_INLINE double ParametricEq::process(double x) {
+    return cascade.process(x);
+}
+
+ADSP_INLINE void ParametricEq::processBlock(const double *in, double *out,
+                                            int numSamples) {
+    cascade.processBlock(in, out, numSamples);
+}
+
+ADSP_INLINE void ParametricEq::processStrided(const double *in, double *out,
+                                              int stride, int numSamples) {
+    cascade.processStrided(in, out, stride, numSamples);
+}
+
+//==============================================================================
+
+ADSP_INLINE void ParametricEq::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    for (int band = 0; band < numBands; ++band) {
+        calculateBandCoefficients(band);
+    }
+}
+
+ADSP_INLINE EqBandParams ParametricEq::getBand(int band) { return bands[band]; }
+
+ADSP_INLINE void ParametricEq::setBand(int band,
+                                       const EqBandParams &parameters) {
+    const EqBandParams &current = bands[band];
+
+    // If new parameters differ..
+    if (current.enabled != parameters.enabled ||
+        current.type != parameters.type || current.fc != parameters.fc ||
+        current.q != parameters.q || current.gain != parameters.gain) {
+        // Update the parameters
+        bands[band] = parameters;
+
+        // Calculate coefficients of this band only
+        calculateBandCoefficients(band);
+    } else {
+        // Otherwise do nothing
+        return;
+    }
+}
+
+ADSP_INLINE int ParametricEq::getNumBands() { return numBands; }
+
+ADSP_INLINE BiquadCascade &ParametricEq::getCascade() { return cascade; }
+
+ADSP_INLINE void ParametricEq::calculateBandCoefficients(int band) {
+    double coefficients[numCoefficients] = {1.0, 0.0, 0.0, 0.0, 0.0};
+
+    const EqBandParams &parameters = bands[band];
+    if (parameters.enabled) {
+        calculateRbjCoefficients(coefficients, parameters.type, parameters.fc,
+                                 parameters.q, parameters.gain, sampleRate);
+    }
+
+    cascade.setSection(band, coefficients);
+}
+}  // namespace adsp
@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+    ParametricEq.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file ParametricEq.h
+*
+* @brief Multi-band parametric equalizer
+*/
+
+#pragma once
+
+#include "BiquadCascade.h"
+#include "RbjDesign.h"
+
+namespace adsp {
+/**
+* @brief Maximum number of bands of the ParametricEq
+*/
+constexpr int MAX_EQ_BANDS = MAX_CASCADE_SECTIONS;
+
+/**
+* @brief Parameters of one equalizer band
+*
+*/
+struct EqBandParams {
+    EqBandParams() {}
+
+    EqBandParams &operator=(const EqBandParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            enabled = parameters.enabled;
+            type = parameters.type;
+            fc = parameters.fc;
+            q = parameters.q;
+            gain = parameters.gain;
+            return *this;
+        }
+    }
+
+    // Disabled bands pass the signal unchanged
+    bool enabled = false;
+
+    // Filter response of the band
+    rbjFilter type = rbjFilter::peak;
+
+    // Center or corner frequency
+    double fc = 1000.0;  // Hz
+
+    // Quality factor
+    double q = 0.70710678118654752440;
+
+    // Gain of peak and shelf bands
+    double gain = 0.0;  // dB
+};
+
+/**
+* @brief Parametric equalizer with up to MAX_EQ_BANDS bands of RBJ cookbook designs
+*
+* All bands run as one fused BiquadCascade. Changing a band only recalculates its own
+* section, using the fast approximations of the design helper.
+*/
+class ParametricEq {
+   public:
+    ParametricEq();
+    ~ParametricEq();
+
+    //==============================================================================
+
+    /**
+    * @brief Clear internal state, set sample rate and number of bands
+    *
+    * @param sampleRate New sample rate
+    * @param numBands Number of bands, at most MAX_EQ_BANDS
+    */
+    void reset(double sampleRate, int numBands);
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Output sample
+    */
+    double process(double x);
+
+    /**
+    * @brief Process a block
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart, e.g. one channel of an
+    * interleaved buffer in place
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate, recalculate all bands
+    *
+    * @param sampleRate New sample rate
+    */
+    void setSampleRate(double sampleRate);
+
+    /**
+    * @brief Get parameters of one band
+    *
+    * @param band Band index
+    * @return Band parameters
+    */
+    EqBandParams getBand(int band);
+
+    /**
+    * @brief Set parameters of one band, recalculates only this band
+    *
+    * @param band Band index
+    * @param parameters New band parameters
+    */
+    void setBand(int band, const EqBandParams &parameters);
+
+    /**
+    * @brief Get number of bands
+    *
+    * @return Number of bands
+    */
+    int getNumBands();
+
+    /**
+    * @brief Get the cascade of all bands, e.g. to evaluate its sections with FrequencyResponse
+    *
+    * @return Cascade with one section per band
+    */
+    BiquadCascade &getCascade();
+
+   protected:
+    /**
+    * @brief Recalculate the section of one band
+    */
+    void calculateBandCoefficients(int band);
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Number of bands
+    */
+    int numBands{0};
+
+    /**
+    * @brief Band parameters
+    */
+    EqBandParams bands[MAX_EQ_BANDS];
+
+    /**
+    * @brief One section per band
+    */
+    BiquadCascade cascade;
+};
+}  // namespace adsp
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+    RbjDesign.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "RbjDesign.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE void calculateRbjCoefficients(double *coefficients, rbjFilter type,
+                                          double fc, double q, double gain,
+                                          double sampleRate) {
+    // Keep the design away from Nyquist where the cookbook formulas degenerate
+    const double maxFc = 0.49 * sampleRate;
+    fc = fc < maxFc ? fc : maxFc;
+
+    const double w0 = TWO_PI * fc / sampleRate;
+
+    // At low frequencies the poles depend on 1 - cos(w0), which fastCos() would
+    // only give to its absolute error. 1 - cos(w0) = 2 * sin(w0 / 2)^2 keeps the
+    // relative error of fastSin() for small angles.
+    const double sinHalfW0 = fastSin(0.5 * w0);
+    const double cosW0 = 1.0 - 2.0 * sinHalfW0 * sinHalfW0;
+    const double alpha = fastSin(w0) / (2.0 * q);
+
+    // Amplitude A = 10^(gain / 40) and its square root
+    const double A = fastDbToRawGain(0.5 * gain);
+    const double sqrtA = fastDbToRawGain(0.25 * gain);
+
+    // Unnormalized numerator (n) and denominator (d)
+    double n0 = 1.0, n1 = 0.0, n2 = 0.0;
+    double d0 = 1.0, d1 = 0.0, d2 = 0.0;
+
+    switch (type) {
+        case rbjFilter::peak: {
+            n0 = 1.0 + alpha * A;
+            n1 = -2.0 * cosW0;
+            n2 = 1.0 - alpha * A;
+            d0 = 1.0 + alpha / A;
+            d1 = -2.0 * cosW0;
+            d2 = 1.0 - alpha / A;
+            break;
+        }
+        case rbjFilter::lowShelf: {
+            const double beta = 2.0 * sqrtA * alpha;
+            n0 = A * ((A + 1.0) - (A - 1.0) * cosW0 + beta);
+            n1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosW0);
+            n2 = A * ((A + 1.0) - (A - 1.0) * cosW0 - beta);
+            d0 = (A + 1.0) + (A - 1.0) * cosW0 + beta;
+            d1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosW0);
+            d2 = (A + 1.0) + (A - 1.0) * cosW0 - beta;
+            break;
+        }
+        case rbjFilter::highShelf: {
+            const double beta = 2.0 * sqrtA * alpha;
+            n0 = A * ((A + 1.0) + (A - 1.0) * cosW0 + beta);
+            n1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosW0);
+            n2 = A * ((A + 1.0) + (A - 1.0) * cosW0 - beta);
+            d0 = (A + 1.0) - (A - 1.0) * cosW0 + beta;
+            d1 = 2.0 * ((A - 1.0) - (A + 1.0) * cosW0);
+            d2 = (A + 1.0) - (A - 1.0) * cosW0 - beta;
+            break;
+        }
+        case rbjFilter::notch: {
+            n0 = 1.0;
+            n1 = -2.0 * cosW0;
+            n2 = 1.0;
+            d0 = 1.0 + alpha;
+            d1 = -2.0 * cosW0;
+            d2 = 1.0 - alpha;
+            break;
+        }
+        case rbjFilter::bandpass: {
+            n0 = alpha;
+            n1 = 0.0;
+            n2 = -alpha;
+            d0 = 1.0 + alpha;
+            d1 = -2.0 * cosW0;
+            d2 = 1.0 - alpha;
+            break;
+        }
+        case rbjFilter::allpass: {
+            n0 = 1.0 - alpha;
+            n1 = -2.0 * cosW0;
+            n2 = 1.0 + alpha;
+            d0 = 1.0 + alpha;
+            d1 = -2.0 * cosW0;
+            d2 = 1.0 - alpha;
+            break;
+        }
+    }
+
+    // Normalize to d0 = 1
+    const double norm = 1.0 / d0;
+    coefficients[a0] = n0 * norm;
+    coefficients[a1] = n1 * norm;
+    coefficients[a2] = n2 * norm;
+    coefficients[b1] = d1 * norm;
+    coefficients[b2] = d2 * norm;
+}
+}  // namespace adsp
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+    RbjDesign.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file RbjDesign.h
+*
+* @brief Second-order designs from the RBJ Audio EQ Cookbook
+*/
+
+#pragma once
+
+#include "Biquad.h"
+
+namespace adsp {
+/**
+* @brief Filter responses of the RBJ cookbook
+*/
+enum class rbjFilter { peak, lowShelf, highShelf, notch, bandpass, allpass };
+
+/**
+* @brief Calculate normalized biquad coefficients of an RBJ cookbook design
+*
+* Uses fastSin() and fastExp2() instead of the standard library functions, the
+* coefficients deviate less than 1e-7 from the exact design. cos(w0) is derived from
+* sin(w0 / 2), so that center and corner frequencies stay exact down to
+* MIN_FILTER_FREQ at high sample rates, where the poles are close to z = 1.
+* Bandpass has 0 dB peak gain, the gain parameter is only used by peak and shelves.
+*
+* @param coefficients Array of numCoefficients filter coefficients, written
+* @param type Filter response
+* @param fc Center or corner frequency, clamped below Nyquist [Hz]
+* @param q Quality factor (bandwidth for peak, notch and bandpass, slope for shelves)
+* @param gain Gain of peak and shelves [dB]
+* @param sampleRate Sample rate [Hz]
+*/
+void calculateRbjCoefficients(double *coefficients, rbjFilter type, double fc,
+                              double q, double gain, double sampleRate);
+}  // namespace adsp
@@ -33,39 +33,46 @@
 */
 
 #include "RcHp1.h"
+#include "../utility/inline.h"
 
 namespace adsp {
-RcHp1::RcHp1() {}
-RcHp1::~RcHp1() {}
+ADSP_INLINE RcHp1::RcHp1() {}
+ADSP_INLINE RcHp1::~RcHp1() {}
 
-void RcHp1::reset(double sampleRate) {
-    sampleRate = sampleRate;
+ADSP_INLINE void RcHp1::reset(double _sampleRate) {
+    sampleRate = _sampleRate;
 
-    // Setup biquad object
+    // Clear state register
+    firstOrder.reset();
 
-    // Default implementation
-    BiquadParams biquadParams = biquad.getParameters();
-    biquadParams.calculationType = biquadAlgorithm::transposedCanonical;
-    biquad.setParameters(biquadParams);
+    // Calculate coefficients for the new sample rate
+    calculateFilterCoefficients();
+}
 
-    // Clear biquad state array
-    biquad.reset();
+ADSP_INLINE double RcHp1::process(double x) { return firstOrder.process(x); }
+
+ADSP_INLINE void RcHp1::processBlock(const double *in, double *out,
+                                     int numSamples) {
+    firstOrder.processBlock(in, out, numSamples);
 }
 
-double RcHp1::process(double x) { return biquad.process(x); }
+ADSP_INLINE void RcHp1::processStrided(const double *in, double *out,
+                                       int stride, int numSamples) {
+    firstOrder.processStrided(in, out, stride, numSamples);
+}
 
 //==============================================================================
 
-void RcHp1::setSampleRate(double sampleRate) {
-    sampleRate = sampleRate;
+ADSP_INLINE void RcHp1::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
 
     // Calculate new coefficients
     calculateFilterCoefficients();
 }
 
-RcHp1Params RcHp1::getParameters() { return params; }
+ADSP_INLINE RcHp1Params RcHp1::getParameters() { return params; }
 
-void RcHp1::setParameters(const RcHp1Params &parameters) {
+ADSP_INLINE void RcHp1::setParameters(const RcHp1Params &parameters) {
     // If new parameters differ..
     if (params.fc != parameters.fc) {
         // Update the parameters
@@ -79,21 +86,21 @@ void RcHp1::setParameters(const RcHp1Params &parameters) {
     }
 }
 
-void RcHp1::calculateFilterCoefficients() {
-    // Clear coefficient array
-    memset(&coefficientsArray[0], 0, sizeof(double) * numCoefficients);
+ADSP_INLINE double *RcHp1::getCoefficients() { return &coefficientsArray[0]; }
+
+ADSP_INLINE ProfileSnapshot RcHp1::getProfile() {
+    return firstOrder.getProfile();
+}
+
+ADSP_INLINE void RcHp1::resetProfile() { firstOrder.resetProfile(); }
 
+ADSP_INLINE void RcHp1::calculateFilterCoefficients() {
     // Calculate coefficients
-    const double w0 = 2.0 * PI * params.fc;
-    const double gamma = 1.0 / sampleRate * w0;
+    const BiquadCoefficients coefficients = designRcHp1(params.fc, sampleRate);
 
     // Update coefficient array
-    coefficientsArray[a0] = 2.0 / (gamma + 2.0);
-    coefficientsArray[a1] = -2.0 / (gamma + 2.0);
-    coefficientsArray[a2] = 0.0;
-    coefficientsArray[b1] = (gamma - 2.0) / (gamma + 2.0);
-    coefficientsArray[b2] = 0.0;
+    std::copy(coefficients.begin(), coefficients.end(), coefficientsArray);
 
-    biquad.setCoefficients(coefficientsArray);
+    firstOrder.setCoefficients(coefficientsArray);
 }
 }  // namespace adsp
\ No newline at end of file
@@ -41,8 +41,27 @@
 #pragma once
 
 #include "Biquad.h"
+#include "FirstOrder.h"
 
 namespace adsp {
+/**
+* @brief Calculate the coefficients of the first-order RC high-pass filter
+*
+* Can be evaluated at compile time, e.g. for ConstantBiquad.
+*
+* @param fc Cutoff frequency [Hz]
+* @param sampleRate Sample rate [Hz]
+* @return Filter coefficients
+*/
+constexpr BiquadCoefficients designRcHp1(double fc, double sampleRate) {
+    // Calculate coefficients
+    const double w0 = 2.0 * PI * fc;
+    const double gamma = 1.0 / sampleRate * w0;
+
+    return {2.0 / (gamma + 2.0), -2.0 / (gamma + 2.0), 0.0,
+            (gamma - 2.0) / (gamma + 2.0), 0.0};
+}
+
 /**
 * @brief RcHp1 parameter structure
 * 
@@ -69,6 +88,8 @@ struct RcHp1Params {
 * Analog modeled by means of a prewarped bilinear transformation.  
 * Prewarping was chosen to match cutoff frequencies.  
 * This filter has not been decramped.  
+* Runs on a FirstOrder stage, the coefficient array keeps the layout of the
+* second-order filters with a2 = b2 = 0.
 */
 class RcHp1 {
    public:
@@ -92,6 +113,27 @@ class RcHp1 {
     */
     double process(double x);
 
+    /**
+    * @brief Process a block, in place if in == out
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart, e.g. one channel of an
+    * interleaved buffer in place
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
     //==============================================================================
 
     /**
@@ -115,7 +157,33 @@ class RcHp1 {
      */
     void setParameters(const RcHp1Params &parameters);
 
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Array of coefficients
+    */
+    double *getCoefficients();
+
+    /**
+    * @brief Get the profiling counters of the filter (requires ADSP_ENABLE_PROFILING)
+    *
+    * Coefficient updates count the coefficient recalculations.
+    * Lock-free, can be called from any thread while processing.
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
    protected:
+    // Sets sample rate and coefficients of many filters at once
+    friend class FilterGroup;
+
     /**
     * @brief Sample rate
     */
@@ -124,7 +192,7 @@ class RcHp1 {
     /**
     * @brief  Object implementing the difference equation
     */
-    Biquad biquad;
+    FirstOrder firstOrder;
 
     /**
     * @brief Filter coefficients
@@ -33,13 +33,14 @@
 */
 
 #include "SkLp2.h"
+#include "../utility/inline.h"
 
 namespace adsp {
-SkLp2::SkLp2() {}
-SkLp2::~SkLp2() {}
+ADSP_INLINE SkLp2::SkLp2() {}
+ADSP_INLINE SkLp2::~SkLp2() {}
 
-void SkLp2::reset(double sampleRate) {
-    sampleRate = sampleRate;
+ADSP_INLINE void SkLp2::reset(double _sampleRate) {
+    sampleRate = _sampleRate;
 
     // Setup biquad object
 
@@ -50,22 +51,35 @@ void SkLp2::reset(double sampleRate) {
 
     // Clear biquad state array
     biquad.reset();
+
+    // Calculate coefficients for the new sample rate
+    calculateFilterCoefficients();
+}
+
+ADSP_INLINE double SkLp2::process(double x) { return biquad.process(x); }
+
+ADSP_INLINE void SkLp2::processBlock(const double *in, double *out,
+                                     int numSamples) {
+    biquad.processBlock(in, out, numSamples);
 }
 
-double SkLp2::process(double x) { return biquad.process(x); }
+ADSP_INLINE void SkLp2::processStrided(const double *in, double *out,
+                                       int stride, int numSamples) {
+    biquad.processStrided(in, out, stride, numSamples);
+}
 
 //==============================================================================
 
-void SkLp2::setSampleRate(double sampleRate) {
-    sampleRate = sampleRate;
+ADSP_INLINE void SkLp2::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
 
     // Calculate new coefficients
     calculateFilterCoefficients();
 }
 
-SkLp2Params SkLp2::getParameters() { return params; }
+ADSP_INLINE SkLp2Params SkLp2::getParameters() { return params; }
 
-void SkLp2::setParameters(const SkLp2Params &parameters) {
+ADSP_INLINE void SkLp2::setParameters(const SkLp2Params &parameters) {
     // If new parameters differ..
     if (params.fc != parameters.fc) {
         // Update the parameters
@@ -79,25 +93,18 @@ void SkLp2::setParameters(const SkLp2Params &parameters) {
     }
 }
 
-void SkLp2::calculateFilterCoefficients() {
-    // Clear coefficient array
-    memset(&coefficientsArray[0], 0, sizeof(double) * numCoefficients);
+ADSP_INLINE double *SkLp2::getCoefficients() { return &coefficientsArray[0]; }
 
-    // Calculate coefficients
-    const double w0 = 2.0 * PI * params.fc;
+ADSP_INLINE ProfileSnapshot SkLp2::getProfile() { return biquad.getProfile(); }
 
-    const double alpha = 1.0 / sampleRate * w0;
-    const double alpha2 = alpha * alpha;
+ADSP_INLINE void SkLp2::resetProfile() { biquad.resetProfile(); }
 
-    const double muDen = alpha2 + 4.0 * alpha + 4.0;
-    const double mu = alpha2 / muDen;
+ADSP_INLINE void SkLp2::calculateFilterCoefficients() {
+    // Calculate coefficients
+    const BiquadCoefficients coefficients = designSkLp2(params.fc, sampleRate);
 
     // Update coefficient array
-    coefficientsArray[a0] = mu;
-    coefficientsArray[a1] = 2.0 * mu;
-    coefficientsArray[a2] = mu;
-    coefficientsArray[b1] = (2.0 * alpha - 4.0) / (alpha + 2.0);
-    coefficientsArray[b2] = (alpha2 - 4.0 * alpha + 4.0) / muDen;
+    std::copy(coefficients.begin(), coefficients.end(), coefficientsArray);
 
     biquad.setCoefficients(coefficientsArray);
 }
@@ -43,6 +43,29 @@
 #include "Biquad.h"
 
 namespace adsp {
+/**
+* @brief Calculate the coefficients of the Sallen-Key low-pass filter
+*
+* Can be evaluated at compile time, e.g. for ConstantBiquad.
+*
+* @param fc Cutoff frequency [Hz]
+* @param sampleRate Sample rate [Hz]
+* @return Filter coefficients
+*/
+constexpr BiquadCoefficients designSkLp2(double fc, double sampleRate) {
+    // Calculate coefficients
+    const double w0 = 2.0 * PI * fc;
+
+    const double alpha = 1.0 / sampleRate * w0;
+    const double alpha2 = alpha * alpha;
+
+    const double muDen = alpha2 + 4.0 * alpha + 4.0;
+    const double mu = alpha2 / muDen;
+
+    return {mu, 2.0 * mu, mu, (2.0 * alpha - 4.0) / (alpha + 2.0),
+            (alpha2 - 4.0 * alpha + 4.0) / muDen};
+}
+
 /**
 * @brief SkLp2 parameter structure
 * 
@@ -92,6 +115,27 @@ class SkLp2 {
     */
     double process(double x);
 
+    /**
+    * @brief Process a block, in place if in == out
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block of samples that lie stride apart, e.g. one channel of an
+    * interleaved buffer in place
+    *
+    * @param in First input sample
+    * @param out First output sample
+    * @param stride Distance between two samples of in and of out
+    * @param numSamples Number of samples
+    */
+    void processStrided(const double *in, double *out, int stride,
+                        int numSamples);
+
     //==============================================================================
 
     /**
@@ -115,7 +159,33 @@ class SkLp2 {
      */
     void setParameters(const SkLp2Params &parameters);
 
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Array of coefficients
+    */
+    double *getCoefficients();
+
+    /**
+    * @brief Get the profiling counters of the filter (requires ADSP_ENABLE_PROFILING)
+    *
+    * Coefficient updates count the coefficient recalculations.
+    * Lock-free, can be called from any thread while processing.
+    *
+    * @return Counter snapshot, empty if profiling is disabled
+    */
+    ProfileSnapshot getProfile();
+
+    /**
+    * @brief Reset the profiling counters
+    *
+    */
+    void resetProfile();
+
    protected:
+    // Sets sample rate and coefficients of many filters at once
+    friend class FilterGroup;
+
     /**
     * @brief Sample rate
     */
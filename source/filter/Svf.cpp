@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+    Svf.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "Svf.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE SvfCoefficients calculateSvfCoefficients(double fc, double q,
+                                                     double sampleRate) {
+    // Keep the prewarped cutoff finite
+    const double maxFc = 0.49 * sampleRate;
+    fc = fc < maxFc ? fc : maxFc;
+
+    SvfCoefficients c;
+    c.g = tan(PI * fc / sampleRate);
+    c.k = 1.0 / q;
+    c.a1 = 1.0 / (1.0 + c.g * (c.g + c.k));
+    c.a2 = c.g * c.a1;
+    c.a3 = c.g * c.a2;
+    return c;
+}
+
+//==============================================================================
+
+ADSP_INLINE Svf::Svf() {
+    coefficients = calculateSvfCoefficients(params.fc, params.q, sampleRate);
+}
+
+ADSP_INLINE Svf::~Svf() {}
+
+ADSP_INLINE void Svf::reset(double _sampleRate) {
+    sampleRate = _sampleRate;
+    coefficients = calculateSvfCoefficients(params.fc, params.q, sampleRate);
+
+    ic1 = 0.0;
+    ic2 = 0.0;
+}
+
+ADSP_INLINE double Svf::process(double x) {
+    ADSP_REALTIME_SECTION();
+
+    const SvfOutputs outputs = tickSvf(coefficients, ic1, ic2, x);
+
+    fixUnderflow(ic1);
+    fixUnderflow(ic2);
+
+    return selectOutput(outputs);
+}
+
+ADSP_INLINE SvfOutputs Svf::processAll(double x) {
+    ADSP_REALTIME_SECTION();
+
+    const SvfOutputs outputs = tickSvf(coefficients, ic1, ic2, x);
+
+    fixUnderflow(ic1);
+    fixUnderflow(ic2);
+
+    return outputs;
+}
+
+ADSP_INLINE void Svf::processBlock(const double *in, double *out,
+                                   int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        out[n] = selectOutput(tickSvf(coefficients, ic1, ic2, in[n]));
+    }
+
+    // Flushing once per block is enough to keep the states out of the denormal range
+    fixUnderflow(ic1);
+    fixUnderflow(ic2);
+}
+
+ADSP_INLINE void Svf::processBlockModulated(const double *in, double *out,
+                                            const double *fc, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        setCutoff(fc[n]);
+        out[n] = selectOutput(tickSvf(coefficients, ic1, ic2, in[n]));
+    }
+
+    fixUnderflow(ic1);
+    fixUnderflow(ic2);
+}
+
+ADSP_INLINE void Svf::processBlockAll(const double *in, double *lowpass,
+                                      double *bandpass, double *highpass,
+                                      double *notch, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        const SvfOutputs outputs = tickSvf(coefficients, ic1, ic2, in[n]);
+
+        if (lowpass != nullptr) {
+            lowpass[n] = outputs.lowpass;
+        }
+        if (bandpass != nullptr) {
+            bandpass[n] = outputs.bandpass;
+        }
+        if (highpass != nullptr) {
+            highpass[n] = outputs.highpass;
+        }
+        if (notch != nullptr) {
+            notch[n] = outputs.notch;
+        }
+    }
+
+    fixUnderflow(ic1);
+    fixUnderflow(ic2);
+}
+
+//==============================================================================
+
+ADSP_INLINE void Svf::setSampleRate(double _sampleRate) {
+    sampleRate = _sampleRate;
+
+    // Calculate new coefficients
+    coefficients = calculateSvfCoefficients(params.fc, params.q, sampleRate);
+}
+
+ADSP_INLINE void Svf::setCutoff(double fc) {
+    params.fc = fc;
+
+    // Only g and the values derived from it change
+    const double maxFc = 0.49 * sampleRate;
+    coefficients.g = tan(PI * (fc < maxFc ? fc : maxFc) / sampleRate);
+    coefficients.a1 =
+        1.0 / (1.0 + coefficients.g * (coefficients.g + coefficients.k));
+    coefficients.a2 = coefficients.g * coefficients.a1;
+    coefficients.a3 = coefficients.g * coefficients.a2;
+}
+
+ADSP_INLINE SvfParams Svf::getParameters() { return params; }
+
+ADSP_INLINE void Svf::setParameters(const SvfParams &parameters) {
+    // If new parameters differ..
+    if (params.fc != parameters.fc || params.q != parameters.q) {
+        // Update the parameters
+        params = parameters;
+
+        // Calculate coefficients with new parameters
+        coefficients =
+            calculateSvfCoefficients(params.fc, params.q, sampleRate);
+    } else {
+        // Output selection needs no recalculation
+        params.output = parameters.output;
+    }
+}
+
+ADSP_INLINE SvfCoefficients Svf::getCoefficients() { return coefficients; }
+
+ADSP_INLINE double Svf::selectOutput(const SvfOutputs &outputs) {
+    switch (params.output) {
+        case svfOutput::bandpass: {
+            return outputs.bandpass;
+        }
+        case svfOutput::highpass: {
+            return outputs.highpass;
+        }
+        case svfOutput::notch: {
+            return outputs.notch;
+        }
+        case svfOutput::lowpass:
+        default: {
+            return outputs.lowpass;
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE SvfBank::SvfBank() {}
+ADSP_INLINE SvfBank::~SvfBank() {}
+
+ADSP_INLINE void SvfBank::reset(int _numVoices, double _sampleRate) {
+    numVoices = _numVoices;
+    sampleRate = _sampleRate;
+
+    k.assign(numVoices, 0.0);
+    a1.assign(numVoices, 0.0);
+    a2.assign(numVoices, 0.0);
+    a3.assign(numVoices, 0.0);
+    ic1.assign(numVoices, 0.0);
+    ic2.assign(numVoices, 0.0);
+    mixBandpass.assign(numVoices, 0.0);
+
+    // Default voices, same as Svf
+    const SvfParams defaults;
+    for (int voice = 0; voice < numVoices; ++voice) {
+        setVoice(voice, defaults.fc, defaults.q);
+    }
+}
+
+ADSP_INLINE void SvfBank::processInterleaved(const double *in, double *out,
+                                             int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    // Voices are processed in groups of SVF_BANK_LANES. State and coefficients of a
+    // group live in local arrays for the whole block, so the lane loop only touches
+    // memory the compiler knows is not aliased and maps onto vector registers.
+    for (int base = 0; base < numVoices; base += SVF_BANK_LANES) {
+        const int count = numVoices - base < SVF_BANK_LANES
+                              ? numVoices - base
+                              : SVF_BANK_LANES;
+
+        // Unused lanes run a silent filter
+        double s1[SVF_BANK_LANES] = {};
+        double s2[SVF_BANK_LANES] = {};
+        double c1[SVF_BANK_LANES] = {};
+        double c2[SVF_BANK_LANES] = {};
+        double c3[SVF_BANK_LANES] = {};
+        double mb[SVF_BANK_LANES] = {};
+        for (int lane = 0; lane < count; ++lane) {
+            s1[lane] = ic1[base + lane];
+            s2[lane] = ic2[base + lane];
+            c1[lane] = a1[base + lane];
+            c2[lane] = a2[base + lane];
+            c3[lane] = a3[base + lane];
+            mb[lane] = mixBandpass[base + lane];
+        }
+
+        const double mx = mixInput;
+        const double ml = mixLowpass;
+
+        for (int n = 0; n < numSamples; ++n) {
+            double x[SVF_BANK_LANES] = {};
+            for (int lane = 0; lane < count; ++lane) {
+                x[lane] = in[n * numVoices + base + lane];
+            }
+
+            double y[SVF_BANK_LANES];
+            for (int lane = 0; lane < SVF_BANK_LANES; ++lane) {
+                const double v3 = x[lane] - s2[lane];
+                const double v1 = c1[lane] * s1[lane] + c2[lane] * v3;
+                const double v2 =
+                    s2[lane] + c2[lane] * s1[lane] + c3[lane] * v3;
+                s1[lane] = 2.0 * v1 - s1[lane];
+                s2[lane] = 2.0 * v2 - s2[lane];
+
+                y[lane] = mx * x[lane] + mb[lane] * v1 + ml * v2;
+            }
+
+            for (int lane = 0; lane < count; ++lane) {
+                out[n * numVoices + base + lane] = y[lane];
+            }
+        }
+
+        for (int lane = 0; lane < count; ++lane) {
+            fixUnderflow(s1[lane]);
+            fixUnderflow(s2[lane]);
+            ic1[base + lane] = s1[lane];
+            ic2[base + lane] = s2[lane];
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void SvfBank::setVoice(int voice, double fc, double q) {
+    const SvfCoefficients c = calculateSvfCoefficients(fc, q, sampleRate);
+    k[voice] = c.k;
+    a1[voice] = c.a1;
+    a2[voice] = c.a2;
+    a3[voice] = c.a3;
+
+    updateMix(voice);
+}
+
+ADSP_INLINE void SvfBank::setOutput(svfOutput _output) {
+    output = _output;
+
+    for (int voice = 0; voice < numVoices; ++voice) {
+        updateMix(voice);
+    }
+}
+
+ADSP_INLINE void SvfBank::resetVoice(int voice) {
+    ic1[voice] = 0.0;
+    ic2[voice] = 0.0;
+}
+
+ADSP_INLINE int SvfBank::getNumVoices() { return numVoices; }
+
+ADSP_INLINE void SvfBank::updateMix(int voice) {
+    // lowpass = v2, bandpass = v1, notch = x - k * v1, highpass = notch - v2
+    switch (output) {
+        case svfOutput::bandpass: {
+            mixInput = 0.0;
+            mixLowpass = 0.0;
+            mixBandpass[voice] = 1.0;
+            break;
+        }
+        case svfOutput::highpass: {
+            mixInput = 1.0;
+            mixLowpass = -1.0;
+            mixBandpass[voice] = -k[voice];
+            break;
+        }
+        case svfOutput::notch: {
+            mixInput = 1.0;
+            mixLowpass = 0.0;
+            mixBandpass[voice] = -k[voice];
+            break;
+        }
+        case svfOutput::lowpass:
+        default: {
+            mixInput = 0.0;
+            mixLowpass = 1.0;
+            mixBandpass[voice] = 0.0;
+            break;
+        }
+    }
+}
+}  // namespace adsp
@@ -0,0 +1,397 @@
+/*
+  ==============================================================================
+    Svf.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Svf.h
+*
+* @brief Topology-preserving (zero-delay feedback) state-variable filter
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Output of the state-variable filter returned by process()
+*/
+enum class svfOutput { lowpass, bandpass, highpass, notch };
+
+/**
+* @brief Svf parameter structure
+*
+*/
+struct SvfParams {
+    SvfParams() {}
+
+    SvfParams &operator=(const SvfParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            fc = parameters.fc;
+            q = parameters.q;
+            output = parameters.output;
+            return *this;
+        }
+    }
+
+    // Cutoff frequency
+    double fc = 1000.0;  // Hz
+
+    // Quality factor, 1 / sqrt(2) is maximally flat
+    double q = 0.70710678118654752440;
+
+    // Output returned by process() and the block paths
+    svfOutput output = svfOutput::lowpass;
+};
+
+/**
+* @brief All outputs of one state-variable filter step
+*/
+struct SvfOutputs {
+    double lowpass = 0.0;
+    double bandpass = 0.0;
+    double highpass = 0.0;
+    double notch = 0.0;
+};
+
+/**
+* @brief Coefficients of the trapezoidal state-variable filter
+*
+* g = tan(pi * fc / fs) and k = 1 / Q are the only parameters,
+* a1..a3 are derived from them to solve the zero-delay feedback loop.
+*/
+struct SvfCoefficients {
+    double g = 0.0;
+    double k = 0.0;
+    double a1 = 0.0;
+    double a2 = 0.0;
+    double a3 = 0.0;
+};
+
+/**
+* @brief Calculate state-variable filter coefficients
+*
+* @param fc Cutoff frequency, clamped below Nyquist [Hz]
+* @param q Quality factor
+* @param sampleRate Sample rate [Hz]
+* @return Filter coefficients
+*/
+SvfCoefficients calculateSvfCoefficients(double fc, double q,
+                                         double sampleRate);
+
+/**
+* @brief One step of the trapezoidal state-variable filter
+*
+* @param c Filter coefficients
+* @param ic1 State of the first integrator, updated
+* @param ic2 State of the second integrator, updated
+* @param x Input sample
+* @return All filter outputs
+*/
+inline SvfOutputs tickSvf(const SvfCoefficients &c, double &ic1, double &ic2,
+                          double x) {
+    const double v3 = x - ic2;
+    const double v1 = c.a1 * ic1 + c.a2 * v3;
+    const double v2 = ic2 + c.a2 * ic1 + c.a3 * v3;
+    ic1 = 2.0 * v1 - ic1;
+    ic2 = 2.0 * v2 - ic2;
+
+    SvfOutputs outputs;
+    outputs.lowpass = v2;
+    outputs.bandpass = v1;
+    outputs.notch = x - c.k * v1;
+    outputs.highpass = outputs.notch - v2;
+    return outputs;
+}
+
+//==============================================================================
+
+/**
+* @brief State-variable filter, trapezoidal integration with zero-delay feedback
+*
+* Low-pass, band-pass, high-pass and notch come out of one recursion.
+* The state is stored in the integrators rather than in past in- and outputs,
+* so cutoff and resonance can be changed every sample without transients.
+* Changing the cutoff only recomputes g = tan(pi * fc / fs) and three derived values.
+*/
+class Svf {
+   public:
+    Svf();
+    ~Svf();
+
+    //==============================================================================
+
+    /**
+    * @brief Clear internal state and set sample rate
+    *
+    * @param sampleRate New sample rate
+    */
+    void reset(double sampleRate);
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return Selected output (see SvfParams)
+    */
+    double process(double x);
+
+    /**
+    * @brief Process a single sample
+    *
+    * @param x Input sample
+    * @return All outputs
+    */
+    SvfOutputs processAll(double x);
+
+    /**
+    * @brief Process a block, selected output
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param numSamples Number of samples
+    */
+    void processBlock(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Process a block with a cutoff frequency per sample, selected output
+    *
+    * @param in Input block
+    * @param out Output block
+    * @param fc Cutoff frequency per sample [Hz]
+    * @param numSamples Number of samples
+    */
+    void processBlockModulated(const double *in, double *out, const double *fc,
+                               int numSamples);
+
+    /**
+    * @brief Process a block, all outputs
+    *
+    * Any output pointer may be nullptr if the output is not needed.
+    *
+    * @param in Input block
+    * @param lowpass Low-pass output block
+    * @param bandpass Band-pass output block
+    * @param highpass High-pass output block
+    * @param notch Notch output block
+    * @param numSamples Number of samples
+    */
+    void processBlockAll(const double *in, double *lowpass, double *bandpass,
+                         double *highpass, double *notch, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate, recalculate coefficients
+    *
+    * @param sampleRate New sample rate
+    */
+    void setSampleRate(double sampleRate);
+
+    /**
+    * @brief Set cutoff frequency only, cheap enough to call every sample
+    *
+    * @param fc Cutoff frequency [Hz]
+    */
+    void setCutoff(double fc);
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Filter parameters
+    */
+    SvfParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * @param parameters New filter parameters
+    */
+    void setParameters(const SvfParams &parameters);
+
+    /**
+    * @brief Get current coefficients
+    *
+    * @return Filter coefficients
+    */
+    SvfCoefficients getCoefficients();
+
+   protected:
+    /**
+    * @brief Select the configured output
+    */
+    double selectOutput(const SvfOutputs &outputs);
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Filter parameters
+    */
+    SvfParams params;
+
+    /**
+    * @brief Filter coefficients
+    */
+    SvfCoefficients coefficients;
+
+    /**
+    * @brief Integrator states
+    */
+    double ic1{0.0};
+    double ic2{0.0};
+};
+
+//==============================================================================
+
+/**
+* @brief Number of voices SvfBank processes side by side
+*/
+constexpr int SVF_BANK_LANES = 8;
+
+/**
+* @brief Bank of independent state-variable filters, one per voice
+*
+* State and coefficients are stored as one array per quantity (structure of arrays).
+* Groups of SVF_BANK_LANES voices run in lockstep with the voice loop innermost,
+* so the compiler processes several voices per instruction.
+* Blocks are interleaved: sample n of voice v is at index n * numVoices + v.
+* All voices share the selected output.
+*/
+class SvfBank {
+   public:
+    SvfBank();
+    ~SvfBank();
+
+    //==============================================================================
+
+    /**
+    * @brief Allocate voices, clear internal state and set sample rate
+    *
+    * Allocates, call from a non-realtime thread.
+    *
+    * @param numVoices Number of voices
+    * @param sampleRate New sample rate
+    */
+    void reset(int numVoices, double sampleRate);
+
+    /**
+    * @brief Process an interleaved block
+    *
+    * In-place processing (in == out) is allowed.
+    *
+    * @param in Interleaved input, numSamples * numVoices values
+    * @param out Interleaved output, numSamples * numVoices values
+    * @param numSamples Number of samples per voice
+    */
+    void processInterleaved(const double *in, double *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Set cutoff frequency and quality factor of one voice
+    *
+    * @param voice Voice index
+    * @param fc Cutoff frequency [Hz]
+    * @param q Quality factor
+    */
+    void setVoice(int voice, double fc, double q);
+
+    /**
+    * @brief Select the output of all voices
+    *
+    * @param output Filter output
+    */
+    void setOutput(svfOutput output);
+
+    /**
+    * @brief Clear the state of one voice, e.g. on note-on
+    *
+    * @param voice Voice index
+    */
+    void resetVoice(int voice);
+
+    /**
+    * @brief Get number of voices
+    *
+    * @return Number of voices
+    */
+    int getNumVoices();
+
+   protected:
+    int numVoices{0};
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Output mix, every output is x * mixInput + v1 * mixBandpass[v] + v2 * mixLowpass
+    */
+    double mixInput{0.0};
+    double mixLowpass{1.0};
+    std::vector<double> mixBandpass;
+
+    /**
+    * @brief Per-voice coefficients
+    */
+    std::vector<double> k;
+    std::vector<double> a1;
+    std::vector<double> a2;
+    std::vector<double> a3;
+
+    /**
+    * @brief Per-voice integrator states
+    */
+    std::vector<double> ic1;
+    std::vector<double> ic2;
+
+    /**
+    * @brief Output mode of all voices
+    */
+    svfOutput output{svfOutput::lowpass};
+
+    /**
+    * @brief Recompute the output mix of one voice
+    */
+    void updateMix(int voice);
+};
+}  // namespace adsp
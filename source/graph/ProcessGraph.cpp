@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+    ProcessGraph.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "ProcessGraph.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+ADSP_INLINE ProcessGraph::ProcessGraph() {}
+ADSP_INLINE ProcessGraph::~ProcessGraph() { stopWorkers(); }
+
+//==============================================================================
+
+ADSP_INLINE int ProcessGraph::addInput() {
+    functions.push_back(nullptr);
+    processors.push_back(nullptr);
+    inputIndices.push_back(numInputs++);
+    prepared = false;
+    return static_cast<int>(functions.size()) - 1;
+}
+
+ADSP_INLINE int ProcessGraph::addNode(GraphProcessFunction function,
+                                      void *processor) {
+    functions.push_back(function);
+    processors.push_back(processor);
+    inputIndices.push_back(-1);
+    prepared = false;
+    return static_cast<int>(functions.size()) - 1;
+}
+
+ADSP_INLINE void ProcessGraph::connect(int source, int destination) {
+    connectionSources.push_back(source);
+    connectionDestinations.push_back(destination);
+    prepared = false;
+}
+
+ADSP_INLINE int ProcessGraph::addOutput(int node) {
+    outputNodes.push_back(node);
+    prepared = false;
+    return static_cast<int>(outputNodes.size()) - 1;
+}
+
+ADSP_INLINE void ProcessGraph::clear() {
+    stopWorkers();
+
+    functions.clear();
+    processors.clear();
+    inputIndices.clear();
+    connectionSources.clear();
+    connectionDestinations.clear();
+    outputNodes.clear();
+    numInputs = 0;
+
+    prepared = false;
+    numThreads = 0;
+}
+
+//==============================================================================
+
+ADSP_INLINE bool ProcessGraph::prepare(int _maxBlockSize, int _numThreads) {
+    stopWorkers();
+    prepared = false;
+    numThreads = 0;
+
+    const int numNodes = static_cast<int>(functions.size());
+    const int numConnections = static_cast<int>(connectionSources.size());
+
+    for (int c = 0; c < numConnections; ++c) {
+        if (connectionSources[c] < 0 || connectionSources[c] >= numNodes ||
+            connectionDestinations[c] < 0 ||
+            connectionDestinations[c] >= numNodes) {
+            return false;
+        }
+    }
+    for (int node : outputNodes) {
+        if (node < 0 || node >= numNodes) {
+            return false;
+        }
+    }
+
+    // Sources of each node, in the order they were connected
+    sourceStart.assign(numNodes + 1, 0);
+    for (int c = 0; c < numConnections; ++c) {
+        ++sourceStart[connectionDestinations[c] + 1];
+    }
+    for (int node = 0; node < numNodes; ++node) {
+        sourceStart[node + 1] += sourceStart[node];
+    }
+    sources.resize(numConnections);
+    std::vector<int> fill(sourceStart.begin(), sourceStart.end() - 1);
+    for (int c = 0; c < numConnections; ++c) {
+        sources[fill[connectionDestinations[c]]++] = connectionSources[c];
+    }
+
+    // Topological order, nodes become ready in the order they were added
+    std::vector<int> numPending(numNodes, 0);
+    std::vector<std::vector<int>> destinations(numNodes);
+    for (int c = 0; c < numConnections; ++c) {
+        ++numPending[connectionDestinations[c]];
+        destinations[connectionSources[c]].push_back(connectionDestinations[c]);
+    }
+
+    std::vector<int> order;
+    order.reserve(numNodes);
+    for (int node = 0; node < numNodes; ++node) {
+        if (numPending[node] == 0) {
+            order.push_back(node);
+        }
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (int destination : destinations[order[i]]) {
+            if (--numPending[destination] == 0) {
+                order.push_back(destination);
+            }
+        }
+    }
+
+    // Cycle
+    if (static_cast<int>(order.size()) != numNodes) {
+        return false;
+    }
+
+    // A node continues the chain of its first source that has not been continued
+    // yet, on that source's thread. Others go to the least loaded thread.
+    numThreads = std::max(_numThreads, 1);
+    nodeThreads.assign(numNodes, 0);
+    std::vector<int> numThreadNodes(numThreads, 0);
+    std::vector<bool> continued(numNodes, false);
+    for (int node : order) {
+        int thread = -1;
+        for (int s = sourceStart[node]; s < sourceStart[node + 1]; ++s) {
+            if (!continued[sources[s]]) {
+                continued[sources[s]] = true;
+                thread = nodeThreads[sources[s]];
+                break;
+            }
+        }
+        if (thread < 0) {
+            thread = static_cast<int>(
+                std::min_element(numThreadNodes.begin(), numThreadNodes.end()) -
+                numThreadNodes.begin());
+        }
+        nodeThreads[node] = thread;
+        ++numThreadNodes[thread];
+    }
+
+    threadStart.assign(numThreads + 1, 0);
+    for (int thread = 0; thread < numThreads; ++thread) {
+        threadStart[thread + 1] = threadStart[thread] + numThreadNodes[thread];
+    }
+    threadNodes.resize(numNodes);
+    fill.assign(threadStart.begin(), threadStart.end() - 1);
+    for (int node : order) {
+        threadNodes[fill[nodeThreads[node]]++] = node;
+    }
+
+    // Blocks start on cache lines, threads do not share lines
+    maxBlockSize = std::max(_maxBlockSize, 1);
+    bufferStride = (maxBlockSize + GRAPH_BUFFER_ALIGNMENT - 1) /
+                   GRAPH_BUFFER_ALIGNMENT * GRAPH_BUFFER_ALIGNMENT;
+    buffers.assign(static_cast<size_t>(bufferStride) * numNodes, 0.0);
+
+    nodeDone = std::vector<GraphFlag>(numNodes);
+    threadDone = std::vector<GraphFlag>(numThreads);
+    start.value.store(0);
+    blockCount = 0;
+
+    running.store(true);
+    for (int thread = 1; thread < numThreads; ++thread) {
+        workers.emplace_back(&ProcessGraph::runWorker, this, thread);
+    }
+
+    prepared = true;
+    return true;
+}
+
+ADSP_INLINE void ProcessGraph::process(const double *const *inputs,
+                                       double *const *outputs,
+                                       int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    const int numOutputs = static_cast<int>(outputNodes.size());
+
+    if (!prepared) {
+        for (int output = 0; output < numOutputs; ++output) {
+            std::fill(outputs[output], outputs[output] + numSamples, 0.0);
+        }
+        return;
+    }
+
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize) {
+        currentInputs = inputs;
+        currentOffset = offset;
+        currentNumSamples = std::min(numSamples - offset, maxBlockSize);
+
+        // Publishes the block to the workers
+        const uint64_t block = ++blockCount;
+        start.value.store(block, std::memory_order_release);
+
+        processThread(0, block);
+        for (int thread = 1; thread < numThreads; ++thread) {
+            waitFor(threadDone[thread].value, block);
+        }
+
+        for (int output = 0; output < numOutputs; ++output) {
+            const double *buffer =
+                buffers.data() +
+                static_cast<size_t>(outputNodes[output]) * bufferStride;
+            std::copy(buffer, buffer + currentNumSamples,
+                      outputs[output] + offset);
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE int ProcessGraph::getNumNodes() {
+    return static_cast<int>(functions.size());
+}
+
+ADSP_INLINE int ProcessGraph::getNumInputs() { return numInputs; }
+
+ADSP_INLINE int ProcessGraph::getNumOutputs() {
+    return static_cast<int>(outputNodes.size());
+}
+
+ADSP_INLINE int ProcessGraph::getNumThreads() { return numThreads; }
+
+ADSP_INLINE int ProcessGraph::getNodeThread(int node) {
+    return nodeThreads[node];
+}
+
+//==============================================================================
+
+ADSP_INLINE void ProcessGraph::stopWorkers() {
+    running.store(false);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+ADSP_INLINE void ProcessGraph::runWorker(int thread) {
+    uint64_t block = 0;
+    while (true) {
+        // Wait for the next block or for the graph to stop
+        int spins = 0;
+        while (start.value.load(std::memory_order_acquire) == block) {
+            if (!running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (++spins >= GRAPH_SPIN_COUNT) {
+                std::this_thread::yield();
+                spins = 0;
+            }
+        }
+        ++block;
+
+        ADSP_REALTIME_SECTION();
+        processThread(thread, block);
+    }
+}
+
+ADSP_INLINE void ProcessGraph::processThread(int thread, uint64_t block) {
+    const int offset = currentOffset;
+    const int numSamples = currentNumSamples;
+
+    for (int i = threadStart[thread]; i < threadStart[thread + 1]; ++i) {
+        const int node = threadNodes[i];
+        double *buffer =
+            buffers.data() + static_cast<size_t>(node) * bufferStride;
+
+        if (functions[node] == nullptr) {
+            // Graph input
+            const double *in = currentInputs[inputIndices[node]] + offset;
+            std::copy(in, in + numSamples, buffer);
+        } else {
+            // Sum of the sources, silence without sources
+            std::fill(buffer, buffer + numSamples, 0.0);
+        }
+
+        for (int s = sourceStart[node]; s < sourceStart[node + 1]; ++s) {
+            const int source = sources[s];
+            if (nodeThreads[source] != thread) {
+                waitFor(nodeDone[source].value, block);
+            }
+
+            const double *in =
+                buffers.data() + static_cast<size_t>(source) * bufferStride;
+            for (int n = 0; n < numSamples; ++n) {
+                buffer[n] += in[n];
+            }
+        }
+
+        if (functions[node] != nullptr) {
+            functions[node](processors[node], buffer, numSamples);
+        }
+
+        nodeDone[node].value.store(block, std::memory_order_release);
+    }
+
+    threadDone[thread].value.store(block, std::memory_order_release);
+}
+
+ADSP_INLINE void ProcessGraph::waitFor(const std::atomic<uint64_t> &flag,
+                                       uint64_t block) {
+    int spins = 0;
+    while (flag.load(std::memory_order_acquire) < block) {
+        if (++spins >= GRAPH_SPIN_COUNT) {
+            std::this_thread::yield();
+            spins = 0;
+        }
+    }
+}
+}  // namespace adsp
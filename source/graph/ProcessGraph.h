@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+    ProcessGraph.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file ProcessGraph.h
+*
+* @brief Block processing graph of ADSP objects with a multithreaded executor
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../debug/RealtimeCheck.h"
+
+namespace adsp {
+/**
+* @brief Checks of a flag a waiting thread spins for before yielding its time slice
+*/
+constexpr int GRAPH_SPIN_COUNT = 256;
+
+/**
+* @brief Number of doubles node buffers are aligned to, one cache line
+*/
+constexpr int GRAPH_BUFFER_ALIGNMENT = 8;
+
+/**
+* @brief Function processing a block of a node in place
+*
+* @param processor Object the node wraps
+* @param block Block, holds the sum of the node's sources on entry
+* @param numSamples Number of samples
+*/
+typedef void (*GraphProcessFunction)(void *processor, double *block,
+                                     int numSamples);
+
+//==============================================================================
+
+/**
+* @brief Static dataflow graph of mono processors, e.g. per-track chains like
+* RcHp1 -> LowShelf -> SkLp2 -> Saturator feeding a sum
+*
+* Nodes wrap existing objects (not owned), any class with double process(double)
+* is added with addNode(), other processors with a GraphProcessFunction. Each node
+* processes a whole block before the next node runs, so the state of one object stays
+* in cache for the block instead of all objects of a chain being touched for every
+* sample. A node sums the blocks of all nodes connected to it, graph inputs and
+* outputs are nodes too.
+*
+* prepare() sorts the nodes topologically, allocates one block buffer per node and
+* statically assigns the nodes to threads: a node runs on the thread of a source it
+* continues (chains stay on one thread), branches and new chains go to the thread
+* with the fewest nodes. The calling thread is one of them, the others are workers
+* started by prepare(). Per block, workers only wait for sources scheduled on other
+* threads, by spinning on per-node flags.
+*
+* process() does not allocate or lock, neither do the workers. Workers spin between
+* blocks and yield their time slice after GRAPH_SPIN_COUNT checks, so use one thread
+* per core that is free for audio processing.
+*
+* Changes to the graph take effect with the next prepare(), the graph outputs silence
+* until then. Do not change or prepare the graph while process() runs.
+*/
+class ProcessGraph {
+   public:
+    ProcessGraph();
+    ~ProcessGraph();
+
+    ProcessGraph(const ProcessGraph &) = delete;
+    ProcessGraph &operator=(const ProcessGraph &) = delete;
+
+    //==============================================================================
+
+    /**
+    * @brief Add a graph input
+    *
+    * Inputs are numbered in the order they are added.
+    *
+    * @return Node index
+    */
+    int addInput();
+
+    /**
+    * @brief Add a node calling process() of an object for every sample
+    *
+    * @tparam Processor Filter wrapper, Biquad, Saturator or any class with
+    * double process(double)
+    * @param processor Object to wrap, must outlive the graph
+    * @return Node index
+    */
+    template <typename Processor>
+    int addNode(Processor &processor) {
+        return addNode(&processSamples<Processor>, &processor);
+    }
+
+    /**
+    * @brief Add a node calling a block function
+    *
+    * @param function Function processing a block in place
+    * @param processor Object passed to the function
+    * @return Node index
+    */
+    int addNode(GraphProcessFunction function, void *processor);
+
+    /**
+    * @brief Feed the output of a node into another node
+    *
+    * @param source Node index of the source
+    * @param destination Node index of the destination, sums all of its sources
+    */
+    void connect(int source, int destination);
+
+    /**
+    * @brief Add a graph output carrying the block of a node
+    *
+    * Outputs are numbered in the order they are added.
+    *
+    * @param node Node index
+    * @return Output index
+    */
+    int addOutput(int node);
+
+    /**
+    * @brief Remove all nodes and stop the workers
+    *
+    */
+    void clear();
+
+    //==============================================================================
+
+    /**
+    * @brief Schedule the graph, allocate buffers and start the workers
+    *
+    * Allocates and starts threads, call from a non-realtime thread.
+    *
+    * @param maxBlockSize Largest number of samples processed at once, longer blocks
+    * are split
+    * @param numThreads Number of threads including the calling thread
+    * @return false if the graph has a cycle or a connection to an unknown node, the
+    * graph then outputs silence
+    */
+    bool prepare(int maxBlockSize, int numThreads);
+
+    /**
+    * @brief Process a block
+    *
+    * @param inputs Array of getNumInputs() input blocks
+    * @param outputs Array of getNumOutputs() output blocks
+    * @param numSamples Number of samples
+    */
+    void process(const double *const *inputs, double *const *outputs,
+                 int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get number of nodes, including inputs
+    *
+    * @return Number of nodes
+    */
+    int getNumNodes();
+
+    /**
+    * @brief Get number of graph inputs
+    *
+    * @return Number of inputs
+    */
+    int getNumInputs();
+
+    /**
+    * @brief Get number of graph outputs
+    *
+    * @return Number of outputs
+    */
+    int getNumOutputs();
+
+    /**
+    * @brief Get number of threads the graph runs on, 0 if not prepared
+    *
+    * @return Number of threads
+    */
+    int getNumThreads();
+
+    /**
+    * @brief Get the thread a node is scheduled on by the last prepare()
+    *
+    * @param node Node index
+    * @return Thread index, 0 is the thread calling process()
+    */
+    int getNodeThread(int node);
+
+   protected:
+    /**
+    * @brief Block function of addNode() for objects with process()
+    */
+    template <typename Processor>
+    static void processSamples(void *processor, double *block, int numSamples) {
+        Processor &object = *static_cast<Processor *>(processor);
+        for (int n = 0; n < numSamples; ++n) {
+            block[n] = object.process(block[n]);
+        }
+    }
+
+    /**
+    * @brief Stop and join the workers
+    */
+    void stopWorkers();
+
+    /**
+    * @brief Main loop of a worker thread
+    *
+    * @param thread Thread index
+    */
+    void runWorker(int thread);
+
+    /**
+    * @brief Process the nodes of a thread for the current block
+    *
+    * @param thread Thread index
+    * @param block Block number the finished nodes are marked with
+    */
+    void processThread(int thread, uint64_t block);
+
+    /**
+    * @brief Spin until a flag reaches a block number
+    *
+    * @param flag Flag to wait for
+    * @param block Block number
+    */
+    void waitFor(const std::atomic<uint64_t> &flag, uint64_t block);
+
+    //==============================================================================
+
+    /**
+    * @brief A block counter on a cache line of its own
+    */
+    struct alignas(64) GraphFlag {
+        std::atomic<uint64_t> value{0};
+    };
+
+    /**
+    * @brief Nodes as added: function (nullptr for inputs), processor and input
+    * index
+    */
+    std::vector<GraphProcessFunction> functions;
+    std::vector<void *> processors;
+    std::vector<int> inputIndices;
+
+    /**
+    * @brief Connections as added and nodes of the outputs
+    */
+    std::vector<int> connectionSources;
+    std::vector<int> connectionDestinations;
+    std::vector<int> outputNodes;
+
+    /**
+    * @brief Number of inputs
+    */
+    int numInputs{0};
+
+    //==============================================================================
+
+    /**
+    * @brief Whether prepare() succeeded, number of threads and block size
+    */
+    bool prepared{false};
+    int numThreads{0};
+    int maxBlockSize{0};
+
+    /**
+    * @brief Sources of each node, those of node i at sourceStart[i] to
+    * sourceStart[i + 1]
+    */
+    std::vector<int> sourceStart;
+    std::vector<int> sources;
+
+    /**
+    * @brief Nodes of each thread in topological order, those of thread t at
+    * threadStart[t] to threadStart[t + 1]
+    */
+    std::vector<int> threadStart;
+    std::vector<int> threadNodes;
+    std::vector<int> nodeThreads;
+
+    /**
+    * @brief Node blocks, node i at i * bufferStride
+    */
+    std::vector<double> buffers;
+    int bufferStride{0};
+
+    /**
+    * @brief Block number each node and each thread has finished
+    */
+    std::vector<GraphFlag> nodeDone;
+    std::vector<GraphFlag> threadDone;
+
+    //==============================================================================
+
+    /**
+    * @brief Block number the workers start on, and whether they keep running
+    */
+    GraphFlag start;
+    std::atomic<bool> running{false};
+
+    /**
+    * @brief Inputs, offset and length of the current block, published by start
+    */
+    const double *const *currentInputs{nullptr};
+    int currentOffset{0};
+    int currentNumSamples{0};
+
+    /**
+    * @brief Number of blocks processed
+    */
+    uint64_t blockCount{0};
+
+    /**
+    * @brief Worker threads, thread t + 1 is workers[t]
+    */
+    std::vector<std::thread> workers;
+};
+}  // namespace adsp
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+    Saturator.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Saturator.cpp
+*
+* @brief Saturation with first-order antiderivative anti-aliasing
+*/
+
+#include "Saturator.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+/**
+* @brief Number of samples the antiderivatives are evaluated for at once
+*/
+constexpr int SATURATOR_BLOCK_SIZE = 64;
+
+/**
+* @brief clip() with the default bounds, usable as a template argument
+*/
+double hardClip(double x) { return clip(x); }
+
+/**
+* @brief First-order ADAA of one block, the curve is fixed at compile time
+*/
+template <double (*curve)(double), double (*integral)(double)>
+void saturateAntialiased(const double *in, double *out, int numSamples,
+                         double gain, double &lastInput,
+                         double &lastIntegral) {
+    // Index 0 holds the last sample of the previous block
+    double x[SATURATOR_BLOCK_SIZE + 1];
+    double F[SATURATOR_BLOCK_SIZE + 1];
+
+    int offset = 0;
+    while (offset < numSamples) {
+        const int numBlock =
+            std::min(SATURATOR_BLOCK_SIZE, numSamples - offset);
+
+        x[0] = lastInput;
+        F[0] = lastIntegral;
+        for (int n = 0; n < numBlock; ++n) {
+            x[n + 1] = gain * in[offset + n];
+            F[n + 1] = integral(x[n + 1]);
+        }
+
+        for (int n = 0; n < numBlock; ++n) {
+            const double dx = x[n + 1] - x[n];
+            out[offset + n] = fabs(dx) > SATURATOR_ADAA_TOLERANCE
+                                  ? (F[n + 1] - F[n]) / dx
+                                  : curve(0.5 * (x[n + 1] + x[n]));
+        }
+
+        lastInput = x[numBlock];
+        lastIntegral = F[numBlock];
+        offset += numBlock;
+    }
+}
+}  // namespace
+
+ADSP_INLINE Saturator::Saturator() {}
+ADSP_INLINE Saturator::~Saturator() {}
+
+//==============================================================================
+
+ADSP_INLINE void Saturator::reset() {
+    lastInput = 0.0;
+    lastIntegral = 0.0;
+}
+
+ADSP_INLINE double Saturator::process(double x) {
+    ADSP_REALTIME_SECTION();
+
+    x *= driveGain;
+
+    if (!params.antialiasing) {
+        return softClip(params.shape, x);
+    }
+
+    const double integral = softClipIntegral(params.shape, x);
+    const double dx = x - lastInput;
+    const double y = fabs(dx) > SATURATOR_ADAA_TOLERANCE
+                         ? (integral - lastIntegral) / dx
+                         : softClip(params.shape, 0.5 * (x + lastInput));
+
+    lastInput = x;
+    lastIntegral = integral;
+
+    return y;
+}
+
+ADSP_INLINE void Saturator::processBlock(const double *in, double *out,
+                                         int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (!params.antialiasing) {
+        for (int n = 0; n < numSamples; ++n) {
+            out[n] = driveGain * in[n];
+        }
+        softClipBlock(params.shape, out, out, numSamples);
+        return;
+    }
+
+    switch (params.shape) {
+        case saturationShape::hard: {
+            saturateAntialiased<hardClip, hardClipIntegral>(
+                in, out, numSamples, driveGain, lastInput, lastIntegral);
+            break;
+        }
+        case saturationShape::tanh: {
+            saturateAntialiased<softClipTanh, softClipTanhIntegral>(
+                in, out, numSamples, driveGain, lastInput, lastIntegral);
+            break;
+        }
+        case saturationShape::atan: {
+            saturateAntialiased<softClipAtan, softClipAtanIntegral>(
+                in, out, numSamples, driveGain, lastInput, lastIntegral);
+            break;
+        }
+        case saturationShape::cubic: {
+            saturateAntialiased<softClipCubic, softClipCubicIntegral>(
+                in, out, numSamples, driveGain, lastInput, lastIntegral);
+            break;
+        }
+        default: {
+            saturateAntialiased<softClipDiode, softClipDiodeIntegral>(
+                in, out, numSamples, driveGain, lastInput, lastIntegral);
+            break;
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE SaturatorParams Saturator::getParameters() { return params; }
+
+ADSP_INLINE void Saturator::setParameters(const SaturatorParams &parameters) {
+    // If new parameters differ..
+    if (parameters.shape != params.shape ||
+        parameters.drive != params.drive ||
+        parameters.antialiasing != params.antialiasing) {
+        params = parameters;
+
+        // The stored antiderivative belongs to the old curve
+        lastIntegral = softClipIntegral(params.shape, lastInput);
+
+        driveGain = dbToRawGain(params.drive);
+    }
+}
+}  // namespace adsp
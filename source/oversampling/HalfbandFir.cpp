@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+    HalfbandFir.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "HalfbandFir.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+// Zeroth-order modified Bessel function of the first kind (power series)
+double halfbandBesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = 0.5 * x;
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+}  // namespace
+
+ADSP_INLINE int designHalfbandFir(double *taps, double transitionBandwidth,
+                                  double attenuation) {
+    // Kaiser window parameters
+    double beta = 0.0;
+    if (attenuation > 50.0) {
+        beta = 0.1102 * (attenuation - 8.7);
+    } else if (attenuation > 21.0) {
+        beta = 0.5842 * pow(attenuation - 21.0, 0.4) +
+               0.07886 * (attenuation - 21.0);
+    }
+
+    const double length =
+        (attenuation - 7.95) / (14.36 * transitionBandwidth) + 1.0;
+
+    // Halfband length is 4 * M - 1, M non-zero taps on each side of the center
+    int M = static_cast<int>(ceil((length + 1.0) / 4.0));
+    M = M < 1 ? 1 : M;
+    M = M > MAX_HALFBAND_FIR_TAPS ? MAX_HALFBAND_FIR_TAPS : M;
+
+    const double center = 2.0 * M - 1.0;
+    const double i0Beta = halfbandBesselI0(beta);
+
+    double sum = 0.0;
+    for (int k = 0; k < M; ++k) {
+        const double offset = 2.0 * k + 1.0;
+
+        // Ideal halfband impulse response: 0.5 * sinc(offset / 2)
+        const double ideal = sin(0.5 * PI * offset) / (PI * offset);
+
+        const double ratio = offset / center;
+        const double window =
+            halfbandBesselI0(beta * sqrt(1.0 - ratio * ratio)) / i0Beta;
+
+        taps[k] = ideal * window;
+        sum += taps[k];
+    }
+
+    // Unity gain at DC: 0.5 + 2 * sum(taps) = 1
+    for (int k = 0; k < M; ++k) {
+        taps[k] *= 0.25 / sum;
+    }
+
+    return M;
+}
+
+//==============================================================================
+
+ADSP_INLINE HalfbandFir::HalfbandFir() {}
+ADSP_INLINE HalfbandFir::~HalfbandFir() {}
+
+ADSP_INLINE void HalfbandFir::setup(double transitionBandwidth,
+                                    double attenuation) {
+    memset(&taps[0], 0, sizeof(double) * MAX_HALFBAND_FIR_TAPS);
+    numTaps = designHalfbandFir(taps, transitionBandwidth, attenuation);
+    lineLength = 2 * numTaps;
+
+    reset();
+}
+
+ADSP_INLINE void HalfbandFir::reset() {
+    memset(&foldedLine[0], 0, sizeof(double) * 4 * MAX_HALFBAND_FIR_TAPS);
+    memset(&centerLine[0], 0, sizeof(double) * 4 * MAX_HALFBAND_FIR_TAPS);
+    foldedPosition = 0;
+    centerPosition = 0;
+}
+
+ADSP_INLINE void HalfbandFir::push(double *line, int &position, double x) {
+    // Write backwards so that line[position + i] is the sample delayed by i
+    position = position == 0 ? lineLength - 1 : position - 1;
+    line[position] = x;
+    line[position + lineLength] = x;
+}
+
+ADSP_INLINE double HalfbandFir::foldedSum(const double *window) {
+    double sum = 0.0;
+    for (int k = 0; k < numTaps; ++k) {
+        sum += taps[k] * (window[numTaps - 1 - k] + window[numTaps + k]);
+    }
+    return sum;
+}
+
+ADSP_INLINE void HalfbandFir::upsample(const double *in, double *out,
+                                       int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        push(foldedLine, foldedPosition, in[n]);
+        const double *window = &foldedLine[foldedPosition];
+
+        // Zero stuffing halves the gain, the factor of two restores it
+        out[2 * n] = 2.0 * foldedSum(window);
+        out[2 * n + 1] = window[numTaps - 1];
+    }
+}
+
+ADSP_INLINE void HalfbandFir::downsample(const double *in, double *out,
+                                         int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        push(centerLine, centerPosition, in[2 * n]);
+        push(foldedLine, foldedPosition, in[2 * n + 1]);
+
+        out[n] = 0.5 * centerLine[centerPosition + numTaps - 1] +
+                 foldedSum(&foldedLine[foldedPosition]);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE double HalfbandFir::getUpsamplingLatency() {
+    // Center tap sits 2 * M - 1 samples into the filter at the higher rate
+    return 0.5 * (2.0 * numTaps - 1.0);
+}
+
+ADSP_INLINE double HalfbandFir::getDownsamplingLatency() {
+    // Outputs are aligned to the odd input sample, one sample later at the higher rate
+    return numTaps - 1.0;
+}
+
+ADSP_INLINE int HalfbandFir::getNumTaps() { return numTaps; }
+}  // namespace adsp
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+    HalfbandFir.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file HalfbandFir.h
+*
+* @brief Polyphase linear-phase FIR halfband filter for 2x up- and downsampling
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#include "../debug/RealtimeCheck.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Maximum number of symmetric coefficient pairs of a FIR halfband filter
+*/
+constexpr int MAX_HALFBAND_FIR_TAPS = 64;
+
+/**
+* @brief Design a Kaiser-windowed FIR halfband filter
+*
+* Only the non-zero taps next to the center tap are returned (the center tap is always 0.5).
+* Tap k belongs to the offsets +/-(2k + 1) from the center.
+* The taps are normalized for unity gain at DC.
+*
+* @param taps Array to be filled, must hold MAX_HALFBAND_FIR_TAPS values
+* @param transitionBandwidth Width of the transition band, normalized to the higher sample rate ]0.0, 0.5[
+* @param attenuation Desired stopband attenuation [dB]
+* @return Number of taps written (clamped to MAX_HALFBAND_FIR_TAPS)
+*/
+int designHalfbandFir(double *taps, double transitionBandwidth,
+                      double attenuation);
+
+//==============================================================================
+
+/**
+* @brief Polyphase FIR halfband filter
+*
+* Only the non-zero half of the taps is evaluated, and the symmetric pairs are folded so each
+* multiply serves two input samples.
+* The delay lines are stored twice in a row, so every output reads one contiguous window
+* without any index wrapping, which keeps the inner loops vectorizable.
+* Round trip latency is (4 * numTaps - 3) samples at the higher sample rate.
+* An instance keeps the state of one direction, use separate instances for up- and downsampling.
+*/
+class HalfbandFir {
+   public:
+    HalfbandFir();
+    ~HalfbandFir();
+
+    //==============================================================================
+
+    /**
+    * @brief Design the filter and clear internal state
+    *
+    * @param transitionBandwidth Width of the transition band, normalized to the higher sample rate
+    * @param attenuation Desired stopband attenuation [dB]
+    */
+    void setup(double transitionBandwidth, double attenuation);
+
+    /**
+    * @brief Sets all state registers to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Upsample a block by a factor of two
+    *
+    * @param in Input block at the lower sample rate
+    * @param out Output block at the higher sample rate, must hold 2 * numSamples values
+    * @param numSamples Number of input samples
+    */
+    void upsample(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Downsample a block by a factor of two
+    *
+    * in and out may point to the same buffer.
+    *
+    * @param in Input block at the higher sample rate, must hold 2 * numSamples values
+    * @param out Output block at the lower sample rate
+    * @param numSamples Number of output samples
+    */
+    void downsample(const double *in, double *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get latency of the upsampler
+    *
+    * @return Latency in samples at the lower sample rate
+    */
+    double getUpsamplingLatency();
+
+    /**
+    * @brief Get latency of the downsampler
+    *
+    * @return Latency in samples at the lower sample rate
+    */
+    double getDownsamplingLatency();
+
+    /**
+    * @brief Get number of symmetric tap pairs
+    *
+    * @return Number of taps
+    */
+    int getNumTaps();
+
+   protected:
+    /**
+    * @brief Push a sample into a doubled delay line
+    *
+    * @param line Delay line of length 2 * lineLength
+    * @param position Write position, moves backwards
+    * @param x New sample
+    */
+    void push(double *line, int &position, double x);
+
+    /**
+    * @brief Folded symmetric dot product around the center of a delay line window
+    *
+    * @param window Contiguous delay line window, window[i] is the sample delayed by i
+    * @return Sum over k of taps[k] * (window[M - 1 - k] + window[M + k])
+    */
+    double foldedSum(const double *window);
+
+    /**
+    * @brief Non-zero taps next to the center tap
+    */
+    double taps[MAX_HALFBAND_FIR_TAPS] = {};
+
+    /**
+    * @brief Number of taps in use (M)
+    */
+    int numTaps{0};
+
+    /**
+    * @brief Length of one delay line (2 * M)
+    */
+    int lineLength{0};
+
+    /**
+    * @brief Delay line of the folded (non-trivial) polyphase branch, stored twice
+    */
+    double foldedLine[4 * MAX_HALFBAND_FIR_TAPS] = {};
+
+    /**
+    * @brief Delay line of the center tap branch, stored twice
+    */
+    double centerLine[4 * MAX_HALFBAND_FIR_TAPS] = {};
+
+    /**
+    * @brief Write positions of the delay lines
+    */
+    int foldedPosition{0};
+    int centerPosition{0};
+};
+}  // namespace adsp
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+    HalfbandIir.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "HalfbandIir.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+// Integer power for the elliptic series expansions
+double halfbandIpow(double x, int n) {
+    double z = 1.0;
+    while (n > 0) {
+        if (n & 1) {
+            z *= x;
+        }
+        x *= x;
+        n >>= 1;
+    }
+    return z;
+}
+
+// Numerator series of the elliptic sine expansion
+double halfbandAccNum(double q, int order, int c) {
+    double acc = 0.0;
+    double term = 0.0;
+    int i = 0;
+    int j = 1;
+    do {
+        term = halfbandIpow(q, i * (i + 1)) *
+               sin((i * 2 + 1) * c * PI / order) * j;
+        acc += term;
+        j = -j;
+        ++i;
+    } while (fabs(term) > 1e-100);
+    return acc;
+}
+
+// Denominator series of the elliptic sine expansion
+double halfbandAccDen(double q, int order, int c) {
+    double acc = 0.0;
+    double term = 0.0;
+    int i = 1;
+    int j = -1;
+    do {
+        term = halfbandIpow(q, i * i) * cos(i * 2 * c * PI / order) * j;
+        acc += term;
+        j = -j;
+        ++i;
+    } while (fabs(term) > 1e-100);
+    return acc;
+}
+}  // namespace
+
+ADSP_INLINE void designHalfbandIir(double *coefficients, int numCoefficients,
+                                   double transitionBandwidth) {
+    // Selectivity factor k and nome q of the elliptic design
+    double k = tan((1.0 - transitionBandwidth * 2.0) * PI / 4.0);
+    k *= k;
+    const double kksqrt = pow(1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const double e4 = e * e * e * e;
+    const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    const int order = numCoefficients * 2 + 1;
+
+    for (int i = 0; i < numCoefficients; ++i) {
+        const int c = i + 1;
+        const double num = halfbandAccNum(q, order, c) * pow(q, 0.25);
+        const double den = halfbandAccDen(q, order, c) + 0.5;
+        const double ww = num / den;
+        const double wwsq = ww * ww;
+
+        const double x =
+            sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        coefficients[i] = (1.0 - x) / (1.0 + x);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE HalfbandIir::HalfbandIir() {}
+ADSP_INLINE HalfbandIir::~HalfbandIir() {}
+
+ADSP_INLINE void HalfbandIir::setup(int _numCoefficients,
+                                    double transitionBandwidth) {
+    numCoefficients = _numCoefficients < 1 ? 1 : _numCoefficients;
+    if (numCoefficients > MAX_HALFBAND_IIR_COEFFICIENTS) {
+        numCoefficients = MAX_HALFBAND_IIR_COEFFICIENTS;
+    }
+
+    memset(&coefficientsArray[0], 0,
+           sizeof(double) * MAX_HALFBAND_IIR_COEFFICIENTS);
+    designHalfbandIir(coefficientsArray, numCoefficients, transitionBandwidth);
+
+    reset();
+}
+
+ADSP_INLINE void HalfbandIir::reset() {
+    memset(&xState[0], 0, sizeof(double) * MAX_HALFBAND_IIR_COEFFICIENTS);
+    memset(&yState[0], 0, sizeof(double) * MAX_HALFBAND_IIR_COEFFICIENTS);
+}
+
+ADSP_INLINE void HalfbandIir::processPaths(double &path0, double &path1) {
+    // Sections are interleaved: even index -> path 0, odd index -> path 1
+    // y[n] = c * (x[n] - y[n-1]) + x[n-1]
+    int i = 0;
+    for (; i + 1 < numCoefficients; i += 2) {
+        double y0 = (path0 - yState[i]) * coefficientsArray[i] + xState[i];
+        double y1 =
+            (path1 - yState[i + 1]) * coefficientsArray[i + 1] + xState[i + 1];
+
+        fixUnderflow(y0);
+        fixUnderflow(y1);
+
+        xState[i] = path0;
+        xState[i + 1] = path1;
+        yState[i] = y0;
+        yState[i + 1] = y1;
+
+        path0 = y0;
+        path1 = y1;
+    }
+
+    // Odd number of sections, the last one belongs to path 0
+    if (i < numCoefficients) {
+        double y0 = (path0 - yState[i]) * coefficientsArray[i] + xState[i];
+
+        fixUnderflow(y0);
+
+        xState[i] = path0;
+        yState[i] = y0;
+        path0 = y0;
+    }
+}
+
+ADSP_INLINE void HalfbandIir::upsample(const double *in, double *out,
+                                       int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        double path0 = in[n];
+        double path1 = in[n];
+
+        processPaths(path0, path1);
+
+        out[2 * n] = path0;
+        out[2 * n + 1] = path1;
+    }
+}
+
+ADSP_INLINE void HalfbandIir::downsample(const double *in, double *out,
+                                         int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    for (int n = 0; n < numSamples; ++n) {
+        // Odd input sample feeds path 0, even one path 1 (delayed branch)
+        double path0 = in[2 * n + 1];
+        double path1 = in[2 * n];
+
+        processPaths(path0, path1);
+
+        out[n] = 0.5 * (path0 + path1);
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE double HalfbandIir::getUpsamplingLatency() {
+    // Both paths averaged, plus half a sample at the higher rate for the polyphase offset
+    return 0.5 * (getPathDelay() + 0.5);
+}
+
+ADSP_INLINE double HalfbandIir::getDownsamplingLatency() {
+    // Outputs are aligned to the odd input sample, one sample later at the higher rate
+    return 0.5 * (getPathDelay() - 0.5);
+}
+
+ADSP_INLINE double HalfbandIir::getPathDelay() {
+    // Group delay at DC of a first-order allpass is (1 - c) / (1 + c)
+    double pathDelay = 0.0;
+    for (int i = 0; i < numCoefficients; ++i) {
+        pathDelay +=
+            (1.0 - coefficientsArray[i]) / (1.0 + coefficientsArray[i]);
+    }
+    return pathDelay;
+}
+
+ADSP_INLINE int HalfbandIir::getNumCoefficients() { return numCoefficients; }
+}  // namespace adsp
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+    HalfbandIir.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file HalfbandIir.h
+*
+* @brief Polyphase IIR halfband filter for 2x up- and downsampling
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#include "../debug/RealtimeCheck.h"
+#include "../utility/utility.h"
+
+namespace adsp {
+/**
+* @brief Maximum number of allpass coefficients of a polyphase IIR halfband filter
+*/
+constexpr int MAX_HALFBAND_IIR_COEFFICIENTS = 16;
+
+/**
+* @brief Design the allpass coefficients of a polyphase IIR halfband filter
+*
+* Elliptic halfband design after Valenzuela and Constantinides, in the form popularized by
+* Laurent de Soras' HIIR library. The transition band is centered around a quarter of the
+* (higher) sample rate.
+* Coefficients with an even index belong to the first allpass path, odd ones to the second.
+*
+* @param coefficients Array to be filled, must hold numCoefficients values
+* @param numCoefficients Number of first-order allpass sections (filter order is 2 * numCoefficients + 1)
+* @param transitionBandwidth Width of the transition band, normalized to the higher sample rate ]0.0, 0.5[
+*/
+void designHalfbandIir(double *coefficients, int numCoefficients,
+                       double transitionBandwidth);
+
+//==============================================================================
+
+/**
+* @brief Polyphase IIR halfband filter
+*
+* Two parallel chains of first-order allpass sections running at the lower sample rate.
+* The two paths are computed side by side so the compiler can pair them into vector lanes.
+* Phase response is not linear, the group delay at DC is reported by the latency getters.
+* An instance keeps the state of one direction, use separate instances for up- and downsampling.
+*/
+class HalfbandIir {
+   public:
+    HalfbandIir();
+    ~HalfbandIir();
+
+    //==============================================================================
+
+    /**
+    * @brief Design the filter and clear internal state
+    *
+    * @param numCoefficients Number of allpass sections, clamped to [1, MAX_HALFBAND_IIR_COEFFICIENTS]
+    * @param transitionBandwidth Width of the transition band, normalized to the higher sample rate
+    */
+    void setup(int numCoefficients, double transitionBandwidth);
+
+    /**
+    * @brief Sets all state registers to zero
+    *
+    */
+    void reset();
+
+    /**
+    * @brief Upsample a block by a factor of two
+    *
+    * @param in Input block at the lower sample rate
+    * @param out Output block at the higher sample rate, must hold 2 * numSamples values
+    * @param numSamples Number of input samples
+    */
+    void upsample(const double *in, double *out, int numSamples);
+
+    /**
+    * @brief Downsample a block by a factor of two
+    *
+    * in and out may point to the same buffer.
+    *
+    * @param in Input block at the higher sample rate, must hold 2 * numSamples values
+    * @param out Output block at the lower sample rate
+    * @param numSamples Number of output samples
+    */
+    void downsample(const double *in, double *out, int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Get group delay at DC of the upsampler
+    *
+    * @return Latency in samples at the lower sample rate
+    */
+    double getUpsamplingLatency();
+
+    /**
+    * @brief Get group delay at DC of the downsampler
+    *
+    * @return Latency in samples at the lower sample rate
+    */
+    double getDownsamplingLatency();
+
+    /**
+    * @brief Get number of allpass coefficients
+    *
+    * @return Number of coefficients
+    */
+    int getNumCoefficients();
+
+   protected:
+    /**
+    * @brief Process one sample through both allpass paths
+    *
+    * @param path0 Input/output of the first path
+    * @param path1 Input/output of the second path
+    */
+    void processPaths(double &path0, double &path1);
+
+    /**
+    * @brief Sum of the DC group delays of all allpass sections
+    *
+    * @return Delay in samples at the lower sample rate
+    */
+    double getPathDelay();
+
+    /**
+    * @brief Allpass coefficients
+    */
+    double coefficientsArray[MAX_HALFBAND_IIR_COEFFICIENTS] = {};
+
+    /**
+    * @brief Number of allpass coefficients in use
+    */
+    int numCoefficients{0};
+
+    /**
+    * @brief Input state registers, one per allpass section
+    */
+    double xState[MAX_HALFBAND_IIR_COEFFICIENTS] = {};
+
+    /**
+    * @brief Output state registers, one per allpass section
+    */
+    double yState[MAX_HALFBAND_IIR_COEFFICIENTS] = {};
+};
+}  // namespace adsp
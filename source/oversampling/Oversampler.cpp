@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+    Oversampler.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "Oversampler.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+// Transition bandwidth per stage, normalized to the stage's higher sample rate.
+// Stage 0 has to be steep, later stages only need to reject images above the
+// original Nyquist frequency.
+constexpr double OVERSAMPLING_TRANSITION[MAX_OVERSAMPLING_STAGES] = {
+    0.04, 0.25, 0.375, 0.4375};
+
+// Number of allpass coefficients per IIR stage (> 95 dB image rejection)
+constexpr int OVERSAMPLING_IIR_COEFFICIENTS[MAX_OVERSAMPLING_STAGES] = {8, 4,
+                                                                        2, 2};
+
+// Stopband attenuation of the FIR stages
+constexpr double OVERSAMPLING_FIR_ATTENUATION = 96.0;
+}  // namespace
+
+ADSP_INLINE Oversampler::Oversampler() { designStages(); }
+ADSP_INLINE Oversampler::~Oversampler() {}
+
+ADSP_INLINE void Oversampler::reset(int _maxBlockSize) {
+    maxBlockSize = std::max(_maxBlockSize, 0);
+
+    // All allocation happens here
+    const int maxUpsampled = maxBlockSize << MAX_OVERSAMPLING_STAGES;
+    bufferA.assign(maxUpsampled, 0.0);
+    bufferB.assign(maxUpsampled, 0.0);
+    upsampledBlock = bufferA.data();
+
+    designStages();
+}
+
+ADSP_INLINE double *Oversampler::upsample(const double *in, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    // Refuse blocks that do not fit the buffers, and calls before reset()
+    if (!fitsBuffers(numSamples)) {
+        return nullptr;
+    }
+
+    // Bypass
+    if (numStages == 0) {
+        memcpy(bufferA.data(), in, sizeof(double) * numSamples);
+        upsampledBlock = bufferA.data();
+        return upsampledBlock;
+    }
+
+    const double *src = in;
+    double *dst = nullptr;
+
+    for (int stage = 0; stage < numStages; ++stage) {
+        // Alternate between the two intermediate buffers
+        dst = (stage % 2 == 0) ? bufferA.data() : bufferB.data();
+
+        const int numStageSamples = numSamples << stage;
+        if (params.filterType == oversamplingFilter::iir) {
+            upIir[stage].upsample(src, dst, numStageSamples);
+        } else {
+            upFir[stage].upsample(src, dst, numStageSamples);
+        }
+
+        src = dst;
+    }
+
+    upsampledBlock = dst;
+    return upsampledBlock;
+}
+
+ADSP_INLINE void Oversampler::downsample(double *out, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (!fitsBuffers(numSamples)) {
+        return;
+    }
+
+    // Bypass
+    if (numStages == 0) {
+        memcpy(out, upsampledBlock, sizeof(double) * numSamples);
+        return;
+    }
+
+    // Stages downsample in place, the last one writes to the output
+    for (int stage = numStages - 1; stage >= 0; --stage) {
+        double *dst = stage == 0 ? out : upsampledBlock;
+
+        const int numStageSamples = numSamples << stage;
+        if (params.filterType == oversamplingFilter::iir) {
+            downIir[stage].downsample(upsampledBlock, dst, numStageSamples);
+        } else {
+            downFir[stage].downsample(upsampledBlock, dst, numStageSamples);
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE double Oversampler::getLatency() {
+    double latency = 0.0;
+
+    // Stage latencies are in samples at the stage's lower rate
+    for (int stage = 0; stage < numStages; ++stage) {
+        double stageLatency = 0.0;
+        if (params.filterType == oversamplingFilter::iir) {
+            stageLatency = upIir[stage].getUpsamplingLatency() +
+                           downIir[stage].getDownsamplingLatency();
+        } else {
+            stageLatency = upFir[stage].getUpsamplingLatency() +
+                           downFir[stage].getDownsamplingLatency();
+        }
+
+        latency += stageLatency / static_cast<double>(1 << stage);
+    }
+
+    return latency;
+}
+
+ADSP_INLINE int Oversampler::getFactor() { return 1 << numStages; }
+
+ADSP_INLINE OversamplerParams Oversampler::getParameters() { return params; }
+
+ADSP_INLINE void Oversampler::setParameters(
+    const OversamplerParams &parameters) {
+    // If new parameters differ..
+    if (params.factor != parameters.factor ||
+        params.filterType != parameters.filterType) {
+        // Update the parameters
+        params = parameters;
+
+        // Redesign stages with new parameters
+        designStages();
+    } else {
+        // Otherwise do nothing
+        return;
+    }
+}
+
+ADSP_INLINE bool Oversampler::fitsBuffers(int numSamples) {
+    return numSamples >= 0 && numSamples <= maxBlockSize && !bufferA.empty();
+}
+
+ADSP_INLINE void Oversampler::designStages() {
+    // Largest power of two not above the requested factor, within [1, 16]
+    numStages = 0;
+    while (numStages < MAX_OVERSAMPLING_STAGES &&
+           (2 << numStages) <= params.factor) {
+        ++numStages;
+    }
+
+    for (int stage = 0; stage < numStages; ++stage) {
+        if (params.filterType == oversamplingFilter::iir) {
+            upIir[stage].setup(OVERSAMPLING_IIR_COEFFICIENTS[stage],
+                               OVERSAMPLING_TRANSITION[stage]);
+            downIir[stage].setup(OVERSAMPLING_IIR_COEFFICIENTS[stage],
+                                 OVERSAMPLING_TRANSITION[stage]);
+        } else {
+            upFir[stage].setup(OVERSAMPLING_TRANSITION[stage],
+                               OVERSAMPLING_FIR_ATTENUATION);
+            downFir[stage].setup(OVERSAMPLING_TRANSITION[stage],
+                                 OVERSAMPLING_FIR_ATTENUATION);
+        }
+    }
+}
+}  // namespace adsp
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+    Oversampler.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Oversampler.h
+*
+* @brief 2x/4x/8x/16x oversampling built from cascaded halfband stages
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "HalfbandFir.h"
+#include "HalfbandIir.h"
+
+namespace adsp {
+/**
+* @brief Maximum number of 2x stages (16x oversampling)
+*/
+constexpr int MAX_OVERSAMPLING_STAGES = 4;
+
+/**
+* @brief Filter structure used by the halfband stages
+*/
+enum class oversamplingFilter {
+    iir,  // Polyphase allpass halfbands, low latency, non-linear phase
+    fir   // Linear phase halfbands, higher latency
+};
+
+/**
+* @brief Oversampler parameter structure
+*
+*/
+struct OversamplerParams {
+    OversamplerParams() {}
+
+    OversamplerParams &operator=(const OversamplerParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            factor = parameters.factor;
+            filterType = parameters.filterType;
+            return *this;
+        }
+    }
+
+    // Oversampling factor: 1 (bypass), 2, 4, 8 or 16
+    int factor = 2;
+
+    // Halfband filter structure
+    oversamplingFilter filterType = oversamplingFilter::iir;
+};
+
+//==============================================================================
+
+/**
+* @brief Up- and downsampler for running nonlinear stages at a higher sample rate
+*
+* Each 2x stage is a halfband filter. The first stage carries the steep transition band,
+* later stages only have to reject images above the original Nyquist frequency and are
+* therefore much cheaper.
+* All buffers are allocated in reset(), processing blocks never allocates.
+*
+* Typical use around a nonlinearity:
+*
+*     oversampler.process(block, numSamples, [](double x) { return adsp::clip(x); });
+*/
+class Oversampler {
+   public:
+    Oversampler();
+    ~Oversampler();
+
+    //==============================================================================
+
+    /**
+    * @brief Design the stages, allocate buffers and clear internal state
+    *
+    * @param maxBlockSize Largest number of samples (at the original rate) passed per block
+    */
+    void reset(int maxBlockSize);
+
+    /**
+    * @brief Upsample a block into the internal buffer
+    *
+    * Blocks larger than maxBlockSize, and all blocks before reset(), are rejected:
+    * nothing is processed and nullptr is returned.
+    *
+    * @param in Input block at the original sample rate
+    * @param numSamples Number of input samples, at most maxBlockSize
+    * @return Internal buffer holding numSamples * factor samples, may be processed in
+    * place, nullptr if the block was rejected
+    */
+    double *upsample(const double *in, int numSamples);
+
+    /**
+    * @brief Downsample the internal buffer filled by the previous upsample() call
+    *
+    * Blocks rejected by upsample() are rejected here as well, out is not written.
+    *
+    * @param out Output block at the original sample rate
+    * @param numSamples Number of output samples, same as passed to upsample()
+    */
+    void downsample(double *out, int numSamples);
+
+    /**
+    * @brief Run a per-sample function oversampled on a block, in place
+    *
+    * Rejected blocks (see upsample()) are left unchanged.
+    *
+    * @tparam Function Callable taking and returning a double
+    * @param block Block at the original sample rate
+    * @param numSamples Number of samples, at most maxBlockSize
+    * @param function Function applied to every upsampled sample
+    */
+    template <typename Function>
+    void process(double *block, int numSamples, Function function) {
+        double *upsampled = upsample(block, numSamples);
+        if (upsampled == nullptr) {
+            return;
+        }
+
+        const int numUpsampled = numSamples * getFactor();
+        for (int n = 0; n < numUpsampled; ++n) {
+            upsampled[n] = function(upsampled[n]);
+        }
+
+        downsample(block, numSamples);
+    }
+
+    //==============================================================================
+
+    /**
+    * @brief Get round trip latency (upsampling and downsampling)
+    *
+    * For IIR stages this is the group delay at DC.
+    *
+    * @return Latency in samples at the original sample rate
+    */
+    double getLatency();
+
+    /**
+    * @brief Get oversampling factor
+    *
+    * @return Factor currently in use
+    */
+    int getFactor();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Oversampler parameters
+    */
+    OversamplerParams getParameters();
+
+    /**
+    * @brief Set parameters, redesigns the stages if anything changed
+    *
+    * @param parameters New oversampler parameters
+    */
+    void setParameters(const OversamplerParams &parameters);
+
+   protected:
+    /**
+    * @brief Check a block size against the buffers allocated in reset()
+    *
+    * @param numSamples Number of samples at the original rate
+    * @return True if the buffers hold the upsampled block
+    */
+    bool fitsBuffers(int numSamples);
+
+    /**
+    * @brief Set up the halfband stages for the current parameters
+    */
+    void designStages();
+
+    /**
+    * @brief Oversampler parameters
+    */
+    OversamplerParams params;
+
+    /**
+    * @brief Number of 2x stages in use
+    */
+    int numStages{1};
+
+    /**
+    * @brief Largest block size at the original rate
+    */
+    int maxBlockSize{0};
+
+    /**
+    * @brief Intermediate buffers, used in alternation by the stages
+    */
+    std::vector<double> bufferA;
+    std::vector<double> bufferB;
+
+    /**
+    * @brief Buffer holding the result of the last upsample() call
+    */
+    double *upsampledBlock{nullptr};
+
+    /**
+    * @brief Halfband stages, index 0 is the stage at the original rate
+    */
+    HalfbandIir upIir[MAX_OVERSAMPLING_STAGES];
+    HalfbandIir downIir[MAX_OVERSAMPLING_STAGES];
+    HalfbandFir upFir[MAX_OVERSAMPLING_STAGES];
+    HalfbandFir downFir[MAX_OVERSAMPLING_STAGES];
+};
+}  // namespace adsp
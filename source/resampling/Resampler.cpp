@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+    Resampler.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+#include "Resampler.h"
+#include "../utility/inline.h"
+
+namespace adsp {
+namespace {
+// Zeroth-order modified Bessel function of the first kind (power series)
+double resamplerBesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = 0.5 * x;
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+
+// Number of partial sums in the inner loop, all tap counts are a multiple of it
+constexpr int RESAMPLER_LANES = 4;
+
+// Kernel length, table resolution and Kaiser beta of the quality presets
+struct ResamplerPreset {
+    int numTaps;
+    int numPhases;
+    double beta;
+};
+
+ResamplerPreset getResamplerPreset(resamplerQuality quality) {
+    switch (quality) {
+        case resamplerQuality::draft: {
+            return {16, 128, 5.65};
+        }
+        case resamplerQuality::high: {
+            return {128, 512, 11.9};
+        }
+        case resamplerQuality::normal:
+        default: {
+            return {64, 256, 8.96};
+        }
+    }
+}
+}  // namespace
+
+ADSP_INLINE Resampler::Resampler() {}
+ADSP_INLINE Resampler::~Resampler() {}
+
+ADSP_INLINE void Resampler::reset(int _maxBlockSize) {
+    maxBlockSize = _maxBlockSize;
+
+    ratio = params.outputSampleRate / params.inputSampleRate;
+    step = 1.0 / ratio;
+
+    designKernel();
+}
+
+ADSP_INLINE int Resampler::process(const double *in, int numInputSamples,
+                                   double *out, int maxOutputSamples) {
+    ADSP_REALTIME_SECTION();
+
+    // Refuse blocks that do not fit, without consuming any input
+    if (numInputSamples < 0 || numInputSamples > maxBlockSize ||
+        maxOutputSamples < getMaxOutputSamples(numInputSamples)) {
+        return -1;
+    }
+
+    // Append new block behind the past samples
+    memcpy(&history[numTaps], in, sizeof(double) * numInputSamples);
+
+    const int halfTaps = numTaps / 2;
+    const double *kernelTable = kernel.data();
+
+    // Last read position for which all taps are available
+    const double end = static_cast<double>(halfTaps + numInputSamples);
+
+    int numOutputSamples = 0;
+    while (time < end) {
+        const int index = static_cast<int>(time);
+        const double phase = (time - index) * numPhases;
+        const int row = static_cast<int>(phase);
+        const double frac = phase - row;
+
+        const double *x = &history[index - halfTaps + 1];
+        const double *h0 = &kernelTable[row * numTaps];
+        const double *h1 = h0 + numTaps;
+
+        // Dot products with the two neighbouring phases.
+        // Independent partial sums let the compiler keep them in vector lanes
+        // without reordering floating point additions.
+        double sum0[RESAMPLER_LANES] = {};
+        double sum1[RESAMPLER_LANES] = {};
+        for (int k = 0; k < numTaps; k += RESAMPLER_LANES) {
+            for (int lane = 0; lane < RESAMPLER_LANES; ++lane) {
+                sum0[lane] += x[k + lane] * h0[k + lane];
+                sum1[lane] += x[k + lane] * h1[k + lane];
+            }
+        }
+
+        double y0 = 0.0;
+        double y1 = 0.0;
+        for (int lane = 0; lane < RESAMPLER_LANES; ++lane) {
+            y0 += sum0[lane];
+            y1 += sum1[lane];
+        }
+
+        out[numOutputSamples++] = y0 + frac * (y1 - y0);
+
+        time += step;
+    }
+
+    // Keep the last numTaps samples for the next block
+    memmove(&history[0], &history[numInputSamples], sizeof(double) * numTaps);
+    time -= numInputSamples;
+
+    return numOutputSamples;
+}
+
+//==============================================================================
+
+ADSP_INLINE void Resampler::setRatio(double _ratio) {
+    ratio = _ratio;
+    step = 1.0 / ratio;
+}
+
+ADSP_INLINE double Resampler::getRatio() { return ratio; }
+
+ADSP_INLINE int Resampler::getMaxOutputSamples(int numInputSamples) {
+    return static_cast<int>(ceil(numInputSamples * ratio)) + 2;
+}
+
+ADSP_INLINE double Resampler::getLatency() { return 0.5 * numTaps; }
+
+ADSP_INLINE ResamplerParams Resampler::getParameters() { return params; }
+
+ADSP_INLINE void Resampler::setParameters(const ResamplerParams &parameters) {
+    // If new parameters differ..
+    if (params.inputSampleRate != parameters.inputSampleRate ||
+        params.outputSampleRate != parameters.outputSampleRate ||
+        params.quality != parameters.quality) {
+        // Update the parameters
+        params = parameters;
+
+        // Redesign with new parameters
+        reset(maxBlockSize);
+    } else {
+        // Otherwise do nothing
+        return;
+    }
+}
+
+ADSP_INLINE void Resampler::designKernel() {
+    const ResamplerPreset preset = getResamplerPreset(params.quality);
+    numTaps = preset.numTaps;
+    numPhases = preset.numPhases;
+
+    // Cutoff at the lower of both Nyquist frequencies, normalized to the input rate
+    const double nominalRatio =
+        params.outputSampleRate / params.inputSampleRate;
+    const double cutoff = 0.5 * (nominalRatio < 1.0 ? nominalRatio : 1.0);
+
+    const int halfTaps = numTaps / 2;
+    const double i0Beta = resamplerBesselI0(preset.beta);
+
+    // One extra row so that interpolation between phases never wraps
+    kernel.assign((numPhases + 1) * numTaps, 0.0);
+    for (int row = 0; row <= numPhases; ++row) {
+        const double frac = static_cast<double>(row) / numPhases;
+
+        for (int k = 0; k < numTaps; ++k) {
+            // Distance between output position and input sample
+            const double t = (halfTaps - 1 - k) + frac;
+
+            const double arg = 2.0 * cutoff * t;
+            const double sinc =
+                fabs(arg) < 1e-12 ? 1.0 : sin(PI * arg) / (PI * arg);
+
+            const double ratioToEdge = t / halfTaps;
+            const double window =
+                fabs(ratioToEdge) >= 1.0
+                    ? 0.0
+                    : resamplerBesselI0(preset.beta *
+                                        sqrt(1.0 - ratioToEdge * ratioToEdge)) /
+                          i0Beta;
+
+            kernel[row * numTaps + k] = 2.0 * cutoff * sinc * window;
+        }
+    }
+
+    // Clear state, first output is centered half a kernel before the first input
+    history.assign(numTaps + maxBlockSize, 0.0);
+    time = static_cast<double>(halfTaps);
+}
+}  // namespace adsp
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+    Smoother.cpp
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Smoother.cpp
+*
+* @brief One-pole and linear parameter smoothing with block output
+*/
+
+#include "Smoother.h"
+#include "inline.h"
+
+namespace adsp {
+ADSP_INLINE Smoother::Smoother() {}
+ADSP_INLINE Smoother::~Smoother() {}
+
+//==============================================================================
+
+ADSP_INLINE void Smoother::reset(double _sampleRate, double value) {
+    sampleRate = _sampleRate;
+    setValue(value);
+}
+
+ADSP_INLINE void Smoother::setTarget(double _target) {
+    if (_target == target) {
+        return;
+    }
+
+    target = _target;
+    startRamp();
+}
+
+ADSP_INLINE void Smoother::setValue(double value) {
+    current = value;
+    target = value;
+    remaining = 0;
+}
+
+//==============================================================================
+
+ADSP_INLINE double Smoother::getNext() {
+    if (remaining == 0) {
+        return current;
+    }
+
+    --remaining;
+    if (remaining == 0) {
+        current = target;
+    } else if (params.type == smoothingType::linear) {
+        current += step;
+    } else {
+        current = coefficient * (current - target) + target;
+    }
+
+    return current;
+}
+
+ADSP_INLINE bool Smoother::processBlock(double *out, int numSamples) {
+    ADSP_REALTIME_SECTION();
+
+    if (remaining <= 0 || numSamples <= 0) {
+        return false;
+    }
+
+    // Samples still moving in this block, the rest is the target
+    const int numMoving = std::min(numSamples, remaining);
+
+    if (params.type == smoothingType::linear) {
+        // From the start value, no accumulated rounding and no dependency
+        const double start = current;
+        for (int n = 0; n < numMoving; ++n) {
+            out[n] = start + (n + 1) * step;
+        }
+    } else {
+        double distance = current - target;
+        for (int n = 0; n < numMoving; ++n) {
+            distance *= coefficient;
+            out[n] = target + distance;
+        }
+    }
+
+    remaining -= numMoving;
+    if (remaining == 0) {
+        out[numMoving - 1] = target;
+    }
+    for (int n = numMoving; n < numSamples; ++n) {
+        out[n] = target;
+    }
+
+    current = out[numSamples - 1];
+    return true;
+}
+
+ADSP_INLINE double Smoother::skip(int numSamples) {
+    if (remaining == 0) {
+        return current;
+    }
+
+    if (numSamples >= remaining) {
+        current = target;
+        remaining = 0;
+    } else if (params.type == smoothingType::linear) {
+        current += numSamples * step;
+        remaining -= numSamples;
+    } else {
+        current = target + (current - target) * pow(coefficient, numSamples);
+        remaining -= numSamples;
+    }
+
+    return current;
+}
+
+//==============================================================================
+
+ADSP_INLINE bool Smoother::isSmoothing() { return remaining > 0; }
+
+ADSP_INLINE double Smoother::getCurrent() { return current; }
+
+ADSP_INLINE double Smoother::getTarget() { return target; }
+
+ADSP_INLINE SmootherParams Smoother::getParameters() { return params; }
+
+ADSP_INLINE void Smoother::setParameters(const SmootherParams &parameters) {
+    // If new parameters differ..
+    if (parameters.type != params.type || parameters.time != params.time) {
+        params = parameters;
+
+        if (remaining > 0) {
+            startRamp();
+        }
+    }
+}
+
+//==============================================================================
+
+ADSP_INLINE void Smoother::startRamp() {
+    const double samples = params.time * 0.001 * sampleRate;
+
+    if (params.type == smoothingType::linear) {
+        remaining = std::max(1, static_cast<int>(lround(samples)));
+        step = (target - current) / remaining;
+    } else {
+        // Time constants until the residual is left
+        const double timeConstant = std::max(samples, 1e-3);
+        coefficient = exp(-1.0 / timeConstant);
+        remaining = std::max(
+            1, static_cast<int>(
+                   ceil(-log(SMOOTHER_ONE_POLE_RESIDUAL) * timeConstant)));
+    }
+}
+}  // namespace adsp
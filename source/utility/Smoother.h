@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+    Smoother.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+* @file Smoother.h
+*
+* @brief One-pole and linear parameter smoothing with block output
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "../debug/RealtimeCheck.h"
+
+namespace adsp {
+/**
+* @brief Fraction of a step the one-pole smoother leaves before it snaps to the target
+*/
+constexpr double SMOOTHER_ONE_POLE_RESIDUAL = 1e-4;
+
+/**
+* @brief Smoothing curves
+*/
+enum class smoothingType {
+    linear,  // Constant slope, reaches the target after the smoothing time
+    onePole  // Exponential approach, the smoothing time is the time constant
+};
+
+/**
+* @brief Smoother parameter structure
+*
+*/
+struct SmootherParams {
+    SmootherParams() {}
+
+    SmootherParams &operator=(const SmootherParams &parameters) {
+        if (this == &parameters) {
+            return *this;
+        } else {
+            type = parameters.type;
+            time = parameters.time;
+            return *this;
+        }
+    }
+
+    // Smoothing curve
+    smoothingType type = smoothingType::linear;
+
+    // Ramp length (linear) or time constant (one-pole)
+    double time = 20.0;  // ms
+};
+
+//==============================================================================
+
+/**
+* @brief Smooths a parameter towards its target value
+*
+* Parameters of the filter wrappers are applied instantly by setParameters(). To glide
+* a parameter, set the smoother's target and pass the smoothed value on while
+* isSmoothing() returns true, e.g. once per sub-block:
+*
+*     fcSmoother.setTarget(newFc);
+*     ...
+*     if (fcSmoother.isSmoothing()) {
+*         params.fc = fcSmoother.skip(subBlockSize);
+*         filter.setParameters(params);
+*     }
+*
+* Both curves count the samples until the target is reached. The one-pole curve
+* snaps to the target once SMOOTHER_ONE_POLE_RESIDUAL of the step is left. A settled
+* smoother costs one comparison per call: processBlock() then returns without
+* writing, getNext() returns the stored value.
+*/
+class Smoother {
+   public:
+    Smoother();
+    ~Smoother();
+
+    //==============================================================================
+
+    /**
+    * @brief Set sample rate and jump to a value
+    *
+    * @param sampleRate New sample rate
+    * @param value Current and target value
+    */
+    void reset(double sampleRate, double value = 0.0);
+
+    /**
+    * @brief Start smoothing towards a new target
+    *
+    * Real-time safe. Setting the current target again does not restart the ramp.
+    *
+    * @param target Target value
+    */
+    void setTarget(double target);
+
+    /**
+    * @brief Jump to a value without smoothing
+    *
+    * @param value Current and target value
+    */
+    void setValue(double value);
+
+    //==============================================================================
+
+    /**
+    * @brief Advance by one sample
+    *
+    * @return Smoothed value
+    */
+    double getNext();
+
+    /**
+    * @brief Write the smoothed values of a block
+    *
+    * Settled smoothers return immediately, the caller uses getCurrent() as a constant
+    * for the whole block. The linear ramp is written without a loop-carried
+    * dependency, the compiler can vectorize it.
+    *
+    * @param out Output block, untouched if the smoother is settled
+    * @param numSamples Number of samples
+    * @return true if out was written, false if the value is constant
+    */
+    bool processBlock(double *out, int numSamples);
+
+    /**
+    * @brief Advance by a number of samples without writing them
+    *
+    * @param numSamples Number of samples
+    * @return Smoothed value after the last sample
+    */
+    double skip(int numSamples);
+
+    //==============================================================================
+
+    /**
+    * @brief Check whether the value is still moving
+    *
+    * @return true until the target is reached
+    */
+    bool isSmoothing();
+
+    /**
+    * @brief Get the current value
+    *
+    * @return Value after the last processed sample
+    */
+    double getCurrent();
+
+    /**
+    * @brief Get the target value
+    *
+    * @return Target value
+    */
+    double getTarget();
+
+    /**
+    * @brief Get parameters
+    *
+    * @return Smoother parameters
+    */
+    SmootherParams getParameters();
+
+    /**
+    * @brief Set parameters
+    *
+    * A running ramp continues from its current value with the new curve.
+    *
+    * @param parameters New smoother parameters
+    */
+    void setParameters(const SmootherParams &parameters);
+
+   protected:
+    /**
+    * @brief Restart the curve from the current value
+    */
+    void startRamp();
+
+    /**
+    * @brief Smoother parameters
+    */
+    SmootherParams params;
+
+    /**
+    * @brief Sample rate
+    */
+    double sampleRate{48000.0};
+
+    /**
+    * @brief Current and target value
+    */
+    double current{0.0};
+    double target{0.0};
+
+    /**
+    * @brief Linear increment per sample, one-pole coefficient
+    */
+    double step{0.0};
+    double coefficient{0.0};
+
+    /**
+    * @brief Samples until the target is reached, 0 when settled
+    */
+    int remaining{0};
+};
+}  // namespace adsp
@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+    saturation.h
+
+    Copyright (C) 2022 Butch Warns
+    All rights reserved.
+
+    contact@butchwarns.de
+
+    BSD 2-Clause License
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+        list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+        and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  ==============================================================================
+*/
+
+/**
+ * @file saturation.h
+ *
+ * @brief Fast saturation curves and their antiderivatives
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "utility.h"
+
+namespace adsp {
+//==============================================================================
+// Fast function approximations
+
+/**
+* @brief Faster (and less precise) hyperbolic tangent
+*
+* [9/8] rational approximation (continued fraction of tanh), the input is clamped
+* where the approximation reaches 1. Absolute error < 7e-6, monotonic, odd and
+* bounded by 1. No branches, loops over blocks vectorize.
+*
+* @param x Input value
+* @return tanh(x)
+*/
+inline double fastTanh(double x) {
+    // The rational function reaches 1 just above
+    x = clip(x, -6.297, 6.297);
+
+    const double x2 = x * x;
+    const double numerator =
+        x *
+        (34459425.0 + x2 * (4729725.0 + x2 * (135135.0 + x2 * (990.0 + x2))));
+    const double denominator =
+        34459425.0 +
+        x2 * (16216200.0 + x2 * (945945.0 + x2 * (13860.0 + x2 * 45.0)));
+
+    return numerator / denominator;
+}
+
+/**
+* @brief Faster (and less precise) arc tangent
+*
+* Reduces |x| to [0, tan(pi/12)] with atan(x) = pi/2 - atan(1/x) and
+* atan(t) = pi/6 + atan((t - 1/sqrt(3)) / (1 + t/sqrt(3))), then evaluates the Taylor
+* series up to t^15. Absolute error < 1e-10.
+*
+* @param x Input value
+* @return atan(x) [rad]
+*/
+inline double fastAtan(double x) {
+    const double frac1Sqrt3 = 0.57735026918962576451;  // 1 / sqrt(3)
+
+    double t = fabs(x);
+
+    const bool inverted = t > 1.0;
+    t = inverted ? 1.0 / t : t;
+
+    const bool shifted = t > 0.26794919243112270647;  // tan(pi / 12)
+    t = shifted ? (t - frac1Sqrt3) / (1.0 + t * frac1Sqrt3) : t;
+
+    const double t2 = t * t;
+    double p = -1.0 / 15.0;
+    p = p * t2 + 1.0 / 13.0;
+    p = p * t2 - 1.0 / 11.0;
+    p = p * t2 + 1.0 / 9.0;
+    p = p * t2 - 1.0 / 7.0;
+    p = p * t2 + 1.0 / 5.0;
+    p = p * t2 - 1.0 / 3.0;
+    p = p * t2 + 1.0;
+    double y = p * t;
+
+    y = shifted ? y + PI / 6.0 : y;
+    y = inverted ? 0.5 * PI - y : y;
+
+    return copysign(y, x);
+}
+
+//==============================================================================
+// Saturation curves
+//
+// All curves have unity slope at 0, the symmetric ones saturate at +-1.
+// Each curve comes with its antiderivative (zero at 0) for antiderivative
+// anti-aliasing, see Saturator.
+
+/**
+* @brief Saturation curves
+*
+* | Shape | Curve                                    | Character                  |
+* |-------|------------------------------------------|----------------------------|
+* | hard  | clip(x)                                  | Hard edge, reference       |
+* | tanh  | tanh(x)                                  | Smooth, odd harmonics      |
+* | atan  | 2/pi * atan(pi/2 * x)                    | Softest, slow approach     |
+* | cubic | x - 4/27 x^3, reaches +-1 at x = +-3/2    | Cheapest soft curve        |
+* | diode | 1/2 (1 - e^-2x) above 0, e^x - 1 below 0 | Asymmetric, even harmonics |
+*/
+enum class saturationShape { hard, tanh, atan, cubic, diode };
+
+/**
+* @brief Hyperbolic tangent saturation, see fastTanh()
+*/
+inline double softClipTanh(double x) { return fastTanh(x); }
+
+/**
+* @brief Antiderivative of softClipTanh(): log(cosh(x))
+*/
+inline double softClipTanhIntegral(double x) {
+    // log(cosh(x)) = |x| - log(2) + log(1 + e^-2|x|)
+    const double ax = fabs(x);
+    const double e = fastExp2(-2.88539008177792681472 * ax);  // -2 / ln(2)
+    return ax + 0.69314718055994530942 * (fastLog2(1.0 + e) - 1.0);
+}
+
+/**
+* @brief Arc tangent saturation, scaled to unity slope and +-1 limits
+*/
+inline double softClipAtan(double x) {
+    return (2.0 / PI) * fastAtan(0.5 * PI * x);
+}
+
+/**
+* @brief Antiderivative of softClipAtan()
+*/
+inline double softClipAtanIntegral(double x) {
+    // a = pi/2: 2/pi * (x * atan(a x) - log(1 + a^2 x^2) / (2a))
+    const double ax = 0.5 * PI * x;
+    return (2.0 / PI) * (x * fastAtan(ax) -
+                         0.69314718055994530942 * fastLog2(1.0 + ax * ax) / PI);
+}
+
+/**
+* @brief Cubic saturation, exact polynomial
+*/
+inline double softClipCubic(double x) {
+    x = clip(x, -1.5, 1.5);
+    return x * (1.0 - (4.0 / 27.0) * x * x);
+}
+
+/**
+* @brief Antiderivative of softClipCubic()
+*/
+inline double softClipCubicIntegral(double x) {
+    const double ax = fabs(x);
+    const double c = fmin(ax, 1.5);
+    const double c2 = c * c;
+
+    // Polynomial part up to 3/2, then the line of slope 1
+    return c2 * (0.5 - (1.0 / 27.0) * c2) + (ax - c);
+}
+
+/**
+* @brief Asymmetric diode-style saturation
+*
+* Saturates at 0.5 for positive and at -1 for negative input, see fastExp2()
+* (relative error < 1e-8).
+*/
+inline double softClipDiode(double x) {
+    // e^x = 2^(x / ln(2))
+    return x > 0.0 ? 0.5 - 0.5 * fastExp2(-2.88539008177792681472 * x)
+                   : fastExp2(1.44269504088896340736 * x) - 1.0;
+}
+
+/**
+* @brief Antiderivative of softClipDiode()
+*/
+inline double softClipDiodeIntegral(double x) {
+    return x > 0.0 ? 0.5 * x + 0.25 * fastExp2(-2.88539008177792681472 * x) -
+                         0.25
+                   : fastExp2(1.44269504088896340736 * x) - 1.0 - x;
+}
+
+/**
+* @brief Antiderivative of clip()
+*/
+inline double hardClipIntegral(double x) {
+    const double ax = fabs(x);
+    return ax <= 1.0 ? 0.5 * x * x : ax - 0.5;
+}
+
+//==============================================================================
+
+/**
+* @brief Evaluate a saturation curve
+*
+* @param shape Saturation curve
+* @param x Input value
+* @return Saturated value
+*/
+inline double softClip(saturationShape shape, double x) {
+    switch (shape) {
+        case saturationShape::hard: {
+            return clip(x);
+        }
+        case saturationShape::tanh: {
+            return softClipTanh(x);
+        }
+        case saturationShape::atan: {
+            return softClipAtan(x);
+        }
+        case saturationShape::cubic: {
+            return softClipCubic(x);
+        }
+        default: {
+            return softClipDiode(x);
+        }
+    }
+}
+
+/**
+* @brief Evaluate the antiderivative of a saturation curve
+*
+* @param shape Saturation curve
+* @param x Input value
+* @return Antiderivative at x, zero at 0
+*/
+inline double softClipIntegral(saturationShape shape, double x) {
+    switch (shape) {
+        case saturationShape::hard: {
+            return hardClipIntegral(x);
+        }
+        case saturationShape::tanh: {
+            return softClipTanhIntegral(x);
+        }
+        case saturationShape::atan: {
+            return softClipAtanIntegral(x);
+        }
+        case saturationShape::cubic: {
+            return softClipCubicIntegral(x);
+        }
+        default: {
+            return softClipDiodeIntegral(x);
+        }
+    }
+}
+
+/**
+* @brief Saturate a block
+*
+* The shape is selected once per block, the loops over the samples contain no calls.
+* The compiler can vectorize them for the branch-free curves (hard, tanh, cubic).
+*
+* @param shape Saturation curve
+* @param in Input block
+* @param out Output block, may equal in
+* @param numSamples Number of samples
+*/
+inline void softClipBlock(saturationShape shape, const double *in, double *out,
+                          int numSamples) {
+    switch (shape) {
+        case saturationShape::hard: {
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = clip(in[n]);
+            }
+            break;
+        }
+        case saturationShape::tanh: {
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = softClipTanh(in[n]);
+            }
+            break;
+        }
+        case saturationShape::atan: {
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = softClipAtan(in[n]);
+            }
+            break;
+        }
+        case saturationShape::cubic: {
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = softClipCubic(in[n]);
+            }
+            break;
+        }
+        default: {
+            for (int n = 0; n < numSamples; ++n) {
+                out[n] = softClipDiode(in[n]);
+            }
+            break;
+        }
+    }
+}
+}  // namespace adsp
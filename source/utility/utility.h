@@ -41,6 +41,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace adsp {
 //==============================================================================
@@ -66,12 +68,14 @@ constexpr double FRAC_ONE_PI = 1.0 / PI;  // 1 / PI
 /**
 * @brief @f$ \sqrt{2} @f$
 */
-const double SQRT_TWO = pow(2.0, 0.5);
+constexpr double SQRT_TWO =
+    1.41421356237309504880168872420969807856967187537694807317667973799;
 
 /**
 * @brief @f$ 1/\sqrt{2} @f$
 */
-const double FRAC_ONE_SQRT_TWO = pow(2.0, -0.5);  // 1 / sqrt(2)
+constexpr double FRAC_ONE_SQRT_TWO =
+    0.707106781186547524400844362104849039284835937688474036588339868995;
 
 /**
 * @brief Smallest positive float value
@@ -136,6 +140,30 @@ inline bool fixUnderflow(double &d) {
     return false;
 }
 
+/**
+* @brief Fix float underflows to avoid denormals
+*
+* @param f float value to be checked for possible underflow
+* @return true if underflow was fixed
+* @return false if no underflow occured
+*/
+inline bool fixUnderflow(float &f) {
+    // Positive underflow
+    if (f > 0.0f && f < static_cast<float>(MIN_FLOAT_VAL_POS)) {
+        // Fix to zero
+        f = 0.0f;
+        return true;
+    }
+    // Negative underflow
+    else if (f < 0.0f && f > static_cast<float>(MIN_FLOAT_VAL_NEG)) {
+        // Fix to zero
+        f = 0.0f;
+        return true;
+    }
+
+    return false;
+}
+
 //==============================================================================
 // Clipping
 
@@ -430,4 +458,138 @@ inline float fastLog2(float val) {
     log_2 += ((-0.34484843f) * u.val + 2.02466578f) * u.val - 0.67487759f;
     return (log_2);
 }
+
+/**
+* @brief Fast log2 in double precision
+*
+* Splits x into exponent and mantissa, the mantissa is reduced to [sqrt(0.5), sqrt(2)[
+* and the logarithm is evaluated with the atanh series in s = (m - 1) / (m + 1) up to
+* s^13 (absolute error < 1e-12). The error is a smooth function of x, differences of
+* close values (e.g. in antiderivative anti-aliasing) stay accurate.
+* Only valid for positive, normal x.
+*
+* @param x Input value
+* @return log2(x)
+*/
+inline double fastLog2(double x) {
+    int64_t bits;
+    memcpy(&bits, &x, sizeof(double));
+
+    // Unbiased exponent, mantissa in [1, 2[
+    double exponent = static_cast<double>(((bits >> 52) & 0x7ff) - 1023);
+    bits = (bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL;
+    double m;
+    memcpy(&m, &bits, sizeof(double));
+
+    // Center the mantissa around 1
+    if (m > 1.41421356237309504880) {
+        m *= 0.5;
+        exponent += 1.0;
+    }
+
+    // ln(m) = 2 * atanh(s)
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    double p = 1.0 / 13.0;
+    p = p * s2 + 1.0 / 11.0;
+    p = p * s2 + 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    p = p * s2 + 1.0;
+
+    return exponent + 2.0 * s * p * 1.44269504088896340736;  // 1 / ln(2)
+}
+
+/**
+* @brief Faster (and less precise) 2^x
+*
+* Splits x into the nearest integer and a fraction in [-0.5, 0.5]. The fraction is
+* evaluated with a degree 7 Taylor polynomial (relative error < 1e-8, exact for
+* integer x), the integer part is written into the exponent bits. Results are
+* flushed to zero below 2^-1022 and overflow to infinity from 2^1023.5.
+*
+* @param x Exponent
+* @return 2^x
+*/
+inline double fastExp2(double x) {
+    // Outside of the normal range
+    if (x < -1022.0) {
+        return 0.0;
+    } else if (x >= 1023.5) {
+        return HUGE_VAL;
+    }
+
+    // Nearest integer, exact results for integer x
+    const double integer = floor(x + 0.5);
+    const double t = (x - integer) * 0.69314718055994530942;  // ln(2)
+
+    // e^t, |t| <= ln(2) / 2
+    double p = 1.0 / 5040.0;
+    p = p * t + 1.0 / 720.0;
+    p = p * t + 1.0 / 120.0;
+    p = p * t + 1.0 / 24.0;
+    p = p * t + 1.0 / 6.0;
+    p = p * t + 0.5;
+    p = p * t + 1.0;
+    p = p * t + 1.0;
+
+    // 2^integer, built from the exponent bits
+    const int64_t bits = (static_cast<int64_t>(integer) + 1023) << 52;
+    double scale;
+    memcpy(&scale, &bits, sizeof(double));
+
+    return p * scale;
+}
+
+/**
+* @brief Faster (and less precise) 10^(dB / 20), see fastExp2()
+*
+* @param dB Gain [dB]
+* @return Raw amplitude gain [1]
+*/
+inline double fastDbToRawGain(double dB) {
+    // log2(10) / 20
+    return fastExp2(dB * 0.16609640474436811739);
+}
+
+/**
+* @brief Faster (and less precise) sine function
+*
+* Reduces x to [-pi/2, pi/2] and evaluates a degree 11 Taylor polynomial,
+* absolute error < 6e-8 for |x| < 1e6.
+*
+* @param x Angle [rad]
+* @return sin(x)
+*/
+inline double fastSin(double x) {
+    // Reduce to [-pi, pi]
+    x -= TWO_PI * floor(x * (1.0 / TWO_PI) + 0.5);
+
+    // Fold to [-pi/2, pi/2], sin(pi - x) = sin(x)
+    const double halfPi = 0.5 * PI;
+    if (x > halfPi) {
+        x = PI - x;
+    } else if (x < -halfPi) {
+        x = -PI - x;
+    }
+
+    const double x2 = x * x;
+    double p = -1.0 / 39916800.0;
+    p = p * x2 + 1.0 / 362880.0;
+    p = p * x2 - 1.0 / 5040.0;
+    p = p * x2 + 1.0 / 120.0;
+    p = p * x2 - 1.0 / 6.0;
+    p = p * x2 + 1.0;
+
+    return p * x;
+}
+
+/**
+* @brief Faster (and less precise) cosine function, see fastSin()
+*
+* @param x Angle [rad]
+* @return cos(x)
+*/
+inline double fastCos(double x) { return fastSin(x + 0.5 * PI); }
 }  // namespace adsp
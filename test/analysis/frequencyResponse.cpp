@@ -0,0 +1,83 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <complex>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+//==============================================================================
+// Frequency response
+
+TEST_CASE("Frequency response of biquad coefficient sets", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    adsp::SkLp2 filter;
+    filter.reset(sampleRate);
+    adsp::SkLp2Params params;
+    params.fc = 1000.0;
+    filter.setParameters(params);
+
+    adsp::FrequencyResponse response;
+    response.setLogFrequencies(64, 20.0, 20000.0, sampleRate);
+
+    SECTION("Matches direct evaluation of H(z)")
+    {
+        response.addFilter(filter);
+
+        const double *coefficients = filter.getCoefficients();
+        const double *frequencies = response.getFrequencies();
+        const double *magnitude = response.getMagnitude();
+        const double *phase = response.getPhase();
+
+        for (int i = 0; i < response.getNumFrequencies(); ++i)
+        {
+            const std::complex<double> zInv = std::polar(1.0, -adsp::TWO_PI * frequencies[i] / sampleRate);
+            const std::complex<double> H = (coefficients[adsp::a0] + coefficients[adsp::a1] * zInv + coefficients[adsp::a2] * zInv * zInv) /
+                                           (1.0 + coefficients[adsp::b1] * zInv + coefficients[adsp::b2] * zInv * zInv);
+
+            REQUIRE(magnitude[i] == Approx(std::abs(H)).margin(1e-12));
+            REQUIRE(phase[i] == Approx(std::arg(H)).margin(1e-12));
+        }
+    }
+
+    SECTION("Cascades multiply magnitudes and add group delays")
+    {
+        response.addFilter(filter);
+        const double singledB = response.getMagnitudedB()[10];
+        const double singleDelay = response.getGroupDelay()[10];
+
+        response.addFilter(filter);
+        REQUIRE(response.getMagnitudedB()[10] == Approx(2.0 * singledB));
+        REQUIRE(response.getGroupDelay()[10] == Approx(2.0 * singleDelay));
+
+        response.clear();
+        REQUIRE(response.getMagnitudedB()[10] == 0.0_a);
+    }
+
+    SECTION("Pure delay has a group delay of one sample")
+    {
+        double delay[adsp::numCoefficients] = {0.0, 1.0, 0.0, 0.0, 0.0};
+        response.addBiquad(delay);
+
+        REQUIRE(response.getGroupDelay()[32] == 1.0_a);
+        REQUIRE(response.getMagnitude()[32] == 1.0_a);
+    }
+
+    SECTION("Magnitude in gain and in decibels can be read together")
+    {
+        response.addFilter(filter);
+
+        // Plotting both, each getter keeps its own array
+        const double *magnitude = response.getMagnitude();
+        const double *magnitudedB = response.getMagnitudedB();
+        const double *phase = response.getPhase();
+        REQUIRE(magnitude != magnitudedB);
+        for (int i = 0; i < response.getNumFrequencies(); ++i)
+        {
+            REQUIRE(20.0 * log10(magnitude[i]) == Approx(magnitudedB[i]).margin(1e-9));
+            REQUIRE(std::abs(phase[i]) <= adsp::PI);
+        }
+    }
+}
@@ -0,0 +1,244 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Interleaved sines, channel c at amplitude amplitudes[c]
+    std::vector<double> meterTestSines(const std::vector<double> &amplitudes, double frequency, int numFrames, double sampleRate)
+    {
+        const int numChannels = static_cast<int>(amplitudes.size());
+        std::vector<double> block(numFrames * numChannels);
+        for (int n = 0; n < numFrames; ++n)
+        {
+            const double x = sin(adsp::TWO_PI * frequency * n / sampleRate);
+            for (int c = 0; c < numChannels; ++c)
+            {
+                block[n * numChannels + c] = amplitudes[c] * x;
+            }
+        }
+        return block;
+    }
+
+    // Feeds the interleaved signal in irregular block sizes
+    void meterInterleaved(adsp::MeterBank &meter, const std::vector<double> &block)
+    {
+        const int numChannels = meter.getNumChannels();
+        const int numFrames = static_cast<int>(block.size()) / numChannels;
+        int offset = 0;
+        int blockSize = 100;
+        while (offset < numFrames)
+        {
+            const int numSamples = std::min(blockSize, numFrames - offset);
+            meter.processInterleaved(block.data() + offset * numChannels, numSamples);
+            offset += numSamples;
+            blockSize = blockSize * 7 % 1021 + 1;
+        }
+    }
+}
+
+TEST_CASE("K-weighting matches ITU-R BS.1770 at 48 kHz", "[analysis]")
+{
+    double shelf[adsp::numCoefficients];
+    double highpass[adsp::numCoefficients];
+    adsp::calculateKWeightingCoefficients(shelf, highpass, 48000.0);
+
+    CHECK(shelf[adsp::a0] == Approx(1.53512485958697).margin(1e-10));
+    CHECK(shelf[adsp::a1] == Approx(-2.69169618940638).margin(1e-10));
+    CHECK(shelf[adsp::a2] == Approx(1.19839281085285).margin(1e-10));
+    CHECK(shelf[adsp::b1] == Approx(-1.69065929318241).margin(1e-10));
+    CHECK(shelf[adsp::b2] == Approx(0.73248077421585).margin(1e-10));
+
+    CHECK(highpass[adsp::a0] == 1.0);
+    CHECK(highpass[adsp::a1] == -2.0);
+    CHECK(highpass[adsp::a2] == 1.0);
+    CHECK(highpass[adsp::b1] == Approx(-1.99004745483398).margin(1e-10));
+    CHECK(highpass[adsp::b2] == Approx(0.99007225036621).margin(1e-10));
+}
+
+TEST_CASE("MeterBank levels", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    // Not a multiple of the lane count
+    std::vector<double> amplitudes;
+    for (int c = 0; c < 11; ++c)
+    {
+        amplitudes.push_back(adsp::dbToRawGain(-2.0 * c));
+    }
+    const int numChannels = static_cast<int>(amplitudes.size());
+
+    adsp::MeterBank meter;
+    meter.reset(numChannels, sampleRate);
+    meterInterleaved(meter, meterTestSines(amplitudes, 997.0, 4 * 48000, sampleRate));
+
+    SECTION("Peak and RMS of sines")
+    {
+        std::vector<double> peakdB(numChannels);
+        std::vector<double> rmsdB(numChannels);
+        meter.getLevelsdB(peakdB.data(), rmsdB.data());
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            // Instant attack catches the crest, release sags a little between crests
+            CHECK(peakdB[c] == Approx(-2.0 * c).margin(0.02));
+            CHECK(rmsdB[c] == Approx(-2.0 * c - 3.0103).margin(0.01));
+            CHECK(meter.getPeakdB(c) == peakdB[c]);
+            CHECK(meter.getRmsdB(c) == rmsdB[c]);
+        }
+    }
+
+    SECTION("Loudness of a 1 kHz sine, full scale reads -3.01 LUFS")
+    {
+        for (int c = 0; c < numChannels; ++c)
+        {
+            CHECK(meter.getMomentaryLoudness(c) == Approx(-2.0 * c - 3.01).margin(0.05));
+            CHECK(meter.getShortTermLoudness(c) == Approx(-2.0 * c - 3.01).margin(0.05));
+        }
+    }
+
+    SECTION("Silence decays to the floor")
+    {
+        meterInterleaved(meter, std::vector<double>(4 * 48000 * numChannels, 0.0));
+        for (int c = 0; c < numChannels; ++c)
+        {
+            CHECK(meter.getRmsdB(c) == adsp::METER_MIN_DB);
+            CHECK(meter.getShortTermLoudness(c) < -140.0);
+        }
+    }
+}
+
+TEST_CASE("MeterBank program loudness sums channel energies", "[analysis]")
+{
+    adsp::MeterBank meter;
+    meter.reset(2, 48000.0);
+    meterInterleaved(meter, meterTestSines({0.5, 0.5}, 1000.0, 4 * 48000, 48000.0));
+
+    CHECK(meter.getProgramMomentaryLoudness() == Approx(meter.getMomentaryLoudness(0) + 3.0103).margin(1e-6));
+    CHECK(meter.getProgramShortTermLoudness() == Approx(meter.getShortTermLoudness(0) + 3.0103).margin(1e-6));
+
+    // Loudness differences follow the K-weighting curve
+    double shelf[adsp::numCoefficients];
+    double highpass[adsp::numCoefficients];
+    adsp::calculateKWeightingCoefficients(shelf, highpass, 48000.0);
+    const double frequencies[] = {1000.0, 10000.0};
+    adsp::FrequencyResponse response;
+    response.setFrequencies(frequencies, 2, 48000.0);
+    response.addBiquad(shelf);
+    response.addBiquad(highpass);
+    const double *weightingdB = response.getMagnitudedB();
+
+    adsp::MeterBank high;
+    high.reset(1, 48000.0);
+    meterInterleaved(high, meterTestSines({0.5}, 10000.0, 4 * 48000, 48000.0));
+    CHECK(high.getMomentaryLoudness(0) - meter.getMomentaryLoudness(0) == Approx(weightingdB[1] - weightingdB[0]).margin(0.01));
+
+    adsp::MeterBank low;
+    low.reset(1, 48000.0);
+    meterInterleaved(low, meterTestSines({0.5}, 20.0, 4 * 48000, 48000.0));
+    CHECK(low.getMomentaryLoudness(0) - meter.getMomentaryLoudness(0) < -10.0);
+}
+
+TEST_CASE("MeterBank ballistics and windows", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    SECTION("Peak release time constant")
+    {
+        adsp::MeterBank meter;
+        meter.reset(1, sampleRate);
+        adsp::MeterBankParams params;
+        params.peakRelease = 100.0;
+        meter.setParameters(params);
+
+        // Impulse followed by 100 ms of silence
+        std::vector<double> block(1 + 4800, 0.0);
+        block[0] = 1.0;
+        meter.processInterleaved(block.data(), 1);
+        CHECK(meter.getPeakdB(0) == Approx(0.0).margin(1e-9));
+
+        // One time constant later the level has fallen to 1/e
+        meter.processInterleaved(block.data() + 1, 4800);
+        CHECK(meter.getPeakdB(0) == Approx(-20.0 * log10(exp(1.0))).margin(0.01));
+    }
+
+    SECTION("Peak attack time constant")
+    {
+        adsp::MeterBank meter;
+        meter.reset(1, sampleRate);
+        adsp::MeterBankParams params;
+        params.peakAttack = 10.0;
+        meter.setParameters(params);
+
+        std::vector<double> block(480, 1.0);
+        meter.processInterleaved(block.data(), 480);
+        CHECK(meter.getPeakdB(0) == Approx(20.0 * log10(1.0 - exp(-1.0))).margin(0.01));
+    }
+
+    SECTION("Rectangular RMS window")
+    {
+        adsp::MeterBank meter;
+        meter.reset(1, sampleRate);
+        adsp::MeterBankParams params;
+        params.rmsWindow = 100.0;
+        meter.setParameters(params);
+
+        // 50 ms of DC at 1 inside the 100 ms window reads half the power
+        std::vector<double> block(4800, 0.0);
+        std::fill(block.begin() + 2400, block.end(), 1.0);
+        meter.processInterleaved(block.data(), 4800);
+        CHECK(meter.getRmsdB(0) == Approx(10.0 * log10(0.5)).margin(1e-9));
+
+        // Changing the window length resums the stored blocks
+        params.rmsWindow = 50.0;
+        meter.setParameters(params);
+        CHECK(meter.getRmsdB(0) == Approx(0.0).margin(1e-9));
+    }
+}
+
+TEST_CASE("MeterBank interleaved and planar input agree", "[analysis]")
+{
+    const int numChannels = 13;
+    const int numFrames = 10000;
+
+    std::vector<double> interleaved(numFrames * numChannels);
+    std::vector<std::vector<double>> planar(numChannels, std::vector<double>(numFrames));
+    std::vector<const double *> channels(numChannels);
+    double x = 0.2;
+    for (int c = 0; c < numChannels; ++c)
+    {
+        for (int n = 0; n < numFrames; ++n)
+        {
+            x = 3.9 * x * (1.0 - x);
+            interleaved[n * numChannels + c] = x - 0.5;
+            planar[c][n] = x - 0.5;
+        }
+        channels[c] = planar[c].data();
+    }
+
+    adsp::MeterBank a;
+    a.reset(numChannels, 44100.0);
+    adsp::MeterBank b;
+    b.reset(numChannels, 44100.0);
+
+    a.processInterleaved(interleaved.data(), numFrames);
+    b.processPlanar(channels.data(), 3000);
+    std::vector<const double *> rest(numChannels);
+    for (int c = 0; c < numChannels; ++c)
+    {
+        rest[c] = channels[c] + 3000;
+    }
+    b.processPlanar(rest.data(), numFrames - 3000);
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        CHECK(a.getPeakdB(c) == Approx(b.getPeakdB(c)).margin(1e-12));
+        CHECK(a.getRmsdB(c) == Approx(b.getRmsdB(c)).margin(1e-9));
+        CHECK(a.getMomentaryLoudness(c) == Approx(b.getMomentaryLoudness(c)).margin(1e-9));
+    }
+}
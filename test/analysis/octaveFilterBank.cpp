@@ -0,0 +1,155 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    std::vector<double> octaveBankSine(double frequency, double sampleRate, int numSamples)
+    {
+        std::vector<double> signal(numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            signal[n] = sin(adsp::TWO_PI * frequency * n / sampleRate);
+        }
+        return signal;
+    }
+}
+
+TEST_CASE("OctaveFilterBank band layout", "[analysis]")
+{
+    adsp::OctaveFilterBank bank;
+    bank.reset(48000.0);
+
+    // 31 third-octave bands from 20 Hz to 20 kHz
+    REQUIRE(bank.getNumBands() == 31);
+    CHECK(bank.getBandFrequency(0) == Approx(1000.0 * pow(2.0, -17.0 / 3.0)).margin(1e-9));
+    CHECK(bank.getBandFrequency(17) == Approx(1000.0).margin(1e-9));
+    CHECK(bank.getBandFrequency(30) == Approx(1000.0 * pow(2.0, 13.0 / 3.0)).margin(1e-9));
+
+    // Lower bands run at lower rates, about one octave per rate
+    CHECK(bank.getBandDecimation(0) == 256);
+    CHECK(bank.getBandDecimation(30) == 1);
+    for (int band = 1; band < bank.getNumBands(); ++band)
+    {
+        CHECK(bank.getBandDecimation(band) <= bank.getBandDecimation(band - 1));
+        CHECK(bank.getBandFrequency(band) / bank.getBandFrequency(band - 1) == Approx(pow(2.0, 1.0 / 3.0)).margin(1e-9));
+    }
+
+    // Octave bands, the 20 kHz third-octave band does not fit below 44.1 kHz / 2
+    adsp::OctaveFilterBankParams params;
+    params.bandsPerOctave = 1;
+    bank.setParameters(params);
+    CHECK(bank.getNumBands() == 11);
+    CHECK(bank.getBandFrequency(0) == Approx(15.625).margin(1e-9));
+
+    params.bandsPerOctave = 3;
+    bank.setParameters(params);
+    bank.reset(44100.0);
+    CHECK(bank.getNumBands() == 30);
+}
+
+TEST_CASE("OctaveFilterBank band levels", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    adsp::OctaveFilterBank bank;
+    bank.reset(sampleRate);
+
+    // Top band, a decimated band in the middle and the lowest band
+    for (int band : {30, 17, 0})
+    {
+        bank.reset(sampleRate);
+        std::vector<double> signal = octaveBankSine(bank.getBandFrequency(band), sampleRate, 96000);
+
+        double inputEnergy = 0.0;
+        double bandEnergy = 0.0;
+        for (int offset = 0; offset < 96000; offset += 480)
+        {
+            bank.processBlock(&signal[offset], 480);
+
+            // After settling
+            if (offset >= 48000)
+            {
+                for (int n = 0; n < 480; ++n)
+                {
+                    inputEnergy += signal[offset + n] * signal[offset + n];
+                }
+                for (int k = 0; k < bank.getNumBands(); ++k)
+                {
+                    bandEnergy += bank.getBandEnergy(k);
+                }
+            }
+        }
+
+        // Full scale sine at the center reads -3 dB
+        CHECK(bank.getBandLeveldB(band) == Approx(-3.01).margin(0.1));
+
+        // Neighbours one and two bands away
+        for (int neighbour : {band - 1, band + 1})
+        {
+            if (neighbour >= 0 && neighbour < bank.getNumBands())
+            {
+                CHECK(bank.getBandLeveldB(neighbour) < -3.0 - 15.0);
+            }
+        }
+        for (int neighbour : {band - 2, band + 2})
+        {
+            if (neighbour >= 0 && neighbour < bank.getNumBands())
+            {
+                CHECK(bank.getBandLeveldB(neighbour) < -3.0 - 30.0);
+            }
+        }
+
+        // The bands split the energy
+        CHECK(10.0 * log10(bandEnergy / inputEnergy) == Approx(0.0).margin(0.5));
+    }
+}
+
+TEST_CASE("OctaveFilterBank block size independence", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+    std::vector<double> signal(20000);
+    for (size_t n = 0; n < signal.size(); ++n)
+    {
+        signal[n] = sin(0.001 * n * n / 1000.0) + 0.3 * sin(0.7 * n);
+    }
+
+    adsp::OctaveFilterBank whole;
+    whole.reset(sampleRate);
+    adsp::OctaveFilterBank split;
+    split.reset(sampleRate);
+
+    std::vector<double> wholeEnergies(whole.getNumBands(), 0.0);
+    std::vector<double> splitEnergies(split.getNumBands(), 0.0);
+
+    whole.processBlock(signal.data(), static_cast<int>(signal.size()));
+    for (int band = 0; band < whole.getNumBands(); ++band)
+    {
+        wholeEnergies[band] = whole.getBandEnergy(band);
+    }
+
+    // Odd block sizes, the decimators carry single samples between blocks
+    int offset = 0;
+    int blockSize = 1;
+    while (offset < static_cast<int>(signal.size()))
+    {
+        const int numSamples = std::min(blockSize, static_cast<int>(signal.size()) - offset);
+        split.processBlock(&signal[offset], numSamples);
+        for (int band = 0; band < split.getNumBands(); ++band)
+        {
+            splitEnergies[band] += split.getBandEnergy(band);
+        }
+        offset += numSamples;
+        blockSize = blockSize % 997 + 37;
+    }
+
+    for (int band = 0; band < whole.getNumBands(); ++band)
+    {
+        CHECK(splitEnergies[band] == Approx(wholeEnergies[band]).epsilon(1e-9));
+    }
+}
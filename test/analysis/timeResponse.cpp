@@ -0,0 +1,142 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+TEST_CASE("Time response matches sample by sample processing", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+    const int length = 2048;
+
+    adsp::Peak peak;
+    peak.reset(sampleRate);
+    adsp::PeakParams params;
+    params.fc = 1000.0;
+    params.gain = 12.0;
+    params.q = 4.0;
+    peak.setParameters(params);
+
+    adsp::TimeResponse response;
+    response.setLength(length);
+    REQUIRE(response.getLength() == length);
+
+    adsp::BiquadParams biquadParams;
+    biquadParams.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+
+    for (auto type : {adsp::timeResponseType::impulse, adsp::timeResponseType::step})
+    {
+        adsp::Biquad biquad;
+        biquad.setParameters(biquadParams);
+        biquad.setCoefficients(peak.getCoefficients());
+
+        const double *rendered = response.getResponse(peak.getCoefficients(), type);
+        for (int n = 0; n < length; ++n)
+        {
+            const double x = (n == 0 || type == adsp::timeResponseType::step) ? 1.0 : 0.0;
+            REQUIRE(rendered[n] == biquad.process(x));
+        }
+    }
+
+    // Step response of the peak settles at its DC gain
+    CHECK(response.getStepResponse(peak)[length - 1] == Approx(1.0).margin(1e-6));
+}
+
+TEST_CASE("Time response cache", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    adsp::RcLp1 lowpass;
+    lowpass.reset(sampleRate);
+    adsp::RcHp1 highpass;
+    highpass.reset(sampleRate);
+
+    adsp::TimeResponse response;
+    response.setLength(256);
+
+    const double *impulse = response.getImpulseResponse(lowpass);
+    const double *step = response.getStepResponse(lowpass);
+    REQUIRE(response.getNumRendered() == 2);
+    CHECK(impulse != step);
+
+    // Unchanged coefficients are served from the cache
+    CHECK(response.getImpulseResponse(lowpass) == impulse);
+    CHECK(response.getStepResponse(lowpass) == step);
+    CHECK(response.getImpulseResponse(highpass) != impulse);
+    CHECK(response.getImpulseResponse(lowpass) == impulse);
+    REQUIRE(response.getNumRendered() == 3);
+
+    // Changed coefficients are rendered again
+    adsp::RcLp1Params params;
+    params.fc = 50.0;
+    lowpass.setParameters(params);
+    const double impulse0 = response.getImpulseResponse(lowpass)[0];
+    CHECK(impulse0 == Approx(lowpass.getCoefficients()[adsp::a0]));
+    REQUIRE(response.getNumRendered() == 4);
+
+    // The least recently used response is replaced once all slots are in use
+    for (int k = 0; k < adsp::TIME_RESPONSE_CACHE_SIZE; ++k)
+    {
+        double gain[adsp::numCoefficients] = {1.0 + k, 0.0, 0.0, 0.0, 0.0};
+        CHECK(response.getResponse(gain, adsp::timeResponseType::impulse)[0] == 1.0 + k);
+    }
+    REQUIRE(response.getNumRendered() == 4 + adsp::TIME_RESPONSE_CACHE_SIZE);
+    response.getImpulseResponse(lowpass);
+    REQUIRE(response.getNumRendered() == 5 + adsp::TIME_RESPONSE_CACHE_SIZE);
+
+    response.clear();
+    response.getImpulseResponse(lowpass);
+    CHECK(response.getNumRendered() == 1);
+}
+
+TEST_CASE("Time response cache replaces the least recently used response", "[analysis]")
+{
+    const double sampleRate = 48000.0;
+
+    // One gain per band, distinct coefficient sets
+    auto gain = [](int band, double *coefficients)
+    {
+        for (int i = 0; i < adsp::numCoefficients; ++i)
+        {
+            coefficients[i] = 0.0;
+        }
+        coefficients[adsp::a0] = 1.0 + band;
+    };
+
+    adsp::RcLp1 lowpass;
+    lowpass.reset(sampleRate);
+
+    adsp::TimeResponse response;
+    response.setLength(64);
+    REQUIRE(response.getNumSlots() == adsp::TIME_RESPONSE_CACHE_SIZE);
+
+    // A response asked for again stays cached while others are rendered
+    const double *impulse = response.getImpulseResponse(lowpass);
+    double coefficients[adsp::numCoefficients];
+    for (int band = 0; band < adsp::TIME_RESPONSE_CACHE_SIZE - 1; ++band)
+    {
+        gain(band, coefficients);
+        response.getResponse(coefficients, adsp::timeResponseType::impulse);
+    }
+    CHECK(response.getImpulseResponse(lowpass) == impulse);
+    gain(100, coefficients);
+    response.getResponse(coefficients, adsp::timeResponseType::impulse);
+    CHECK(response.getImpulseResponse(lowpass) == impulse);
+    CHECK(response.getNumRendered() == adsp::TIME_RESPONSE_CACHE_SIZE + 1);
+
+    // A 31 band equalizer redrawn in a loop renders every band once
+    const int numBands = 31;
+    response.setLength(64, numBands);
+    REQUIRE(response.getNumSlots() == numBands);
+    for (int redraw = 0; redraw < 3; ++redraw)
+    {
+        for (int band = 0; band < numBands; ++band)
+        {
+            gain(band, coefficients);
+            REQUIRE(response.getResponse(coefficients, adsp::timeResponseType::step)[10] == 1.0 + band);
+        }
+    }
+    CHECK(response.getNumRendered() == numBands);
+}
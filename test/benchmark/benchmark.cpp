@@ -0,0 +1,580 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Catch;
+
+// Benchmarks are hidden from the default test run, execute them with:
+// unit_tests "[.benchmark]"
+
+//==============================================================================
+// Resampler
+
+TEST_CASE("Resampler cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+
+    for (auto quality : {adsp::resamplerQuality::draft, adsp::resamplerQuality::normal, adsp::resamplerQuality::high})
+    {
+        adsp::Resampler resampler;
+        adsp::ResamplerParams params;
+        params.inputSampleRate = 44100.0;
+        params.outputSampleRate = 48000.0;
+        params.quality = quality;
+        resampler.setParameters(params);
+        resampler.reset(blockSize);
+
+        std::vector<double> in(blockSize, 0.1);
+        std::vector<double> out(resampler.getMaxOutputSamples(blockSize));
+
+        BENCHMARK("Resampler 44.1k -> 48k, 512 samples, quality " + std::to_string(static_cast<int>(quality)))
+        {
+            return resampler.process(in.data(), blockSize, out.data(), static_cast<int>(out.size()));
+        };
+    }
+}
+
+//==============================================================================
+// Metering
+
+TEST_CASE("MeterBank cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+    const int numChannels = 128;
+
+    adsp::MeterBank meter;
+    meter.reset(numChannels, 48000.0);
+
+    std::vector<double> block(blockSize * numChannels, 0.1);
+
+    BENCHMARK("MeterBank 128 channels, 512 samples interleaved")
+    {
+        meter.processInterleaved(block.data(), blockSize);
+        return meter.getPeakdB(0);
+    };
+}
+
+TEST_CASE("OctaveFilterBank cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+
+    std::vector<double> block(blockSize);
+    for (int n = 0; n < blockSize; ++n)
+    {
+        block[n] = 0.1 * sin(0.05 * n);
+    }
+
+    adsp::OctaveFilterBank bank;
+    bank.reset(48000.0);
+
+    BENCHMARK("OctaveFilterBank 31 third-octave bands, 512 samples")
+    {
+        bank.processBlock(block.data(), blockSize);
+        return bank.getBandEnergy(0);
+    };
+
+    // The same bands as separate bandpass filters at the full rate
+    std::vector<adsp::Bandpass> bandpasses(bank.getNumBands());
+    for (int band = 0; band < bank.getNumBands(); ++band)
+    {
+        bandpasses[band].reset(48000.0);
+        adsp::BandpassParams params;
+        params.fc = bank.getBandFrequency(band);
+        params.q = 4.32;
+        bandpasses[band].setParameters(params);
+    }
+
+    BENCHMARK("31 Bandpass filters, 512 samples")
+    {
+        double energy = 0.0;
+        for (auto &bandpass : bandpasses)
+        {
+            for (int n = 0; n < blockSize; ++n)
+            {
+                const double y = bandpass.process(block[n]);
+                energy += y * y;
+            }
+        }
+        return energy;
+    };
+}
+
+//==============================================================================
+// Time response
+
+TEST_CASE("Impulse response of a filter", "[.benchmark]")
+{
+    const int length = 4096;
+
+    adsp::Peak peak;
+    peak.reset(48000.0);
+    adsp::PeakParams params;
+    params.fc = 100.0;
+    params.gain = 12.0;
+    peak.setParameters(params);
+
+    std::vector<double> out(length);
+
+    // The loop plots used to run on every redraw
+    BENCHMARK("Peak process() loop, 4096 samples")
+    {
+        peak.reset(48000.0);
+        for (int n = 0; n < length; ++n)
+        {
+            out[n] = peak.process(n == 0 ? 1.0 : 0.0);
+        }
+        return out[length - 1];
+    };
+
+    adsp::TimeResponse response;
+    response.setLength(length);
+
+    BENCHMARK("TimeResponse rendered, 4096 samples")
+    {
+        response.clear();
+        return response.getImpulseResponse(peak)[length - 1];
+    };
+
+    BENCHMARK("TimeResponse cached, 4096 samples")
+    {
+        return response.getImpulseResponse(peak)[length - 1];
+    };
+}
+
+//==============================================================================
+// Interleaved buffers
+
+TEST_CASE("Biquad on interleaved buffers", "[.benchmark]")
+{
+    const int numFrames = 512;
+
+    for (int numChannels : {2, 8})
+    {
+        std::vector<adsp::Biquad> biquads(numChannels);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            adsp::BiquadParams params;
+            params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+            biquads[channel].setParameters(params);
+
+            double coefficients[adsp::numCoefficients];
+            adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 100.0 * (channel + 1), 1.0, 6.0, 48000.0);
+            biquads[channel].setCoefficients(coefficients);
+        }
+
+        std::vector<double> interleaved(numChannels * numFrames);
+        for (size_t i = 0; i < interleaved.size(); ++i)
+        {
+            interleaved[i] = 0.1 * sin(0.01 * i);
+        }
+        std::vector<double> planar(numFrames);
+
+        const std::string suffix = std::to_string(numChannels) + " channels, 512 frames";
+
+        // What hosts did before the strided paths
+        BENCHMARK("Deinterleave, process(), interleave, " + suffix)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int n = 0; n < numFrames; ++n)
+                {
+                    planar[n] = interleaved[n * numChannels + channel];
+                }
+                for (int n = 0; n < numFrames; ++n)
+                {
+                    planar[n] = biquads[channel].process(planar[n]);
+                }
+                for (int n = 0; n < numFrames; ++n)
+                {
+                    interleaved[n * numChannels + channel] = planar[n];
+                }
+            }
+            return interleaved[0];
+        };
+
+        BENCHMARK("processStrided() per channel, " + suffix)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                double *data = interleaved.data() + channel;
+                biquads[channel].processStrided(data, data, numChannels, numFrames);
+            }
+            return interleaved[0];
+        };
+
+        BENCHMARK("processInterleaved(), " + suffix)
+        {
+            adsp::Biquad::processInterleaved(biquads.data(), numChannels, interleaved.data(), numChannels, numFrames);
+            return interleaved[0];
+        };
+    }
+}
+
+//==============================================================================
+// ConstantBiquad
+
+namespace
+{
+    constexpr adsp::BiquadCoefficients benchmarkDcBlocker = adsp::designRcHp1(5.0, 48000.0);
+}
+
+TEST_CASE("ConstantBiquad cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+
+    std::vector<double> block(blockSize);
+    for (int n = 0; n < blockSize; ++n)
+    {
+        block[n] = 0.1 + 0.5 * sin(0.05 * n);
+    }
+
+    adsp::RcHp1 runtime;
+    runtime.reset(48000.0);
+    adsp::RcHp1Params params;
+    params.fc = 5.0;
+    runtime.setParameters(params);
+
+    BENCHMARK("RcHp1 DC blocker, 512 samples")
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            block[n] = runtime.process(block[n]) + 0.1;
+        }
+        return block[0];
+    };
+
+    adsp::ConstantBiquad<benchmarkDcBlocker> constant;
+    constant.reset();
+
+    BENCHMARK("ConstantBiquad DC blocker, 512 samples")
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            block[n] = constant.process(block[n]) + 0.1;
+        }
+        return block[0];
+    };
+}
+
+//==============================================================================
+// First-order filters
+
+TEST_CASE("First-order filter cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+    auto coefficients = adsp::designRcHp1(5.0, 48000.0);
+
+    std::vector<double> block(blockSize);
+    for (int n = 0; n < blockSize; ++n)
+    {
+        block[n] = 0.1 + 0.5 * sin(0.05 * n);
+    }
+
+    adsp::Biquad biquad;
+    adsp::BiquadParams params;
+    params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+    biquad.setParameters(params);
+    biquad.setCoefficients(coefficients.data());
+
+    BENCHMARK("Biquad first-order, 512 samples")
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            block[n] = biquad.process(block[n]) + 0.1;
+        }
+        return block[0];
+    };
+
+    adsp::FirstOrder firstOrder;
+    firstOrder.setCoefficients(coefficients.data());
+
+    BENCHMARK("FirstOrder, 512 samples")
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            block[n] = firstOrder.process(block[n]) + 0.1;
+        }
+        return block[0];
+    };
+
+    BENCHMARK("FirstOrder block, 512 samples")
+    {
+        firstOrder.processBlock(block.data(), block.data(), blockSize);
+        return block[0];
+    };
+
+    // Divide by the number of channels for the cost per channel
+    for (int numChannels : {2, 8, 64})
+    {
+        std::vector<std::vector<double>> channels(numChannels, block);
+        std::vector<double *> pointers;
+        for (auto &channel : channels)
+        {
+            pointers.push_back(channel.data());
+        }
+
+        adsp::DcBlocker blocker;
+        blocker.reset(numChannels, 48000.0);
+
+        BENCHMARK("DcBlocker " + std::to_string(numChannels) + " channels, 512 samples")
+        {
+            blocker.process(pointers.data(), blockSize);
+            return channels[0][0];
+        };
+
+        std::vector<adsp::FirstOrder> singles(numChannels, firstOrder);
+
+        BENCHMARK("FirstOrder " + std::to_string(numChannels) + " channels, 512 samples")
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                singles[channel].processBlock(pointers[channel], pointers[channel], blockSize);
+            }
+            return channels[0][0];
+        };
+    }
+}
+
+//==============================================================================
+// FilterGroup
+
+TEST_CASE("FilterGroup sample rate change", "[.benchmark]")
+{
+    // 10000 filters, DC blockers, Sallen-Key filters and equalizer bands
+    const int numFilters = 2500;
+
+    std::vector<adsp::RcHp1> rcHp1s(numFilters);
+    std::vector<adsp::SkLp2> skLp2s(numFilters);
+    std::vector<adsp::SkHp2> skHp2s(numFilters);
+    std::vector<adsp::Peak> peaks(numFilters);
+
+    adsp::FilterGroup group;
+    for (int i = 0; i < numFilters; ++i)
+    {
+        adsp::SkLp2Params skLp2Params;
+        skLp2Params.fc = 1000.0 + i;
+        skLp2s[i].setParameters(skLp2Params);
+        adsp::PeakParams peakParams;
+        peakParams.fc = 100.0 + i;
+        peakParams.gain = 3.0;
+        peaks[i].setParameters(peakParams);
+
+        group.add(rcHp1s[i]);
+        group.add(skLp2s[i]);
+        group.add(skHp2s[i]);
+        group.add(peaks[i]);
+    }
+
+    double sampleRate = 44100.0;
+    auto nextRate = [&sampleRate]() {
+        sampleRate = sampleRate == 44100.0 ? 48000.0 : 44100.0;
+        return sampleRate;
+    };
+
+    BENCHMARK("setSampleRate on 10000 filters")
+    {
+        const double rate = nextRate();
+        for (int i = 0; i < numFilters; ++i)
+        {
+            rcHp1s[i].setSampleRate(rate);
+            skLp2s[i].setSampleRate(rate);
+            skHp2s[i].setSampleRate(rate);
+            peaks[i].setSampleRate(rate);
+        }
+        return peaks[0].getCoefficients()[0];
+    };
+
+    BENCHMARK("FilterGroup 10000 filters, computed")
+    {
+        group.setSampleRate(nextRate());
+        return peaks[0].getCoefficients()[0];
+    };
+
+    const double preparedRates[] = {44100.0, 48000.0};
+    group.prepareSampleRates(preparedRates, 2);
+
+    BENCHMARK("FilterGroup 10000 filters, prepared")
+    {
+        group.setSampleRate(nextRate());
+        return peaks[0].getCoefficients()[0];
+    };
+}
+
+//==============================================================================
+// FilterPool
+
+TEST_CASE("FilterPool session load", "[.benchmark]")
+{
+    // 500 tracks with one Sallen-Key lowpass each
+    const int numFilters = 500;
+
+    BENCHMARK("500 SkLp2 one by one, reset")
+    {
+        std::vector<std::unique_ptr<adsp::SkLp2>> filters;
+        filters.reserve(numFilters);
+        for (int i = 0; i < numFilters; ++i)
+        {
+            filters.emplace_back(new adsp::SkLp2);
+            filters.back()->reset(48000.0);
+        }
+        return filters.back()->getCoefficients()[adsp::a0];
+    };
+
+    BENCHMARK("500 SkLp2 in a FilterPool, reset")
+    {
+        adsp::FilterPool<adsp::SkLp2> pool;
+        pool.allocate(numFilters);
+        pool.reset(48000.0);
+        return pool.getFilter(numFilters - 1).getCoefficients()[adsp::a0];
+    };
+
+    // Processing a block per filter, filters scattered by interleaved allocations
+    std::vector<std::unique_ptr<adsp::SkLp2>> scattered;
+    std::vector<std::unique_ptr<double[]>> clutter;
+    for (int i = 0; i < numFilters; ++i)
+    {
+        scattered.emplace_back(new adsp::SkLp2);
+        scattered.back()->reset(48000.0);
+        clutter.emplace_back(new double[64 + 37 * (i % 11)]);
+    }
+    adsp::FilterPool<adsp::SkLp2> pool;
+    pool.allocate(numFilters);
+    pool.reset(48000.0);
+
+    std::vector<double> block(32, 0.25);
+    BENCHMARK("500 scattered SkLp2, 32 samples")
+    {
+        for (auto &filter : scattered)
+        {
+            filter->processBlock(block.data(), block.data(), 32);
+        }
+        return block[0];
+    };
+
+    BENCHMARK("500 pooled SkLp2, 32 samples")
+    {
+        for (int i = 0; i < numFilters; ++i)
+        {
+            pool.getFilter(i).processBlock(block.data(), block.data(), 32);
+        }
+        return block[0];
+    };
+}
+
+//==============================================================================
+// Dynamics
+
+TEST_CASE("Dynamics cost per block", "[.benchmark]")
+{
+    const int blockSize = 512;
+
+    for (double lookAhead : {0.0, 5.0})
+    {
+        adsp::Dynamics dynamics;
+        dynamics.reset(2, 48000.0);
+        adsp::DynamicsParams params;
+        params.lookAhead = lookAhead;
+        params.link = 0.5;
+        dynamics.setParameters(params);
+
+        // Level around the knee, the gain computer takes every branch
+        std::vector<double> left(blockSize);
+        std::vector<double> right(blockSize);
+        for (int n = 0; n < blockSize; ++n)
+        {
+            left[n] = 0.2 * sin(0.05 * n);
+            right[n] = 0.1 * sin(0.03 * n);
+        }
+        double *channels[] = {left.data(), right.data()};
+
+        // Divide by 1024 for the cost per sample and channel
+        BENCHMARK("Dynamics stereo, 512 samples, look-ahead " + std::to_string(static_cast<int>(lookAhead)) + " ms")
+        {
+            dynamics.process(channels, blockSize);
+            return left[0];
+        };
+    }
+}
+
+//==============================================================================
+// ProcessGraph
+
+TEST_CASE("ProcessGraph track chains", "[.benchmark]")
+{
+    const int blockSize = 512;
+    const int numTracks = 16;
+
+    struct Track
+    {
+        adsp::RcHp1 highpass;
+        adsp::LowShelf shelf;
+        adsp::SkLp2 lowpass;
+        adsp::Saturator saturator;
+    };
+    std::vector<Track> tracks(numTracks);
+    for (auto &track : tracks)
+    {
+        track.highpass.reset(48000.0);
+        track.shelf.reset(48000.0);
+        track.lowpass.reset(48000.0);
+    }
+
+    std::vector<std::vector<double>> inputs(numTracks, std::vector<double>(blockSize));
+    std::vector<const double *> in;
+    for (int track = 0; track < numTracks; ++track)
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            inputs[track][n] = 0.2 * sin(0.01 * (track + 1) * n);
+        }
+        in.push_back(inputs[track].data());
+    }
+    std::vector<double> bus(blockSize);
+    double *out[] = {bus.data()};
+
+    // Every sample through all chains
+    BENCHMARK("16 chains sample by sample, 512 samples")
+    {
+        for (int n = 0; n < blockSize; ++n)
+        {
+            double sum = 0.0;
+            for (int track = 0; track < numTracks; ++track)
+            {
+                Track &t = tracks[track];
+                sum += t.saturator.process(t.lowpass.process(t.shelf.process(t.highpass.process(inputs[track][n]))));
+            }
+            bus[n] = sum;
+        }
+        return bus[0];
+    };
+
+    for (int numThreads : {1, 2})
+    {
+        adsp::ProcessGraph graph;
+        const int sum = graph.addNode(tracks[0].lowpass);
+        for (auto &track : tracks)
+        {
+            const int input = graph.addInput();
+            const int highpass = graph.addNode(track.highpass);
+            const int shelf = graph.addNode(track.shelf);
+            const int lowpass = graph.addNode(track.lowpass);
+            const int saturator = graph.addNode(track.saturator);
+            graph.connect(input, highpass);
+            graph.connect(highpass, shelf);
+            graph.connect(shelf, lowpass);
+            graph.connect(lowpass, saturator);
+            graph.connect(saturator, sum);
+        }
+        graph.addOutput(sum);
+        graph.prepare(blockSize, numThreads);
+
+        // More threads than cores only adds the hand-over cost
+        BENCHMARK("ProcessGraph 16 chains, 512 samples, " + std::to_string(numThreads) + " threads")
+        {
+            graph.process(in.data(), out, blockSize);
+            return bus[0];
+        };
+    }
+}
@@ -0,0 +1,111 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+//==============================================================================
+// Profiling counters
+
+#ifdef ADSP_ENABLE_PROFILING
+TEST_CASE("Profiling counters", "[debug]")
+{
+    adsp::SkLp2 filter;
+    filter.reset(48000.0);
+    filter.setSampleRate(48000.0);
+
+    adsp::SkLp2Params params;
+    params.fc = 1000.0;
+    filter.setParameters(params);
+
+    filter.resetProfile();
+
+    SECTION("Samples and cycles")
+    {
+        for (int n = 0; n < 1000; ++n)
+        {
+            filter.process(n % 2 == 0 ? 1.0 : -1.0);
+        }
+
+        const adsp::ProfileSnapshot profile = filter.getProfile();
+        REQUIRE(profile.samples == 1000);
+        REQUIRE(profile.cycles > 0);
+        REQUIRE(profile.getCyclesPerSample() > 0.0);
+    }
+
+    SECTION("Coefficient recalculations")
+    {
+        params.fc = 2000.0;
+        filter.setParameters(params);
+        filter.setSampleRate(96000.0);
+
+        // Unchanged parameters do not recalculate
+        filter.setParameters(params);
+
+        REQUIRE(filter.getProfile().coefficientUpdates == 2);
+    }
+
+    SECTION("Underflow fixes")
+    {
+        // Decaying impulse response ends in the range flushed to zero
+        filter.process(1e-300);
+        for (int n = 0; n < 100; ++n)
+        {
+            filter.process(0.0);
+        }
+
+        REQUIRE(filter.getProfile().underflowFixes > 0);
+    }
+
+    SECTION("Reset")
+    {
+        filter.process(1.0);
+        filter.resetProfile();
+
+        const adsp::ProfileSnapshot profile = filter.getProfile();
+        REQUIRE(profile.samples == 0);
+        REQUIRE(profile.cycles == 0);
+    }
+
+    SECTION("Counters are readable while processing")
+    {
+        std::atomic<bool> done{false};
+        std::atomic<bool> decreased{false};
+        std::thread reader([&]() {
+            uint64_t last = 0;
+            while (!done.load())
+            {
+                const uint64_t samples = filter.getProfile().samples;
+                // Counters only grow while nobody resets them
+                if (samples < last)
+                {
+                    decreased.store(true);
+                }
+                last = samples;
+            }
+        });
+
+        for (int n = 0; n < 100000; ++n)
+        {
+            filter.process(0.5);
+        }
+        done.store(true);
+        reader.join();
+
+        REQUIRE_FALSE(decreased.load());
+        REQUIRE(filter.getProfile().samples == 100000);
+    }
+}
+#else
+TEST_CASE("Profiling counters", "[debug]")
+{
+    adsp::Biquad biquad;
+    biquad.process(1.0);
+
+    // Disabled profiling reports nothing
+    REQUIRE(biquad.getProfile().samples == 0);
+}
+#endif
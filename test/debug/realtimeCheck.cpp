@@ -0,0 +1,473 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <mutex>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Runs a filter over a noise-like signal inside a realtime section
+    template <typename Filter>
+    void runRealtime(Filter &filter, int numSamples)
+    {
+        adsp::RealtimeSection section;
+
+        double x = 0.1;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            x = 3.9 * x * (1.0 - x);
+            filter.process(x - 0.5);
+        }
+    }
+
+    // Keeps allocations in the negative tests from being optimized away
+    void *volatile realtimeCheckSink = nullptr;
+}
+
+//==============================================================================
+// Realtime safety of the process paths
+
+TEST_CASE("Filters process without allocations and locks", "[debug]")
+{
+    adsp::resetRealtimeViolations();
+
+    SECTION("Biquad, all algorithms")
+    {
+        const adsp::biquadAlgorithm algorithms[] = {
+            adsp::biquadAlgorithm::direct,
+            adsp::biquadAlgorithm::canonical,
+            adsp::biquadAlgorithm::transposedDirect,
+            adsp::biquadAlgorithm::transposedCanonical,
+            adsp::biquadAlgorithm::errorFeedbackDirect,
+            adsp::biquadAlgorithm::stateVariable};
+
+        for (auto algorithm : algorithms)
+        {
+            adsp::Biquad biquad;
+            adsp::BiquadParams params;
+            params.calculationType = algorithm;
+            biquad.setParameters(params);
+
+            double coefficients[adsp::numCoefficients] = {0.2, 0.4, 0.2, -0.5, 0.3};
+            biquad.setCoefficients(coefficients);
+            biquad.reset();
+
+            runRealtime(biquad, 4096);
+
+            adsp::BiquadFloat biquadFloat;
+            biquadFloat.setParameters(params);
+            biquadFloat.setCoefficients(coefficients);
+
+            std::vector<float> block(4096, 0.25f);
+            biquadFloat.processBlock(block.data(), block.data(), 4096);
+
+            std::vector<double> stereo(2 * 4096, 0.25);
+            biquad.processBlock(stereo.data(), stereo.data(), 4096);
+            biquad.processStrided(stereo.data() + 1, stereo.data() + 1, 2, 4096);
+        }
+
+        // Groups of eight and four channels and a single one
+        std::vector<adsp::Biquad> biquads(13);
+        for (auto &biquad : biquads)
+        {
+            adsp::BiquadParams params;
+            params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+            biquad.setParameters(params);
+        }
+        std::vector<double> interleaved(13 * 1024, 0.25);
+        adsp::Biquad::processInterleaved(biquads.data(), 13, interleaved.data(), 13, 1024);
+    }
+
+    SECTION("Filter wrappers")
+    {
+        adsp::RcLp1 rcLp1;
+        adsp::RcHp1 rcHp1;
+        adsp::SkLp2 skLp2;
+        adsp::SkHp2 skHp2;
+        rcLp1.reset(48000.0);
+        rcHp1.reset(48000.0);
+        skLp2.reset(48000.0);
+        skHp2.reset(48000.0);
+
+        runRealtime(rcLp1, 4096);
+        runRealtime(rcHp1, 4096);
+        runRealtime(skLp2, 4096);
+        runRealtime(skHp2, 4096);
+
+        adsp::Peak peak;
+        adsp::LowShelf lowShelf;
+        adsp::HighShelf highShelf;
+        adsp::Notch notch;
+        adsp::Bandpass bandpass;
+        adsp::Allpass allpass;
+        peak.reset(48000.0);
+        lowShelf.reset(48000.0);
+        highShelf.reset(48000.0);
+        notch.reset(48000.0);
+        bandpass.reset(48000.0);
+        allpass.reset(48000.0);
+
+        runRealtime(peak, 4096);
+        runRealtime(lowShelf, 4096);
+        runRealtime(highShelf, 4096);
+        runRealtime(notch, 4096);
+        runRealtime(bandpass, 4096);
+        runRealtime(allpass, 4096);
+
+        adsp::ParametricEq eq;
+        eq.reset(48000.0, adsp::MAX_EQ_BANDS);
+        runRealtime(eq, 4096);
+
+        // Prepared and computed sample rate changes
+        adsp::FilterGroup group;
+        group.add(rcLp1);
+        group.add(skHp2);
+        group.add(peak);
+        group.add(allpass);
+        const double preparedRate = 96000.0;
+        group.prepareSampleRates(&preparedRate, 1);
+        group.setSampleRate(96000.0);
+        group.setSampleRate(44100.0);
+    }
+
+    SECTION("First-order filters and DC blocker")
+    {
+        adsp::FirstOrder firstOrder;
+        firstOrder.setCoefficients(adsp::designRcHp1(10.0, 48000.0).data());
+        runRealtime(firstOrder, 4096);
+
+        std::vector<double> left(4096, 0.5);
+        std::vector<double> right(4096, -0.5);
+        double *channels[] = {left.data(), right.data()};
+
+        adsp::DcBlocker blocker;
+        blocker.reset(2, 48000.0);
+        blocker.process(channels, 4096);
+        blocker.processInterleaved(left.data(), 2048);
+
+        adsp::DcBlockerParams params;
+        params.fc = 20.0;
+        blocker.setParameters(params);
+        blocker.process(channels, 4096);
+    }
+
+    SECTION("Filter pools, bulk resets")
+    {
+        adsp::FilterPool<adsp::SkLp2> filters;
+        filters.allocate(64);
+        adsp::BiquadStatePool states;
+        states.allocate(64);
+
+        adsp::RealtimeSection section;
+        filters.reset(44100.0);
+        states.reset();
+        states.resetState(3);
+    }
+
+    SECTION("Fixed-point biquads")
+    {
+        double coefficients[adsp::numCoefficients];
+        adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 1000.0, 1.0, 6.0, 48000.0);
+
+        adsp::BiquadQ31 q31;
+        q31.setCoefficients(coefficients);
+        adsp::BiquadQ15 q15;
+        q15.setCoefficients(coefficients);
+
+        std::vector<int32_t> block31(4096, 1 << 28);
+        std::vector<int16_t> block15(4096, 1 << 12);
+        q31.processBlock(block31.data(), block31.data(), 4096);
+        q15.processBlock(block15.data(), block15.data(), 4096);
+    }
+
+    SECTION("State-variable filters")
+    {
+        adsp::Svf svf;
+        svf.reset(48000.0);
+        runRealtime(svf, 4096);
+
+        const int numVoices = 11;
+        const int blockSize = 64;
+        adsp::SvfBank bank;
+        bank.reset(numVoices, 48000.0);
+        std::vector<double> block(numVoices * blockSize, 0.25);
+
+        {
+            adsp::RealtimeSection section;
+            bank.processInterleaved(block.data(), block.data(), blockSize);
+        }
+    }
+
+    SECTION("Delay line, all interpolations")
+    {
+        const adsp::delayInterpolation interpolations[] = {
+            adsp::delayInterpolation::none,
+            adsp::delayInterpolation::linear,
+            adsp::delayInterpolation::lagrange,
+            adsp::delayInterpolation::cubic,
+            adsp::delayInterpolation::thiran};
+
+        const int blockSize = 64;
+        adsp::DelayLine delayLine;
+        delayLine.prepare(1000, blockSize);
+
+        std::vector<double> block(blockSize, 0.25);
+        std::vector<double> delays(blockSize, 12.5);
+        double *taps[] = {block.data()};
+
+        for (auto interpolation : interpolations)
+        {
+            adsp::DelayLineParams params;
+            params.interpolation = interpolation;
+            delayLine.setParameters(params);
+
+            adsp::RealtimeSection section;
+            delayLine.writeBlock(block.data(), blockSize);
+            delayLine.readBlock(block.data(), blockSize, 100.3);
+            delayLine.readBlockModulated(block.data(), delays.data(), blockSize);
+            delayLine.readTaps(taps, delays.data(), 1, blockSize);
+            delayLine.process(0.5, 999.0);
+        }
+    }
+
+    SECTION("Dynamics, all modes with look-ahead")
+    {
+        const adsp::dynamicsMode modes[] = {
+            adsp::dynamicsMode::compressor,
+            adsp::dynamicsMode::limiter,
+            adsp::dynamicsMode::expander};
+
+        const int blockSize = 300;
+        std::vector<double> left(blockSize, 0.5);
+        std::vector<double> right(blockSize, 0.25);
+        double *channels[] = {left.data(), right.data()};
+
+        adsp::Dynamics dynamics;
+        dynamics.reset(2, 48000.0);
+
+        for (auto mode : modes)
+        {
+            adsp::DynamicsParams params;
+            params.mode = mode;
+            params.lookAhead = 5.0;
+
+            adsp::RealtimeSection section;
+            dynamics.setParameters(params);
+            dynamics.process(channels, blockSize);
+        }
+    }
+
+    SECTION("Saturator, all shapes")
+    {
+        const adsp::saturationShape shapes[] = {
+            adsp::saturationShape::hard,
+            adsp::saturationShape::tanh,
+            adsp::saturationShape::atan,
+            adsp::saturationShape::cubic,
+            adsp::saturationShape::diode};
+
+        std::vector<double> block(256, 0.25);
+
+        for (auto shape : shapes)
+        {
+            adsp::Saturator saturator;
+            adsp::SaturatorParams params;
+            params.shape = shape;
+            params.drive = 12.0;
+            saturator.setParameters(params);
+
+            runRealtime(saturator, 4096);
+
+            adsp::RealtimeSection section;
+            saturator.processBlock(block.data(), block.data(), 256);
+        }
+    }
+
+    SECTION("Smoother, both types")
+    {
+        std::vector<double> block(256);
+
+        for (auto type : {adsp::smoothingType::linear, adsp::smoothingType::onePole})
+        {
+            adsp::Smoother smoother;
+            adsp::SmootherParams params;
+            params.type = type;
+            smoother.setParameters(params);
+            smoother.reset(48000.0, 0.0);
+
+            adsp::RealtimeSection section;
+            smoother.setTarget(1.0);
+            smoother.processBlock(block.data(), 256);
+            smoother.skip(256);
+            smoother.getNext();
+        }
+    }
+
+    SECTION("OctaveFilterBank, third octaves")
+    {
+        std::vector<double> block(1000, 0.25);
+
+        adsp::OctaveFilterBank bank;
+        bank.reset(48000.0);
+
+        adsp::RealtimeSection section;
+        bank.processBlock(block.data(), 1000);
+
+        adsp::OctaveFilterBankParams params;
+        params.bandsPerOctave = 6;
+        bank.setParameters(params);
+        bank.processBlock(block.data(), 1000);
+    }
+
+    SECTION("Oversampler, all factors and filter types")
+    {
+        const int blockSize = 256;
+        std::vector<double> block(blockSize, 0.25);
+
+        const adsp::oversamplingFilter filterTypes[] = {adsp::oversamplingFilter::iir, adsp::oversamplingFilter::fir};
+        for (auto filterType : filterTypes)
+        {
+            for (int factor = 1; factor <= 16; factor *= 2)
+            {
+                adsp::Oversampler oversampler;
+                adsp::OversamplerParams params;
+                params.factor = factor;
+                params.filterType = filterType;
+                oversampler.setParameters(params);
+                oversampler.reset(blockSize);
+
+                {
+                    adsp::RealtimeSection section;
+                    oversampler.process(block.data(), blockSize, [](double x) { return 0.5 * x; });
+                }
+            }
+        }
+    }
+
+    SECTION("Resampler, all qualities")
+    {
+        const int blockSize = 441;
+        std::vector<double> in(blockSize, 0.25);
+
+        const adsp::resamplerQuality qualities[] = {adsp::resamplerQuality::draft, adsp::resamplerQuality::normal, adsp::resamplerQuality::high};
+        for (auto quality : qualities)
+        {
+            adsp::Resampler resampler;
+            adsp::ResamplerParams params;
+            params.quality = quality;
+            resampler.setParameters(params);
+            resampler.reset(blockSize);
+
+            std::vector<double> out(resampler.getMaxOutputSamples(blockSize));
+
+            {
+                adsp::RealtimeSection section;
+                for (int b = 0; b < 10; ++b)
+                {
+                    resampler.process(in.data(), blockSize, out.data(), static_cast<int>(out.size()));
+                }
+            }
+        }
+    }
+
+    SECTION("ProcessGraph, two threads")
+    {
+        const int blockSize = 256;
+        std::vector<double> left(blockSize, 0.25);
+        std::vector<double> right(blockSize, -0.25);
+        std::vector<double> sum(blockSize);
+
+        adsp::Peak peaks[2];
+        adsp::SkLp2 lowpass;
+        adsp::ProcessGraph graph;
+        const int bus = graph.addNode(lowpass);
+        for (auto &peak : peaks)
+        {
+            peak.reset(48000.0);
+            const int input = graph.addInput();
+            const int node = graph.addNode(peak);
+            graph.connect(input, node);
+            graph.connect(node, bus);
+        }
+        graph.addOutput(bus);
+        REQUIRE(graph.prepare(100, 2));
+
+        const double *inputs[] = {left.data(), right.data()};
+        double *outputs[] = {sum.data()};
+        {
+            adsp::RealtimeSection section;
+            for (int b = 0; b < 10; ++b)
+            {
+                graph.process(inputs, outputs, blockSize);
+            }
+        }
+    }
+
+    const adsp::RealtimeViolations violations = adsp::getRealtimeViolations();
+    REQUIRE(violations.allocations == 0);
+    REQUIRE(violations.deallocations == 0);
+    REQUIRE(violations.locks == 0);
+}
+
+#ifdef ADSP_REALTIME_CHECKS
+TEST_CASE("Realtime checker detects violations", "[debug]")
+{
+    adsp::resetRealtimeViolations();
+
+    SECTION("Allocations")
+    {
+        {
+            adsp::RealtimeSection section;
+            realtimeCheckSink = new std::vector<double>(64);
+            delete static_cast<std::vector<double> *>(realtimeCheckSink);
+        }
+
+        const adsp::RealtimeViolations violations = adsp::getRealtimeViolations();
+        REQUIRE(violations.allocations >= 2);
+        REQUIRE(violations.deallocations >= 2);
+    }
+
+    SECTION("Locks")
+    {
+        std::mutex mutex;
+        {
+            adsp::RealtimeSection section;
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+
+        REQUIRE(adsp::getRealtimeViolations().locks == 1);
+    }
+
+    SECTION("Nothing is counted outside of sections")
+    {
+        realtimeCheckSink = new std::vector<double>(64);
+        delete static_cast<std::vector<double> *>(realtimeCheckSink);
+
+        REQUIRE(adsp::getRealtimeViolations().total() == 0);
+    }
+
+    SECTION("Handler is called on the violating thread")
+    {
+        static int numCalls = 0;
+        numCalls = 0;
+        adsp::setRealtimeViolationHandler([](adsp::realtimeViolation) { ++numCalls; });
+
+        bool wasInSection = false;
+        {
+            ADSP_REALTIME_SECTION();
+            wasInSection = adsp::isInRealtimeSection();
+            realtimeCheckSink = new std::vector<double>(64);
+            delete static_cast<std::vector<double> *>(realtimeCheckSink);
+        }
+        adsp::setRealtimeViolationHandler(nullptr);
+
+        REQUIRE(wasInSection);
+        REQUIRE_FALSE(adsp::isInRealtimeSection());
+        REQUIRE(numCalls == static_cast<int>(adsp::getRealtimeViolations().total()));
+        REQUIRE(numCalls >= 4);
+    }
+}
+#endif
@@ -0,0 +1,251 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    const adsp::delayInterpolation delayTestInterpolations[] = {
+        adsp::delayInterpolation::none,
+        adsp::delayInterpolation::linear,
+        adsp::delayInterpolation::lagrange,
+        adsp::delayInterpolation::cubic,
+        adsp::delayInterpolation::thiran};
+
+    void setInterpolation(adsp::DelayLine &delayLine, adsp::delayInterpolation interpolation)
+    {
+        adsp::DelayLineParams params;
+        params.interpolation = interpolation;
+        delayLine.setParameters(params);
+    }
+
+    // Maximum deviation of a delayed sine from the exact delayed sine, after settling
+    double delayedSineError(adsp::delayInterpolation interpolation, double delay, double frequency)
+    {
+        adsp::DelayLine delayLine;
+        delayLine.prepare(64);
+        setInterpolation(delayLine, interpolation);
+
+        double maxError = 0.0;
+        for (int n = 0; n < 2000; ++n)
+        {
+            const double y = delayLine.process(sin(adsp::TWO_PI * frequency * n), delay);
+            if (n > 1000)
+            {
+                maxError = std::max(maxError, fabs(y - sin(adsp::TWO_PI * frequency * (n - delay))));
+            }
+        }
+        return maxError;
+    }
+}
+
+TEST_CASE("DelayLine integer delays are exact", "[delay]")
+{
+    for (auto interpolation : delayTestInterpolations)
+    {
+        if (interpolation == adsp::delayInterpolation::thiran)
+        {
+            continue;
+        }
+
+        adsp::DelayLine delayLine;
+        delayLine.prepare(100);
+        setInterpolation(delayLine, interpolation);
+
+        for (int n = 0; n < 1000; ++n)
+        {
+            delayLine.write(n);
+            REQUIRE(delayLine.read(1.0) == Approx(std::max(n - 1, 0)).margin(1e-12));
+            REQUIRE(delayLine.read(37.0) == Approx(std::max(n - 37, 0)).margin(1e-12));
+            REQUIRE(delayLine.read(100.0) == Approx(std::max(n - 100, 0)).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("DelayLine delays are clamped to the valid range", "[delay]")
+{
+    adsp::DelayLine delayLine;
+    delayLine.prepare(10);
+    CHECK(delayLine.getMaxDelay() == 10);
+
+    for (int n = 0; n < 100; ++n)
+    {
+        delayLine.write(n);
+    }
+
+    setInterpolation(delayLine, adsp::delayInterpolation::linear);
+    CHECK(delayLine.read(50.0) == Approx(89.0).margin(1e-12));
+    CHECK(delayLine.read(-3.0) == Approx(99.0).margin(1e-12));
+
+    setInterpolation(delayLine, adsp::delayInterpolation::cubic);
+    CHECK(delayLine.read(0.25) == Approx(98.0).margin(1e-12));
+}
+
+TEST_CASE("DelayLine fractional delay accuracy", "[delay]")
+{
+    // Low frequency sine at 0.01 * sample rate
+    const double frequency = 0.01;
+    for (double delay : {1.25, 7.5, 20.8})
+    {
+        CHECK(delayedSineError(adsp::delayInterpolation::linear, delay, frequency) < 1e-3);
+        CHECK(delayedSineError(adsp::delayInterpolation::lagrange, delay, frequency) < 2e-6);
+        CHECK(delayedSineError(adsp::delayInterpolation::cubic, delay, frequency) < 2e-5);
+        CHECK(delayedSineError(adsp::delayInterpolation::thiran, delay, frequency) < 5e-5);
+    }
+
+    // Lagrange interpolation reproduces cubic polynomials
+    adsp::DelayLine delayLine;
+    delayLine.prepare(16);
+    setInterpolation(delayLine, adsp::delayInterpolation::lagrange);
+    for (int n = 0; n < 40; ++n)
+    {
+        const double t = 0.1 * n;
+        delayLine.write(t * t * t - 2.0 * t);
+    }
+    const double t = 0.1 * (39 - 3.3);
+    CHECK(delayLine.read(3.3) == Approx(t * t * t - 2.0 * t).margin(1e-12));
+}
+
+TEST_CASE("DelayLine Thiran interpolation is allpass", "[delay]")
+{
+    adsp::DelayLine delayLine;
+    delayLine.prepare(16);
+    setInterpolation(delayLine, adsp::delayInterpolation::thiran);
+
+    // Energy of the impulse response equals the input energy
+    double energy = 0.0;
+    for (int n = 0; n < 2000; ++n)
+    {
+        const double y = delayLine.process(n == 0 ? 1.0 : 0.0, 4.3);
+        energy += y * y;
+    }
+    CHECK(energy == Approx(1.0).margin(1e-9));
+}
+
+TEST_CASE("DelayLine block reads match single sample reads", "[delay]")
+{
+    const int blockSize = 37;
+    const int maxDelay = 50;
+    const double delays[] = {0.0, 0.6, 3.25, 17.5, 49.9};
+    const int numTaps = 5;
+
+    for (auto interpolation : delayTestInterpolations)
+    {
+        adsp::DelayLine single;
+        single.prepare(maxDelay);
+        setInterpolation(single, interpolation);
+
+        adsp::DelayLine block;
+        block.prepare(maxDelay, blockSize);
+        setInterpolation(block, interpolation);
+
+        adsp::DelayLine modulated;
+        modulated.prepare(maxDelay, blockSize);
+        setInterpolation(modulated, interpolation);
+
+        std::vector<double> in(blockSize);
+        std::vector<double> taps(numTaps * blockSize);
+        double *tapPointers[numTaps];
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            tapPointers[tap] = &taps[tap * blockSize];
+        }
+        std::vector<double> modulatedDelays(blockSize, delays[2]);
+        std::vector<double> out(blockSize);
+
+        // Enough blocks to wrap around the ring several times
+        double x = 0.3;
+        for (int b = 0; b < 40; ++b)
+        {
+            for (int n = 0; n < blockSize; ++n)
+            {
+                x = 3.9 * x * (1.0 - x);
+                in[n] = x - 0.5;
+            }
+
+            block.writeBlock(in.data(), blockSize);
+            block.readTaps(tapPointers, delays, numTaps, blockSize);
+
+            modulated.writeBlock(in.data(), blockSize);
+            modulated.readBlockModulated(out.data(), modulatedDelays.data(), blockSize);
+
+            for (int n = 0; n < blockSize; ++n)
+            {
+                single.write(in[n]);
+
+                // Thiran taps have state, only tap 0 of the single sample line is comparable
+                const int numCompared = interpolation == adsp::delayInterpolation::thiran ? 1 : numTaps;
+                for (int tap = 0; tap < numCompared; ++tap)
+                {
+                    REQUIRE(taps[tap * blockSize + n] == Approx(single.read(delays[tap])).margin(1e-12));
+                }
+
+                if (interpolation != adsp::delayInterpolation::thiran)
+                {
+                    REQUIRE(out[n] == Approx(taps[2 * blockSize + n]).margin(1e-12));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("DelayLine rejects blocks that do not fit", "[delay]")
+{
+    const int blockSize = 16;
+    std::vector<double> in(1024, 1.0);
+    std::vector<double> out(1024, 0.5);
+
+    // Before prepare() there is no ring
+    adsp::DelayLine delayLine;
+    delayLine.write(1.0);
+    delayLine.writeBlock(in.data(), blockSize);
+    CHECK(delayLine.read(0.0) == 0.0);
+    delayLine.readBlock(out.data(), blockSize, 1.0);
+    CHECK(out[0] == 0.0);
+    CHECK(out[blockSize] == 0.5);
+
+    delayLine.prepare(10, blockSize);
+    for (int n = 0; n < 4 * blockSize; ++n)
+    {
+        delayLine.write(0.25);
+    }
+
+    // A block longer than the ring is ignored, the content is kept
+    delayLine.writeBlock(in.data(), static_cast<int>(in.size()));
+    CHECK(delayLine.read(3.0) == 0.25);
+
+    std::fill(out.begin(), out.end(), 0.5);
+    delayLine.readBlock(out.data(), blockSize + 1, 0.0);
+    std::vector<double> delays(blockSize + 1, 2.0);
+    delayLine.readBlockModulated(out.data() + blockSize + 1, delays.data(), blockSize + 1);
+    for (int n = 0; n < 2 * (blockSize + 1); ++n)
+    {
+        REQUIRE(out[n] == 0.0);
+    }
+    CHECK(out[2 * (blockSize + 1)] == 0.5);
+
+    // More taps than interpolator states
+    adsp::DelayLineParams params;
+    params.interpolation = adsp::delayInterpolation::thiran;
+    delayLine.setParameters(params);
+    const int numTaps = adsp::MAX_DELAY_TAPS + 1;
+    std::vector<double> tapDelays(numTaps, 2.0);
+    std::vector<double *> tapPointers(numTaps);
+    std::fill(out.begin(), out.end(), 0.5);
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        tapPointers[tap] = out.data() + tap * blockSize;
+    }
+    delayLine.readTaps(tapPointers.data(), tapDelays.data(), numTaps, blockSize);
+    for (int n = 0; n < numTaps * blockSize; ++n)
+    {
+        REQUIRE(out[n] == 0.0);
+    }
+
+    delayLine.readTaps(tapPointers.data(), tapDelays.data(), adsp::MAX_DELAY_TAPS, blockSize);
+    CHECK(out[0] == Approx(0.25));
+}
@@ -0,0 +1,270 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Runs a constant level through the processor and returns the settled output level [dB]
+    double dynamicsSettledGain(adsp::Dynamics &dynamics, double leveldB)
+    {
+        const double level = adsp::dbToRawGain(leveldB);
+        std::vector<double> block(48000, level);
+        double *channels[] = {block.data()};
+        dynamics.process(channels, static_cast<int>(block.size()));
+        return adsp::rawGainTodB(block.back()) - leveldB;
+    }
+
+    // Feeds planar stereo in irregular block sizes
+    void dynamicsProcessChunked(adsp::Dynamics &dynamics, std::vector<double> &left, std::vector<double> &right)
+    {
+        const int numSamples = static_cast<int>(left.size());
+        int offset = 0;
+        int blockSize = 1;
+        while (offset < numSamples)
+        {
+            const int numBlock = std::min(blockSize, numSamples - offset);
+            double *channels[] = {left.data() + offset, right.data() + offset};
+            dynamics.process(channels, numBlock);
+            offset += numBlock;
+            blockSize = blockSize * 5 % 311 + 1;
+        }
+    }
+}
+
+TEST_CASE("Dynamics static curves", "[dynamics]")
+{
+    adsp::Dynamics dynamics;
+    dynamics.reset(1, 48000.0);
+    adsp::DynamicsParams params;
+    params.knee = 0.0;
+
+    SECTION("Compressor")
+    {
+        params.threshold = -20.0;
+        params.ratio = 4.0;
+        dynamics.setParameters(params);
+
+        CHECK(dynamics.getStaticGaindB(-30.0) == Approx(0.0).margin(1e-12));
+        CHECK(dynamics.getStaticGaindB(-10.0) == Approx(-7.5).margin(1e-12));
+        CHECK(dynamicsSettledGain(dynamics, -10.0) == Approx(-7.5).margin(0.05));
+        CHECK(dynamics.getGainReductiondB(0) == Approx(-7.5).margin(0.05));
+    }
+
+    SECTION("Limiter with makeup gain")
+    {
+        params.mode = adsp::dynamicsMode::limiter;
+        params.threshold = -6.0;
+        params.makeup = 3.0;
+        dynamics.setParameters(params);
+
+        CHECK(dynamics.getStaticGaindB(-20.0) == Approx(3.0).margin(1e-12));
+        CHECK(dynamics.getStaticGaindB(0.0) == Approx(-3.0).margin(1e-12));
+        CHECK(dynamicsSettledGain(dynamics, 0.0) == Approx(-3.0).margin(0.05));
+    }
+
+    SECTION("Expander")
+    {
+        params.mode = adsp::dynamicsMode::expander;
+        params.threshold = -40.0;
+        params.ratio = 2.0;
+        dynamics.setParameters(params);
+
+        CHECK(dynamics.getStaticGaindB(-30.0) == Approx(0.0).margin(1e-12));
+        CHECK(dynamics.getStaticGaindB(-50.0) == Approx(-10.0).margin(1e-12));
+        CHECK(dynamicsSettledGain(dynamics, -50.0) == Approx(-10.0).margin(0.05));
+    }
+
+    SECTION("Soft knee is continuous with a continuous slope")
+    {
+        for (auto mode : {adsp::dynamicsMode::compressor, adsp::dynamicsMode::expander})
+        {
+            params.mode = mode;
+            params.threshold = -20.0;
+            params.ratio = 2.0;
+            params.knee = 10.0;
+            dynamics.setParameters(params);
+
+            double previous = dynamics.getStaticGaindB(-40.0);
+            double previousSlope = (previous - dynamics.getStaticGaindB(-40.01)) / 0.01;
+            for (double level = -39.99; level < 0.0; level += 0.01)
+            {
+                const double gain = dynamics.getStaticGaindB(level);
+                const double slope = (gain - previous) / 0.01;
+                REQUIRE(fabs(gain - previous) < 0.02);
+                REQUIRE(fabs(slope - previousSlope) < 0.01);
+                previous = gain;
+                previousSlope = slope;
+            }
+
+            // At the threshold the knee reduces by slope * knee / 8
+            const double expected = mode == adsp::dynamicsMode::compressor ? -0.5 * 10.0 / 8.0 : -10.0 / 8.0;
+            CHECK(dynamics.getStaticGaindB(-20.0) == Approx(expected).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("Dynamics attack and release times", "[dynamics]")
+{
+    adsp::Dynamics dynamics;
+    dynamics.reset(1, 48000.0);
+    adsp::DynamicsParams params;
+    params.mode = adsp::dynamicsMode::limiter;
+    params.threshold = -20.0;
+    params.knee = 0.0;
+    params.attack = 10.0;
+    params.release = 50.0;
+    dynamics.setParameters(params);
+
+    // A step 20 dB over the threshold, one attack time later 1 - 1/e of the reduction
+    std::vector<double> block(480, 1.0);
+    double *channels[] = {block.data()};
+    dynamics.process(channels, 480);
+    CHECK(dynamics.getGainReductiondB(0) == Approx(-20.0 * (1.0 - exp(-1.0))).margin(0.05));
+
+    // Settle, then release for one release time
+    block.assign(48000, 1.0);
+    channels[0] = block.data();
+    dynamics.process(channels, 48000);
+    block.assign(2400, 0.01);
+    channels[0] = block.data();
+    dynamics.process(channels, 2400);
+    CHECK(dynamics.getGainReductiondB(0) == Approx(-20.0 * exp(-1.0)).margin(0.05));
+}
+
+TEST_CASE("Dynamics look-ahead catches transients", "[dynamics]")
+{
+    const double sampleRate = 48000.0;
+    adsp::Dynamics dynamics;
+    dynamics.reset(1, sampleRate);
+    adsp::DynamicsParams params;
+    params.mode = adsp::dynamicsMode::limiter;
+    params.threshold = -6.0;
+    params.knee = 0.0;
+    params.attack = 1.0;
+    params.lookAhead = 6.0;
+    dynamics.setParameters(params);
+
+    const int latency = dynamics.getLatency();
+    CHECK(latency == 288);
+
+    // Quiet signal followed by a step to full scale
+    std::vector<double> block(9600, 0.1);
+    std::fill(block.begin() + 4800, block.end(), 1.0);
+    const std::vector<double> input(block);
+    double *channels[] = {block.data()};
+    dynamics.process(channels, static_cast<int>(block.size()));
+
+    // The input arrives delayed by the latency, untouched below the threshold
+    for (int n = latency; n < 4800; ++n)
+    {
+        REQUIRE(block[n] == Approx(input[n - latency]).margin(1e-3));
+    }
+
+    // The step never passes the threshold by more than the attack residual
+    double maxOutput = 0.0;
+    for (double y : block)
+    {
+        maxOutput = std::max(maxOutput, y);
+    }
+    CHECK(adsp::rawGainTodB(maxOutput) < -6.0 + 0.1);
+
+    // Without look-ahead the step passes
+    params.lookAhead = 0.0;
+    dynamics.setParameters(params);
+    dynamics.reset(1, sampleRate);
+    block = input;
+    dynamics.process(channels, static_cast<int>(block.size()));
+    CHECK(block[4800] > 0.9);
+}
+
+TEST_CASE("Dynamics channel linking", "[dynamics]")
+{
+    adsp::DynamicsParams params;
+    params.threshold = -20.0;
+    params.knee = 0.0;
+
+    for (double link : {0.0, 0.5, 1.0})
+    {
+        adsp::Dynamics dynamics;
+        dynamics.reset(2, 48000.0);
+        params.link = link;
+        dynamics.setParameters(params);
+
+        // Loud left, quiet right
+        std::vector<double> left(48000, adsp::dbToRawGain(-4.0));
+        std::vector<double> right(48000, adsp::dbToRawGain(-30.0));
+        double *channels[] = {left.data(), right.data()};
+        dynamics.process(channels, 48000);
+
+        CHECK(dynamics.getGainReductiondB(0) == Approx(-12.0).margin(0.05));
+
+        // The right channel follows the blended level
+        const double detected = -30.0 + link * 26.0;
+        const double expected = detected > -20.0 ? -0.75 * (detected + 20.0) : 0.0;
+        CHECK(dynamics.getGainReductiondB(1) == Approx(expected).margin(0.05));
+    }
+
+    // Linked detection of near-silent material follows the channels down to the
+    // level floor
+    adsp::DynamicsParams expanderParams;
+    expanderParams.mode = adsp::dynamicsMode::expander;
+    expanderParams.threshold = -160.0;
+    expanderParams.ratio = 2.0;
+    expanderParams.knee = 0.0;
+    expanderParams.link = 1.0;
+
+    adsp::Dynamics expander;
+    expander.reset(2, 48000.0);
+    expander.setParameters(expanderParams);
+
+    std::vector<double> left(48000, adsp::dbToRawGain(-180.0));
+    std::vector<double> right(left);
+    double *channels[] = {left.data(), right.data()};
+    expander.process(channels, 48000);
+    CHECK(expander.getGainReductiondB(0) == Approx(-20.0).margin(0.05));
+    CHECK(expander.getGainReductiondB(1) == Approx(-20.0).margin(0.05));
+}
+
+TEST_CASE("Dynamics block size does not change the output", "[dynamics]")
+{
+    adsp::DynamicsParams params;
+    params.threshold = -30.0;
+    params.attack = 2.0;
+    params.release = 30.0;
+    params.lookAhead = 3.0;
+    params.link = 0.7;
+
+    adsp::Dynamics a;
+    a.reset(2, 44100.0);
+    a.setParameters(params);
+    adsp::Dynamics b;
+    b.reset(2, 44100.0);
+    b.setParameters(params);
+
+    std::vector<double> left(20000);
+    std::vector<double> right(20000);
+    double x = 0.3;
+    for (size_t n = 0; n < left.size(); ++n)
+    {
+        x = 3.9 * x * (1.0 - x);
+        left[n] = (x - 0.5) * sin(0.001 * n);
+        right[n] = 0.3 * (x - 0.5);
+    }
+    std::vector<double> leftChunked(left);
+    std::vector<double> rightChunked(right);
+
+    double *channels[] = {left.data(), right.data()};
+    a.process(channels, static_cast<int>(left.size()));
+    dynamicsProcessChunked(b, leftChunked, rightChunked);
+
+    for (size_t n = 0; n < left.size(); ++n)
+    {
+        REQUIRE(leftChunked[n] == left[n]);
+        REQUIRE(rightChunked[n] == right[n]);
+    }
+}
@@ -0,0 +1,282 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    const adsp::biquadAlgorithm biquadTestAlgorithms[] = {
+        adsp::biquadAlgorithm::direct,
+        adsp::biquadAlgorithm::canonical,
+        adsp::biquadAlgorithm::transposedDirect,
+        adsp::biquadAlgorithm::transposedCanonical,
+        adsp::biquadAlgorithm::errorFeedbackDirect,
+        adsp::biquadAlgorithm::stateVariable};
+
+    // Test responses: 0 = Butterworth lowpass, 1 = RBJ peak, 2 = Butterworth highpass
+    void biquadTestCoefficients(double *coefficients, int type, double fc, double sampleRate)
+    {
+        if (type == 1)
+        {
+            adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, fc, 2.0, 6.0, sampleRate);
+            return;
+        }
+
+        adsp::FilterDesignParams params;
+        params.order = 2;
+        params.fc = fc;
+        params.sampleRate = sampleRate;
+        params.response = type == 0 ? adsp::designResponse::lowpass : adsp::designResponse::highpass;
+        const adsp::FilterDesign design = adsp::designFilter(params);
+        memcpy(coefficients, design.sections[0], sizeof(double) * adsp::numCoefficients);
+    }
+
+    // Noise plus a sine inside the passband of the lowpass
+    std::vector<float> biquadTestSignal(int numSamples, double frequency, double sampleRate)
+    {
+        std::vector<float> signal(numSamples);
+        uint32_t seed = 1;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const double noise = static_cast<int32_t>(seed) / 2147483648.0;
+            signal[n] = static_cast<float>(0.25 * noise + 0.5 * sin(adsp::TWO_PI * frequency * n / sampleRate));
+        }
+        return signal;
+    }
+
+    // RMS deviation of the single precision filter from the double precision direct form [dBFS]
+    double biquadNoiseFloor(adsp::biquadAlgorithm algorithm, double *coefficients, const std::vector<float> &signal)
+    {
+        adsp::Biquad reference;
+        reference.setCoefficients(coefficients);
+
+        adsp::BiquadParams params;
+        params.calculationType = algorithm;
+        adsp::BiquadFloat filter;
+        filter.setParameters(params);
+        filter.setCoefficients(coefficients);
+
+        // Skip the settling time
+        const size_t start = signal.size() / 4;
+        double errorPower = 0.0;
+        for (size_t n = 0; n < signal.size(); ++n)
+        {
+            const double error = filter.process(signal[n]) - reference.process(signal[n]);
+            if (n >= start)
+            {
+                errorPower += error * error;
+            }
+        }
+        return 10.0 * log10(errorPower / (signal.size() - start));
+    }
+}
+
+TEST_CASE("Biquad algorithms implement the same difference equation", "[filter]")
+{
+    std::vector<double> coefficientSets;
+    double coefficients[adsp::numCoefficients];
+    for (int type = 0; type < 3; ++type)
+    {
+        biquadTestCoefficients(coefficients, type, 1000.0, 48000.0);
+        coefficientSets.insert(coefficientSets.end(), coefficients, coefficients + adsp::numCoefficients);
+    }
+
+    // Real poles (Q below 0.5) and a first-order section
+    const double realPoles[adsp::numCoefficients] = {0.02, 0.01, -0.005, -1.6, 0.63};
+    const double firstOrder[adsp::numCoefficients] = {0.1, 0.1, 0.0, -0.8, 0.0};
+    coefficientSets.insert(coefficientSets.end(), realPoles, realPoles + adsp::numCoefficients);
+    coefficientSets.insert(coefficientSets.end(), firstOrder, firstOrder + adsp::numCoefficients);
+
+    const std::vector<float> signal = biquadTestSignal(4800, 700.0, 48000.0);
+
+    for (size_t set = 0; set < coefficientSets.size() / adsp::numCoefficients; ++set)
+    {
+        double *setCoefficients = &coefficientSets[set * adsp::numCoefficients];
+        adsp::Biquad reference;
+        reference.setCoefficients(setCoefficients);
+
+        for (auto algorithm : biquadTestAlgorithms)
+        {
+            adsp::BiquadParams params;
+            params.calculationType = algorithm;
+            adsp::Biquad filter;
+            filter.setParameters(params);
+            filter.setCoefficients(setCoefficients);
+            reference.reset();
+
+            for (float x : signal)
+            {
+                REQUIRE(filter.process(x) == Approx(reference.process(x)).margin(1e-12));
+            }
+        }
+    }
+}
+
+TEST_CASE("Coefficients can be set before the algorithm", "[filter]")
+{
+    double coefficients[adsp::numCoefficients];
+    biquadTestCoefficients(coefficients, 1, 1000.0, 48000.0);
+
+    adsp::Biquad reference;
+    reference.setCoefficients(coefficients);
+
+    adsp::Biquad filter;
+    filter.setCoefficients(coefficients);
+    adsp::BiquadParams params;
+    params.calculationType = adsp::biquadAlgorithm::stateVariable;
+    filter.setParameters(params);
+
+    for (int n = 0; n < 1000; ++n)
+    {
+        const double x = sin(0.05 * n);
+        REQUIRE(filter.process(x) == Approx(reference.process(x)).margin(1e-12));
+    }
+}
+
+TEST_CASE("Single precision noise floor at low cutoff frequencies", "[filter]")
+{
+    const double sampleRate = 192000.0;
+    double coefficients[adsp::numCoefficients];
+
+    for (double fc : {adsp::MIN_FILTER_FREQ, 50.0, 200.0})
+    {
+        const std::vector<float> signal = biquadTestSignal(192000, 0.7 * fc, sampleRate);
+
+        // Lowpass: the error feedback form is close to the input quantization
+        biquadTestCoefficients(coefficients, 0, fc, sampleRate);
+        CHECK(biquadNoiseFloor(adsp::biquadAlgorithm::errorFeedbackDirect, coefficients, signal) < -125.0);
+        CHECK(biquadNoiseFloor(adsp::biquadAlgorithm::stateVariable, coefficients, signal) < -95.0);
+
+        // Peak and highpass: the state-variable form is robust for every response
+        for (int type = 1; type < 3; ++type)
+        {
+            biquadTestCoefficients(coefficients, type, fc, sampleRate);
+            CHECK(biquadNoiseFloor(adsp::biquadAlgorithm::stateVariable, coefficients, signal) < -95.0);
+        }
+    }
+
+    // The direct forms are not usable in single precision at the lower end
+    const std::vector<float> signal = biquadTestSignal(192000, 14.0, sampleRate);
+    biquadTestCoefficients(coefficients, 0, adsp::MIN_FILTER_FREQ, sampleRate);
+    CHECK(biquadNoiseFloor(adsp::biquadAlgorithm::direct, coefficients, signal) > -60.0);
+    CHECK(biquadNoiseFloor(adsp::biquadAlgorithm::transposedCanonical, coefficients, signal) > -60.0);
+}
+
+TEST_CASE("BiquadFloat block processing", "[filter]")
+{
+    double coefficients[adsp::numCoefficients];
+    biquadTestCoefficients(coefficients, 1, 100.0, 48000.0);
+    const std::vector<float> signal = biquadTestSignal(4096, 70.0, 48000.0);
+
+    for (auto algorithm : biquadTestAlgorithms)
+    {
+        adsp::BiquadParams params;
+        params.calculationType = algorithm;
+        adsp::BiquadFloat single;
+        single.setParameters(params);
+        single.setCoefficients(coefficients);
+        adsp::BiquadFloat block;
+        block.setParameters(params);
+        block.setCoefficients(coefficients);
+
+        std::vector<float> output(signal);
+        block.processBlock(output.data(), output.data(), 1000);
+        block.processBlock(output.data() + 1000, output.data() + 1000, static_cast<int>(output.size()) - 1000);
+
+        for (size_t n = 0; n < signal.size(); ++n)
+        {
+            REQUIRE(output[n] == single.process(signal[n]));
+        }
+    }
+}
+
+TEST_CASE("Biquad block and strided processing", "[filter]")
+{
+    double coefficients[adsp::numCoefficients];
+    biquadTestCoefficients(coefficients, 1, 100.0, 48000.0);
+    const std::vector<float> signal = biquadTestSignal(3000, 70.0, 48000.0);
+
+    for (auto algorithm : biquadTestAlgorithms)
+    {
+        adsp::BiquadParams params;
+        params.calculationType = algorithm;
+        adsp::Biquad single;
+        single.setParameters(params);
+        single.setCoefficients(coefficients);
+        adsp::Biquad block = single;
+        adsp::Biquad strided = single;
+
+        // Block and in-place strided processing of one channel of a stereo buffer
+        std::vector<double> output(signal.begin(), signal.end());
+        std::vector<double> interleaved(2 * signal.size(), 1.0);
+        for (size_t n = 0; n < signal.size(); ++n)
+        {
+            interleaved[2 * n + 1] = signal[n];
+        }
+        block.processBlock(output.data(), output.data(), 1000);
+        block.processBlock(output.data() + 1000, output.data() + 1000, static_cast<int>(output.size()) - 1000);
+        strided.processStrided(interleaved.data() + 1, interleaved.data() + 1, 2, static_cast<int>(signal.size()));
+
+        for (size_t n = 0; n < signal.size(); ++n)
+        {
+            const double y = single.process(signal[n]);
+            REQUIRE(output[n] == y);
+            REQUIRE(interleaved[2 * n + 1] == y);
+            REQUIRE(interleaved[2 * n] == 1.0);
+        }
+    }
+}
+
+TEST_CASE("Biquad interleaved processing", "[filter]")
+{
+    // Groups of eight and four, single channels, frames with a padding sample
+    for (int numChannels : {1, 2, 4, 8, 13})
+    {
+        const int frameStride = numChannels + 1;
+        const int numFrames = 700;
+
+        std::vector<adsp::Biquad> biquads(numChannels);
+        std::vector<adsp::Biquad> references(numChannels);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            // One channel with another algorithm splits the groups
+            adsp::BiquadParams params;
+            params.calculationType = channel == 9 ? adsp::biquadAlgorithm::direct : adsp::biquadAlgorithm::transposedCanonical;
+            biquads[channel].setParameters(params);
+            references[channel].setParameters(params);
+
+            double coefficients[adsp::numCoefficients];
+            biquadTestCoefficients(coefficients, channel % 3, 50.0 + 300.0 * channel, 48000.0);
+            biquads[channel].setCoefficients(coefficients);
+            references[channel].setCoefficients(coefficients);
+        }
+
+        std::vector<double> data(frameStride * numFrames, -1.0);
+        const std::vector<float> signal = biquadTestSignal(numChannels * numFrames, 70.0, 48000.0);
+        for (int n = 0; n < numFrames; ++n)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                data[n * frameStride + channel] = signal[n * numChannels + channel];
+            }
+        }
+
+        adsp::Biquad::processInterleaved(biquads.data(), numChannels, data.data(), frameStride, 300);
+        adsp::Biquad::processInterleaved(biquads.data(), numChannels, data.data() + 300 * frameStride, frameStride, numFrames - 300);
+
+        for (int n = 0; n < numFrames; ++n)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                REQUIRE(data[n * frameStride + channel] == references[channel].process(signal[n * numChannels + channel]));
+            }
+            REQUIRE(data[n * frameStride + numChannels] == -1.0);
+        }
+    }
+}
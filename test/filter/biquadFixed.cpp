@@ -0,0 +1,274 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Coefficients of the test filters: 0 = 2nd-order Butterworth lowpass, 1 = RBJ peak
+    void fixedTestCoefficients(double *coefficients, int type, double fc)
+    {
+        if (type == 0)
+        {
+            adsp::FilterDesignParams params;
+            params.order = 2;
+            params.fc = fc;
+            params.sampleRate = 48000.0;
+            const adsp::FilterDesign design = adsp::designFilter(params);
+            memcpy(coefficients, design.sections[0], sizeof(double) * adsp::numCoefficients);
+        }
+        else
+        {
+            adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, fc, 2.0, 6.0, 48000.0);
+        }
+    }
+
+    // Half scale white noise
+    std::vector<double> fixedTestNoise(int numSamples)
+    {
+        std::vector<double> noise(numSamples);
+        uint32_t seed = 1;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            noise[n] = 0.5 * static_cast<int32_t>(seed) / 2147483648.0;
+        }
+        return noise;
+    }
+
+    struct FixedError
+    {
+        double max = 0.0;
+        double mean = 0.0;
+    };
+
+    // Deviation from a double precision Biquad running the dequantized coefficients,
+    // isolates the arithmetic error from the coefficient quantization
+    template <typename Filter, typename Sample>
+    FixedError fixedArithmeticError(Filter &filter, int fractionalBits, const std::vector<double> &input)
+    {
+        double coefficients[adsp::numCoefficients];
+        for (int i = 0; i < adsp::numCoefficients; ++i)
+        {
+            coefficients[i] = ldexp(filter.getCoefficients()[i], filter.getPostShift() - fractionalBits);
+        }
+        adsp::Biquad reference;
+        reference.setCoefficients(coefficients);
+
+        FixedError error;
+        for (double x : input)
+        {
+            const Sample sample = static_cast<Sample>(lrint(ldexp(x, fractionalBits)));
+            const double deviation = filter.process(sample) - reference.process(sample);
+            error.max = std::max(error.max, fabs(deviation));
+            error.mean += deviation;
+        }
+        error.mean /= input.size();
+        return error;
+    }
+}
+
+TEST_CASE("Fixed-point post shift", "[filter]")
+{
+    double coefficients[adsp::numCoefficients] = {0.5, 0.3, 0.1, 0.4, 0.2};
+    CHECK(adsp::calculateFixedPostShift(coefficients) == 0);
+
+    // b1 near -2 for a low cutoff
+    fixedTestCoefficients(coefficients, 0, 100.0);
+    CHECK(adsp::calculateFixedPostShift(coefficients) == 1);
+
+    // Boosting peak, the numerator sum exceeds 2
+    adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 1000.0, 0.5, 18.0, 48000.0);
+    CHECK(adsp::calculateFixedPostShift(coefficients) == 2);
+}
+
+TEST_CASE("BiquadQ31", "[filter]")
+{
+    const std::vector<double> input = fixedTestNoise(48000);
+
+    SECTION("Arithmetic error within a few LSB")
+    {
+        for (double fc : {1000.0, 5000.0, 15000.0})
+        {
+            for (int type = 0; type < 2; ++type)
+            {
+                double coefficients[adsp::numCoefficients];
+                fixedTestCoefficients(coefficients, type, fc);
+                adsp::BiquadQ31 filter;
+                filter.setCoefficients(coefficients);
+
+                const FixedError error = fixedArithmeticError<adsp::BiquadQ31, int32_t>(filter, 31, input);
+                CHECK(error.max < 8.0);
+                CHECK(fabs(error.mean) < 0.05);
+            }
+        }
+    }
+
+    SECTION("Close to the floating point filter")
+    {
+        double coefficients[adsp::numCoefficients];
+        fixedTestCoefficients(coefficients, 0, 1000.0);
+        adsp::BiquadQ31 filter;
+        filter.setCoefficients(coefficients);
+        adsp::Biquad reference;
+        reference.setCoefficients(coefficients);
+
+        double maxError = 0.0;
+        for (double x : input)
+        {
+            const int32_t sample = static_cast<int32_t>(lrint(ldexp(x, 31)));
+            const double y = ldexp(filter.process(sample), -31);
+            maxError = std::max(maxError, fabs(y - reference.process(ldexp(sample, -31))));
+        }
+        CHECK(maxError < 1e-7);
+    }
+
+    SECTION("Error feedback removes the truncation bias")
+    {
+        double coefficients[adsp::numCoefficients];
+        fixedTestCoefficients(coefficients, 0, 1000.0);
+        adsp::BiquadQ31 filter;
+        filter.setCoefficients(coefficients);
+
+        adsp::BiquadFixedParams params;
+        params.errorFeedback = false;
+        filter.setParameters(params);
+        const FixedError truncated = fixedArithmeticError<adsp::BiquadQ31, int32_t>(filter, 31, input);
+
+        params.errorFeedback = true;
+        filter.setParameters(params);
+        filter.reset();
+        const FixedError shaped = fixedArithmeticError<adsp::BiquadQ31, int32_t>(filter, 31, input);
+
+        CHECK(fabs(truncated.mean) > 10.0);
+        CHECK(fabs(shaped.mean) < 0.05);
+        CHECK(shaped.max < truncated.max);
+    }
+
+    SECTION("Saturates instead of wrapping")
+    {
+        double coefficients[adsp::numCoefficients];
+        adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 1000.0, 1.0, 12.0, 48000.0);
+        adsp::BiquadQ31 filter;
+        filter.setCoefficients(coefficients);
+
+        for (int n = 0; n < 4800; ++n)
+        {
+            const double x = 0.9 * sin(adsp::TWO_PI * 1000.0 * n / 48000.0);
+            const int32_t y = filter.process(static_cast<int32_t>(lrint(ldexp(x, 31))));
+            if (n > 2400 && fabs(x) > 0.5)
+            {
+                CHECK(((y > 0) == (x > 0)));
+            }
+        }
+    }
+
+    SECTION("Block processing matches single samples")
+    {
+        double coefficients[adsp::numCoefficients];
+        fixedTestCoefficients(coefficients, 1, 1000.0);
+        adsp::BiquadQ31 single;
+        single.setCoefficients(coefficients);
+        adsp::BiquadQ31 block;
+        block.setCoefficients(coefficients);
+
+        std::vector<int32_t> samples(input.size());
+        for (size_t n = 0; n < input.size(); ++n)
+        {
+            samples[n] = static_cast<int32_t>(lrint(ldexp(input[n], 31)));
+        }
+        std::vector<int32_t> output(samples.size());
+        block.processBlock(samples.data(), output.data(), 1000);
+        block.processBlock(samples.data() + 1000, output.data() + 1000, static_cast<int>(samples.size()) - 1000);
+
+        for (size_t n = 0; n < samples.size(); ++n)
+        {
+            REQUIRE(output[n] == single.process(samples[n]));
+        }
+    }
+}
+
+TEST_CASE("BiquadQ15", "[filter]")
+{
+    const std::vector<double> input = fixedTestNoise(48000);
+
+    SECTION("Arithmetic error within a few LSB")
+    {
+        for (double fc : {1000.0, 5000.0, 15000.0})
+        {
+            for (int type = 0; type < 2; ++type)
+            {
+                double coefficients[adsp::numCoefficients];
+                fixedTestCoefficients(coefficients, type, fc);
+                adsp::BiquadQ15 filter;
+                filter.setCoefficients(coefficients);
+
+                const FixedError error = fixedArithmeticError<adsp::BiquadQ15, int16_t>(filter, 15, input);
+                CHECK(error.max < 8.0);
+                CHECK(fabs(error.mean) < 0.05);
+            }
+        }
+    }
+
+    SECTION("Error feedback removes the truncation bias")
+    {
+        double coefficients[adsp::numCoefficients];
+        fixedTestCoefficients(coefficients, 0, 1000.0);
+        adsp::BiquadQ15 filter;
+        filter.setCoefficients(coefficients);
+
+        adsp::BiquadFixedParams params;
+        params.errorFeedback = false;
+        filter.setParameters(params);
+        const FixedError truncated = fixedArithmeticError<adsp::BiquadQ15, int16_t>(filter, 15, input);
+
+        params.errorFeedback = true;
+        filter.setParameters(params);
+        filter.reset();
+        const FixedError shaped = fixedArithmeticError<adsp::BiquadQ15, int16_t>(filter, 15, input);
+
+        CHECK(fabs(truncated.mean) > 10.0);
+        CHECK(fabs(shaped.mean) < 0.05);
+    }
+
+    SECTION("Chunked block processing matches single samples")
+    {
+        for (int type = 0; type < 2; ++type)
+        {
+            double coefficients[adsp::numCoefficients];
+            fixedTestCoefficients(coefficients, type, 300.0);
+            adsp::BiquadQ15 single;
+            single.setCoefficients(coefficients);
+            adsp::BiquadQ15 block;
+            block.setCoefficients(coefficients);
+
+            std::vector<int16_t> samples(input.size());
+            for (size_t n = 0; n < input.size(); ++n)
+            {
+                samples[n] = static_cast<int16_t>(lrint(ldexp(input[n], 15)));
+            }
+
+            // Odd block sizes cross the chunk boundaries at varying positions
+            std::vector<int16_t> output(samples);
+            int position = 0;
+            int blockSize = 1;
+            while (position < static_cast<int>(samples.size()))
+            {
+                const int numSamples = std::min(blockSize, static_cast<int>(samples.size()) - position);
+                block.processBlock(output.data() + position, output.data() + position, numSamples);
+                position += numSamples;
+                blockSize = blockSize * 3 % 199 + 1;
+            }
+
+            for (size_t n = 0; n < samples.size(); ++n)
+            {
+                REQUIRE(output[n] == single.process(samples[n]));
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    const adsp::biquadAlgorithm kernelTestAlgorithms[] = {
+        adsp::biquadAlgorithm::direct,
+        adsp::biquadAlgorithm::canonical,
+        adsp::biquadAlgorithm::transposedDirect,
+        adsp::biquadAlgorithm::transposedCanonical,
+        adsp::biquadAlgorithm::errorFeedbackDirect,
+        adsp::biquadAlgorithm::stateVariable};
+
+    std::vector<double> kernelTestSignal(int numSamples)
+    {
+        std::vector<double> signal(numSamples);
+        double x = 0.3;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            x = 3.9 * x * (1.0 - x);
+            signal[n] = x - 0.5;
+        }
+        return signal;
+    }
+}
+
+TEST_CASE("Biquad kernels over external state match Biquad", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numSamples = 500;
+    const std::vector<double> signal = kernelTestSignal(numSamples);
+
+    double coefficients[adsp::numCoefficients];
+    adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 150.0, 2.0, 9.0, sampleRate);
+
+    double derived[adsp::numDerivedCoefficients];
+    adsp::calculateDerivedCoefficients(coefficients, derived);
+
+    for (auto algorithm : kernelTestAlgorithms)
+    {
+        adsp::BiquadParams params;
+        params.calculationType = algorithm;
+        adsp::Biquad biquad;
+        biquad.setParameters(params);
+        biquad.setCoefficients(coefficients);
+
+        std::vector<double> expected(numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            expected[n] = biquad.process(signal[n]);
+        }
+
+        // Sample by sample
+        double state[adsp::numRegisters] = {};
+        bool underflow = false;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(adsp::processBiquadSample(algorithm, coefficients, derived, state, signal[n], underflow) == expected[n]);
+        }
+        CHECK(std::equal(state, state + adsp::numRegisters, biquad.getStateArray()));
+
+        // Blocks, in place
+        double blockState[adsp::numRegisters] = {};
+        std::vector<double> block(signal);
+        CHECK(adsp::processBiquadBlock(algorithm, coefficients, derived, blockState, block.data(), block.data(), 1, 123) == 0);
+        adsp::processBiquadBlock(algorithm, coefficients, derived, blockState, block.data() + 123, block.data() + 123, 1, numSamples - 123);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(block[n] == expected[n]);
+        }
+    }
+
+    // Single precision
+    adsp::BiquadFloat biquadFloat;
+    biquadFloat.setCoefficients(coefficients);
+    float coefficientsFloat[adsp::numCoefficients];
+    for (int i = 0; i < adsp::numCoefficients; ++i)
+    {
+        coefficientsFloat[i] = static_cast<float>(coefficients[i]);
+    }
+    float stateFloat[adsp::numRegisters] = {};
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float x = static_cast<float>(signal[n]);
+        float y = 0.0f;
+        adsp::processBiquadBlock<adsp::biquadAlgorithm::direct>(coefficientsFloat, static_cast<const float *>(nullptr), stateFloat, &x, &y, 1, 1);
+        REQUIRE(y == biquadFloat.process(x));
+    }
+}
+
+TEST_CASE("Biquad kernel state snapshots and voice pools", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numSamples = 256;
+    const int numVoices = 6;
+    const std::vector<double> signal = kernelTestSignal(numSamples);
+
+    adsp::LowShelf shelf;
+    shelf.reset(sampleRate);
+    adsp::LowShelfParams shelfParams;
+    shelfParams.fc = 300.0;
+    shelfParams.gain = -9.0;
+    shelf.setParameters(shelfParams);
+    double *coefficients = shelf.getCoefficients();
+    const auto algorithm = adsp::biquadAlgorithm::transposedCanonical;
+    const double *noDerived = nullptr;
+
+    // Rollback: restoring a snapshot reproduces the output
+    double state[adsp::numRegisters] = {};
+    std::vector<double> first(numSamples);
+    std::vector<double> second(numSamples);
+    adsp::processBiquadBlock(algorithm, coefficients, noDerived, state, signal.data(), first.data(), 1, 100);
+
+    double snapshot[adsp::numRegisters];
+    std::copy(state, state + adsp::numRegisters, snapshot);
+    adsp::processBiquadBlock(algorithm, coefficients, noDerived, state, signal.data() + 100, first.data() + 100, 1, numSamples - 100);
+
+    std::copy(snapshot, snapshot + adsp::numRegisters, state);
+    adsp::processBiquadBlock(algorithm, coefficients, noDerived, state, signal.data() + 100, second.data() + 100, 1, numSamples - 100);
+    for (int n = 100; n < numSamples; ++n)
+    {
+        REQUIRE(second[n] == first[n]);
+    }
+
+    // Voices share the coefficients, their state lives in one array
+    std::vector<double> pool(numVoices * adsp::numRegisters, 0.0);
+    std::vector<double> output(numSamples);
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        double *voiceState = pool.data() + voice * adsp::numRegisters;
+        const int length = 40 + 30 * voice;
+        adsp::processBiquadBlock(algorithm, coefficients, noDerived, voiceState, signal.data(), output.data(), 1, length);
+
+        adsp::Biquad biquad;
+        adsp::BiquadParams params;
+        params.calculationType = algorithm;
+        biquad.setParameters(params);
+        biquad.setCoefficients(coefficients);
+        for (int n = 0; n < length; ++n)
+        {
+            REQUIRE(output[n] == biquad.process(signal[n]));
+        }
+        CHECK(std::equal(voiceState, voiceState + adsp::numRegisters, biquad.getStateArray()));
+    }
+
+    // Results below MIN_FLOAT_VAL_POS are flushed and counted
+    double gainState[adsp::numRegisters] = {};
+    double gain[adsp::numCoefficients] = {1e-20, 0.0, 0.0, 0.0, 0.0};
+    double in[2] = {1e-30, 0.5};
+    double out[2];
+    CHECK(adsp::processBiquadBlock(adsp::biquadAlgorithm::direct, gain, noDerived, gainState, in, out, 1, 2) == 1);
+    CHECK(out[0] == 0.0);
+    CHECK(out[1] == Approx(0.5e-20));
+}
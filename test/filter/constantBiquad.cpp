@@ -0,0 +1,88 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    constexpr adsp::BiquadCoefficients constantRcLp1 = adsp::designRcLp1(1000.0, 48000.0);
+    constexpr adsp::BiquadCoefficients constantRcHp1 = adsp::designRcHp1(5.0, 48000.0);
+    constexpr adsp::BiquadCoefficients constantSkLp2 = adsp::designSkLp2(8000.0, 48000.0);
+    constexpr adsp::BiquadCoefficients constantSkHp2 = adsp::designSkHp2(30.0, 48000.0);
+
+    // Evaluated by the compiler
+    static_assert(constantRcLp1[adsp::a0] == constantRcLp1[adsp::a1], "RcLp1 zero at Nyquist");
+    static_assert(constantRcHp1[adsp::a2] == 0.0 && constantRcHp1[adsp::b2] == 0.0, "RcHp1 is first-order");
+    static_assert(constantSkLp2[adsp::a1] == 2.0 * constantSkLp2[adsp::a0], "SkLp2 double zero at Nyquist");
+    static_assert(adsp::FRAC_ONE_SQRT_TWO * 2.0 > adsp::SQRT_TWO - 1e-15, "Constants are constexpr");
+
+    template <typename Filter, typename Params>
+    void checkDesign(const adsp::BiquadCoefficients &coefficients, double fc)
+    {
+        Filter filter;
+        filter.reset(48000.0);
+        Params params;
+        params.fc = fc;
+        filter.setParameters(params);
+
+        for (int k = 0; k < adsp::numCoefficients; ++k)
+        {
+            CHECK(filter.getCoefficients()[k] == coefficients[k]);
+        }
+    }
+
+    template <const adsp::BiquadCoefficients &coefficients>
+    void checkConstantBiquad()
+    {
+        adsp::Biquad biquad;
+        adsp::BiquadParams params;
+        params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+        biquad.setParameters(params);
+        adsp::BiquadCoefficients copy = coefficients;
+        biquad.setCoefficients(copy.data());
+        biquad.reset();
+
+        adsp::ConstantBiquad<coefficients> filter;
+        filter.reset();
+
+        std::vector<double> in(1000);
+        for (int n = 0; n < 1000; ++n)
+        {
+            in[n] = sin(0.001 * n * n) + (n % 100 == 0 ? 1.0 : 0.0);
+        }
+
+        std::vector<double> out(1000);
+        filter.processBlock(in.data(), out.data(), 1000);
+        for (int n = 0; n < 1000; ++n)
+        {
+            REQUIRE(out[n] == Approx(biquad.process(in[n])).margin(1e-15));
+        }
+
+        filter.reset();
+        CHECK(filter.process(0.0) == 0.0);
+        CHECK(filter.getCoefficients()[adsp::b1] == coefficients[adsp::b1]);
+    }
+}
+
+TEST_CASE("Constexpr designs match the filter wrappers", "[filter]")
+{
+    checkDesign<adsp::RcLp1, adsp::RcLp1Params>(constantRcLp1, 1000.0);
+    checkDesign<adsp::RcHp1, adsp::RcHp1Params>(constantRcHp1, 5.0);
+    checkDesign<adsp::SkLp2, adsp::SkLp2Params>(constantSkLp2, 8000.0);
+    checkDesign<adsp::SkHp2, adsp::SkHp2Params>(constantSkHp2, 30.0);
+
+    CHECK(adsp::SQRT_TWO == pow(2.0, 0.5));
+    CHECK(adsp::FRAC_ONE_SQRT_TWO == pow(2.0, -0.5));
+}
+
+TEST_CASE("ConstantBiquad matches Biquad", "[filter]")
+{
+    checkConstantBiquad<constantRcLp1>();
+    checkConstantBiquad<constantRcHp1>();
+    checkConstantBiquad<constantSkLp2>();
+    checkConstantBiquad<constantSkHp2>();
+}
@@ -0,0 +1,88 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+TEST_CASE("DcBlocker removes offsets", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numSamples = 96000;
+
+    adsp::DcBlocker blocker;
+    blocker.reset(2, sampleRate);
+
+    // Offset plus 20 Hz and 1 kHz sines
+    std::vector<double> left(numSamples);
+    std::vector<double> right(numSamples);
+    for (int n = 0; n < numSamples; ++n)
+    {
+        left[n] = 0.5 + 0.25 * sin(adsp::TWO_PI * 20.0 * n / sampleRate);
+        right[n] = -0.3 + 0.25 * sin(adsp::TWO_PI * 1000.0 * n / sampleRate);
+    }
+    double *channels[] = {left.data(), right.data()};
+    blocker.process(channels, numSamples);
+
+    // Last second, 20 and 1000 whole periods
+    double leftMean = 0.0, rightMean = 0.0, leftPower = 0.0, rightPower = 0.0;
+    for (int n = numSamples / 2; n < numSamples; ++n)
+    {
+        leftMean += left[n];
+        rightMean += right[n];
+        leftPower += left[n] * left[n];
+        rightPower += right[n] * right[n];
+    }
+    leftMean /= numSamples / 2;
+    rightMean /= numSamples / 2;
+    leftPower /= numSamples / 2;
+    rightPower /= numSamples / 2;
+
+    CHECK(leftMean == Approx(0.0).margin(1e-4));
+    CHECK(rightMean == Approx(0.0).margin(1e-4));
+
+    // 5 Hz cutoff, -0.26 dB at 20 Hz and nothing at 1 kHz
+    CHECK(10.0 * log10(leftPower / (0.25 * 0.25 / 2.0)) == Approx(-0.26).margin(0.01));
+    CHECK(10.0 * log10(rightPower / (0.25 * 0.25 / 2.0)) == Approx(0.0).margin(0.01));
+}
+
+TEST_CASE("DcBlocker interleaved and parameters", "[filter]")
+{
+    adsp::DcBlocker planar;
+    planar.reset(3, 44100.0);
+    adsp::DcBlocker interleaved;
+    interleaved.reset(3, 44100.0);
+
+    adsp::DcBlockerParams params;
+    params.fc = 20.0;
+    planar.setParameters(params);
+    interleaved.setParameters(params);
+    CHECK(interleaved.getParameters().fc == 20.0);
+    CHECK(interleaved.getCoefficients()[adsp::a0] == adsp::designRcHp1(20.0, 44100.0)[adsp::a0]);
+    CHECK(interleaved.getCoefficients()[adsp::a1] == -interleaved.getCoefficients()[adsp::a0]);
+
+    std::vector<std::vector<double>> channels(3, std::vector<double>(500));
+    std::vector<double> frames(1500);
+    for (int n = 0; n < 500; ++n)
+    {
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            channels[channel][n] = 1.0 + channel + sin(0.01 * n * (channel + 1));
+            frames[n * 3 + channel] = channels[channel][n];
+        }
+    }
+
+    double *pointers[] = {channels[0].data(), channels[1].data(), channels[2].data()};
+    planar.process(pointers, 500);
+    interleaved.processInterleaved(frames.data(), 500);
+
+    for (int n = 0; n < 500; ++n)
+    {
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            REQUIRE(frames[n * 3 + channel] == channels[channel][n]);
+        }
+    }
+}
@@ -0,0 +1,311 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Magnitude response of a design on a linear grid from 0 to Nyquist
+    std::vector<double> designMagnitudedB(const adsp::FilterDesign &design, double sampleRate, std::vector<double> &frequencies)
+    {
+        const int numFrequencies = 2001;
+        frequencies.resize(numFrequencies);
+        for (int i = 0; i < numFrequencies; ++i)
+        {
+            frequencies[i] = 0.5 * sampleRate * i / (numFrequencies - 1);
+        }
+
+        adsp::FrequencyResponse response;
+        response.setFrequencies(frequencies.data(), numFrequencies, sampleRate);
+        for (int section = 0; section < design.numSections; ++section)
+        {
+            response.addBiquad(design.sections[section]);
+        }
+
+        const double *magnitude = response.getMagnitudedB();
+        return std::vector<double>(magnitude, magnitude + numFrequencies);
+    }
+
+    // Magnitude of a design at a single frequency
+    double designGaindB(const adsp::FilterDesign &design, double frequency, double sampleRate)
+    {
+        adsp::FrequencyResponse response;
+        response.setFrequencies(&frequency, 1, sampleRate);
+        for (int section = 0; section < design.numSections; ++section)
+        {
+            response.addBiquad(design.sections[section]);
+        }
+        return response.getMagnitudedB()[0];
+    }
+}
+
+//==============================================================================
+// Filter designs
+
+TEST_CASE("Filter designs", "[filter]")
+{
+    adsp::FilterDesignParams params;
+    params.fc = 2000.0;
+    params.sampleRate = 48000.0;
+
+    const adsp::designFamily families[] = {adsp::designFamily::butterworth, adsp::designFamily::chebyshev1, adsp::designFamily::bessel, adsp::designFamily::elliptic};
+    const adsp::designResponse responses[] = {adsp::designResponse::lowpass, adsp::designResponse::highpass};
+
+    SECTION("Sections are stable and ordered by pole radius")
+    {
+        for (auto family : families)
+        {
+            for (auto response : responses)
+            {
+                for (int order = 1; order <= adsp::MAX_DESIGN_ORDER; ++order)
+                {
+                    params.family = family;
+                    params.response = response;
+                    params.order = order;
+                    const adsp::FilterDesign design = adsp::designFilter(params);
+
+                    REQUIRE(design.numSections == (order + 1) / 2);
+
+                    double lastRadius = 0.0;
+                    for (int section = 0; section < design.numSections; ++section)
+                    {
+                        const double d1 = design.sections[section][adsp::b1];
+                        const double d2 = design.sections[section][adsp::b2];
+
+                        // Stability triangle
+                        REQUIRE(fabs(d2) < 1.0);
+                        REQUIRE(fabs(d1) < 1.0 + d2);
+
+                        // sqrt(b2) for complex poles, the larger magnitude for real ones
+                        const double radius = d1 * d1 < 4.0 * d2 ? sqrt(d2) : 0.5 * (fabs(d1) + sqrt(d1 * d1 - 4.0 * d2));
+                        REQUIRE(radius >= lastRadius - 1e-12);
+                        lastRadius = radius;
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Butterworth and Bessel are -3 dB at the cutoff frequency")
+    {
+        for (auto family : {adsp::designFamily::butterworth, adsp::designFamily::bessel})
+        {
+            for (auto response : responses)
+            {
+                for (int order = 1; order <= adsp::MAX_DESIGN_ORDER; order += 3)
+                {
+                    params.family = family;
+                    params.response = response;
+                    params.order = order;
+
+                    REQUIRE(designGaindB(adsp::designFilter(params), params.fc, params.sampleRate) == Approx(-3.0103).margin(0.01));
+                }
+            }
+        }
+    }
+
+    SECTION("Chebyshev passband ripple")
+    {
+        params.family = adsp::designFamily::chebyshev1;
+        params.passbandRipple = 0.5;
+
+        for (int order = 2; order <= 12; ++order)
+        {
+            params.order = order;
+
+            std::vector<double> frequencies;
+            const auto magnitude = designMagnitudedB(adsp::designFilter(params), params.sampleRate, frequencies);
+
+            for (size_t i = 0; i < frequencies.size(); ++i)
+            {
+                if (frequencies[i] <= params.fc)
+                {
+                    REQUIRE(magnitude[i] <= 1e-9);
+                    REQUIRE(magnitude[i] >= -0.5 - 1e-9);
+                }
+            }
+
+            REQUIRE(designGaindB(adsp::designFilter(params), params.fc, params.sampleRate) == Approx(-0.5).margin(1e-6));
+        }
+    }
+
+    SECTION("Elliptic passband ripple and stopband attenuation")
+    {
+        params.family = adsp::designFamily::elliptic;
+        params.passbandRipple = 0.1;
+        params.stopbandAttenuation = 80.0;
+
+        for (auto response : responses)
+        {
+            params.response = response;
+            params.order = 8;
+
+            std::vector<double> frequencies;
+            const auto magnitude = designMagnitudedB(adsp::designFilter(params), params.sampleRate, frequencies);
+
+            // An 8th order elliptic filter reaches 80 dB within half an octave here
+            for (size_t i = 0; i < frequencies.size(); ++i)
+            {
+                const bool passband = response == adsp::designResponse::lowpass ? frequencies[i] <= params.fc : frequencies[i] >= params.fc;
+                const bool stopband = response == adsp::designResponse::lowpass ? frequencies[i] >= 1.5 * params.fc : frequencies[i] <= params.fc / 1.5;
+
+                if (passband)
+                {
+                    REQUIRE(magnitude[i] <= 1e-6);
+                    REQUIRE(magnitude[i] >= -0.1 - 1e-6);
+                }
+                if (stopband)
+                {
+                    REQUIRE(magnitude[i] <= -80.0 + 1e-3);
+                }
+            }
+        }
+    }
+
+    SECTION("Designs run in the cascade")
+    {
+        params.family = adsp::designFamily::elliptic;
+        params.order = 9;
+
+        adsp::BiquadCascade cascade;
+        adsp::designFilter(params).applyTo(cascade);
+        REQUIRE(cascade.getNumSections() == 5);
+
+        // DC settles at unity gain
+        double y = 0.0;
+        for (int n = 0; n < 48000; ++n)
+        {
+            y = cascade.process(1.0);
+        }
+        REQUIRE(y == Approx(1.0).margin(1e-9));
+    }
+}
+
+TEST_CASE("FilterDesigner cache", "[filter]")
+{
+    adsp::FilterDesigner designer;
+
+    adsp::FilterDesignParams params;
+    params.family = adsp::designFamily::elliptic;
+    params.order = 10;
+
+    const adsp::FilterDesign first = designer.design(params);
+    const adsp::FilterDesign second = designer.design(params);
+    REQUIRE(designer.getCacheSize() == 1);
+
+    REQUIRE(first.numSections == second.numSections);
+    for (int section = 0; section < first.numSections; ++section)
+    {
+        for (int i = 0; i < adsp::numCoefficients; ++i)
+        {
+            REQUIRE(first.sections[section][i] == second.sections[section][i]);
+        }
+    }
+
+    params.fc = 1500.0;
+    designer.design(params);
+    REQUIRE(designer.getCacheSize() == 2);
+
+    designer.clearCache();
+    REQUIRE(designer.getCacheSize() == 0);
+
+    // Parameters the family ignores do not add entries
+    params.family = adsp::designFamily::butterworth;
+    for (double ripple : {0.5, 1.0, 3.0})
+    {
+        params.passbandRipple = ripple;
+        params.stopbandAttenuation = 20.0 * ripple;
+        designer.design(params);
+    }
+    params.order = adsp::MAX_DESIGN_ORDER + 4;
+    const adsp::FilterDesign clamped = designer.design(params);
+    params.order = adsp::MAX_DESIGN_ORDER;
+    CHECK(designer.design(params).sections[0][adsp::b1] == clamped.sections[0][adsp::b1]);
+    REQUIRE(designer.getCacheSize() == 2);
+
+    // The cache stays within its size
+    REQUIRE(designer.getMaxCacheSize() == adsp::DESIGN_CACHE_SIZE);
+    designer.setMaxCacheSize(8);
+    params.order = 4;
+    for (int i = 0; i < 20; ++i)
+    {
+        params.fc = 100.0 + 10.0 * i;
+        const adsp::FilterDesign design = designer.design(params);
+        REQUIRE(designer.getCacheSize() <= 8);
+        CHECK(design.sections[0][adsp::b1] == adsp::designFilter(params).sections[0][adsp::b1]);
+    }
+    REQUIRE(designer.getCacheSize() == 8);
+    designer.setMaxCacheSize(3);
+    CHECK(designer.getCacheSize() == 3);
+}
+
+TEST_CASE("FilterDesigner cache drops the least recently used design", "[filter]")
+{
+    adsp::FilterDesigner designer;
+    designer.setMaxCacheSize(3);
+
+    adsp::FilterDesignParams params;
+    params.family = adsp::designFamily::butterworth;
+    params.order = 4;
+    auto design = [&](double fc)
+    {
+        params.fc = fc;
+        return designer.design(params);
+    };
+
+    design(100.0);
+    design(200.0);
+    design(300.0);
+    REQUIRE(designer.getNumDesigned() == 3);
+
+    // A design in use stays cached while new ones come in
+    for (int i = 0; i < 10; ++i)
+    {
+        design(100.0);
+        design(1000.0 + i);
+    }
+    CHECK(designer.getNumDesigned() == 13);
+    CHECK(designer.getCacheSize() == 3);
+
+    // 200 and 300 were the least recently used
+    design(300.0);
+    CHECK(designer.getNumDesigned() == 14);
+    design(100.0);
+    design(1009.0);
+    CHECK(designer.getNumDesigned() == 14);
+
+    designer.clearCache();
+    CHECK(designer.getNumDesigned() == 0);
+
+    // Concurrent requests get the same designs
+    const adsp::FilterDesign expected = adsp::designFilter(params);
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&designer, &mismatches, &expected, params, t]()
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                adsp::FilterDesignParams threadParams = params;
+                threadParams.fc = i % 2 == 0 ? params.fc : 500.0 + (i + t) % 7;
+                const adsp::FilterDesign result = designer.design(threadParams);
+                if (i % 2 == 0 && result.sections[0][adsp::b1] != expected.sections[0][adsp::b1])
+                {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    CHECK(mismatches == std::vector<int>(4, 0));
+    CHECK(designer.getCacheSize() == 3);
+}
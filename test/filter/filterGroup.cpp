@@ -0,0 +1,223 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // One filter of every supported type, with non-default parameters
+    struct GroupFilters
+    {
+        GroupFilters()
+        {
+            adsp::RcLp1Params rcLp1Params;
+            rcLp1Params.fc = 1000.0;
+            rcLp1.setParameters(rcLp1Params);
+            adsp::RcHp1Params rcHp1Params;
+            rcHp1Params.fc = 20.0;
+            rcHp1.setParameters(rcHp1Params);
+            adsp::SkLp2Params skLp2Params;
+            skLp2Params.fc = 5000.0;
+            skLp2.setParameters(skLp2Params);
+            adsp::SkHp2Params skHp2Params;
+            skHp2Params.fc = 80.0;
+            skHp2.setParameters(skHp2Params);
+
+            adsp::PeakParams peakParams;
+            peakParams.fc = 2000.0;
+            peakParams.gain = 6.0;
+            peak.setParameters(peakParams);
+            adsp::LowShelfParams lowShelfParams;
+            lowShelfParams.gain = -3.0;
+            lowShelf.setParameters(lowShelfParams);
+            adsp::HighShelfParams highShelfParams;
+            highShelfParams.fc = 8000.0;
+            highShelfParams.gain = 4.0;
+            highShelf.setParameters(highShelfParams);
+            adsp::NotchParams notchParams;
+            notchParams.fc = 50.0;
+            notch.setParameters(notchParams);
+            adsp::BandpassParams bandpassParams;
+            bandpassParams.q = 4.0;
+            bandpass.setParameters(bandpassParams);
+            adsp::AllpassParams allpassParams;
+            allpassParams.fc = 300.0;
+            allpass.setParameters(allpassParams);
+        }
+
+        void addTo(adsp::FilterGroup &group)
+        {
+            // Mixed order, the group sorts by design
+            group.add(peak);
+            group.add(rcLp1);
+            group.add(skHp2);
+            group.add(lowShelf);
+            group.add(rcHp1);
+            group.add(highShelf);
+            group.add(notch);
+            group.add(skLp2);
+            group.add(bandpass);
+            group.add(allpass);
+        }
+
+        void setSampleRate(double sampleRate)
+        {
+            rcLp1.setSampleRate(sampleRate);
+            rcHp1.setSampleRate(sampleRate);
+            skLp2.setSampleRate(sampleRate);
+            skHp2.setSampleRate(sampleRate);
+            peak.setSampleRate(sampleRate);
+            lowShelf.setSampleRate(sampleRate);
+            highShelf.setSampleRate(sampleRate);
+            notch.setSampleRate(sampleRate);
+            bandpass.setSampleRate(sampleRate);
+            allpass.setSampleRate(sampleRate);
+        }
+
+        std::vector<double> coefficients()
+        {
+            std::vector<double> all;
+            for (double *c : {rcLp1.getCoefficients(), rcHp1.getCoefficients(), skLp2.getCoefficients(),
+                              skHp2.getCoefficients(), peak.getCoefficients(), lowShelf.getCoefficients(),
+                              highShelf.getCoefficients(), notch.getCoefficients(), bandpass.getCoefficients(),
+                              allpass.getCoefficients()})
+            {
+                all.insert(all.end(), c, c + adsp::numCoefficients);
+            }
+            return all;
+        }
+
+        adsp::RcLp1 rcLp1;
+        adsp::RcHp1 rcHp1;
+        adsp::SkLp2 skLp2;
+        adsp::SkHp2 skHp2;
+        adsp::Peak peak;
+        adsp::LowShelf lowShelf;
+        adsp::HighShelf highShelf;
+        adsp::Notch notch;
+        adsp::Bandpass bandpass;
+        adsp::Allpass allpass;
+    };
+}
+
+TEST_CASE("Filter wrappers keep the sample rate", "[filter]")
+{
+    adsp::RcLp1 filter;
+    filter.reset(96000.0);
+    CHECK(filter.getCoefficients()[adsp::b1] == adsp::designRcLp1(100.0, 96000.0)[adsp::b1]);
+
+    filter.setSampleRate(44100.0);
+    CHECK(filter.getCoefficients()[adsp::b1] == adsp::designRcLp1(100.0, 44100.0)[adsp::b1]);
+}
+
+TEST_CASE("FilterGroup matches per-filter sample rate changes", "[filter]")
+{
+    GroupFilters single;
+    GroupFilters grouped;
+
+    adsp::FilterGroup group;
+    grouped.addTo(group);
+    CHECK(group.getNumFilters() == 10);
+
+    for (double sampleRate : {44100.0, 96000.0, 22050.0})
+    {
+        single.setSampleRate(sampleRate);
+        group.setSampleRate(sampleRate);
+        CHECK(grouped.coefficients() == single.coefficients());
+    }
+
+    // Processing uses the new coefficients
+    single.peak.reset(22050.0);
+    grouped.peak.reset(22050.0);
+    for (int n = 0; n < 100; ++n)
+    {
+        const double x = n % 7 == 0 ? 1.0 : -0.25;
+        REQUIRE(grouped.peak.process(x) == single.peak.process(x));
+    }
+
+    group.clear();
+    CHECK(group.getNumFilters() == 0);
+    CHECK(group.getNumPreparedRates() == 0);
+    group.setSampleRate(48000.0);
+}
+
+TEST_CASE("FilterGroup prepared sample rates", "[filter]")
+{
+    GroupFilters single;
+    GroupFilters grouped;
+
+    adsp::FilterGroup group;
+    grouped.addTo(group);
+
+    const double sampleRates[] = {44100.0, 48000.0, 96000.0};
+    group.prepareSampleRates(sampleRates, 3);
+    CHECK(group.getNumPreparedRates() == 3);
+
+    for (double sampleRate : {96000.0, 44100.0, 48000.0})
+    {
+        single.setSampleRate(sampleRate);
+        group.setSampleRate(sampleRate);
+        CHECK(grouped.coefficients() == single.coefficients());
+    }
+
+    // Parameters changed after preparing are designed again
+    adsp::PeakParams peakParams = grouped.peak.getParameters();
+    peakParams.gain = -12.0;
+    grouped.peak.setParameters(peakParams);
+    single.peak.setParameters(peakParams);
+    adsp::SkLp2Params skLp2Params;
+    skLp2Params.fc = 12000.0;
+    grouped.skLp2.setParameters(skLp2Params);
+    single.skLp2.setParameters(skLp2Params);
+
+    single.setSampleRate(96000.0);
+    group.setSampleRate(96000.0);
+    CHECK(grouped.coefficients() == single.coefficients());
+
+    // Adding a filter discards the prepared rates
+    adsp::RcLp1 extra;
+    group.add(extra);
+    CHECK(group.getNumPreparedRates() == 0);
+    group.setSampleRate(44100.0);
+    CHECK(extra.getCoefficients()[adsp::a0] == adsp::designRcLp1(100.0, 44100.0)[adsp::a0]);
+}
+
+TEST_CASE("FilterGroup registers large groups", "[filter]")
+{
+    // Registering is constant time, a group of this size used to take seconds
+    const int numFilters = 40000;
+    std::vector<adsp::Peak> filters(numFilters);
+
+    adsp::FilterGroup group;
+    const double sampleRates[] = {44100.0, 96000.0};
+    for (int i = 0; i < numFilters; ++i)
+    {
+        adsp::PeakParams params;
+        params.fc = 100.0 + i % 1000;
+        filters[i].setParameters(params);
+        group.add(filters[i]);
+
+        if (i == numFilters / 2)
+        {
+            group.prepareSampleRates(sampleRates, 2);
+        }
+    }
+    CHECK(group.getNumFilters() == numFilters);
+    CHECK(group.getNumPreparedRates() == 0);
+
+    group.prepareSampleRates(sampleRates, 2);
+    group.setSampleRate(96000.0);
+
+    adsp::Peak reference;
+    adsp::PeakParams params;
+    params.fc = 100.0 + (numFilters - 1) % 1000;
+    reference.setParameters(params);
+    reference.setSampleRate(96000.0);
+    for (int c = 0; c < adsp::numCoefficients; ++c)
+    {
+        REQUIRE(filters[numFilters - 1].getCoefficients()[c] == reference.getCoefficients()[c]);
+    }
+}
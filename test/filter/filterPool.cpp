@@ -0,0 +1,136 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+TEST_CASE("FilterPool stores filters in one aligned slab", "[filter]")
+{
+    const double sampleRate = 44100.0;
+    const int numFilters = 500;
+
+    adsp::FilterPool<adsp::SkLp2> pool;
+    CHECK(pool.getNumFilters() == 0);
+
+    pool.allocate(numFilters);
+    REQUIRE(pool.getNumFilters() == numFilters);
+
+    // Every filter on a cache line, at a constant distance
+    const auto address = [&](int index) { return reinterpret_cast<uintptr_t>(&pool.getFilter(index)); };
+    const uintptr_t stride = address(1) - address(0);
+    CHECK(stride % adsp::FILTER_POOL_ALIGNMENT == 0);
+    CHECK(stride < sizeof(adsp::SkLp2) + adsp::FILTER_POOL_ALIGNMENT);
+    for (int i = 0; i < numFilters; ++i)
+    {
+        REQUIRE(address(i) % adsp::FILTER_POOL_ALIGNMENT == 0);
+        REQUIRE(address(i) == address(0) + i * stride);
+    }
+
+    // Bulk reset matches filters set up one by one
+    pool.reset(sampleRate);
+    for (int i = 0; i < numFilters; i += 7)
+    {
+        adsp::SkLp2Params params;
+        params.fc = 100.0 + 10.0 * i;
+        pool.getFilter(i).setParameters(params);
+
+        adsp::SkLp2 reference;
+        reference.reset(sampleRate);
+        reference.setParameters(params);
+
+        double x = 0.2;
+        for (int n = 0; n < 64; ++n)
+        {
+            x = 3.9 * x * (1.0 - x);
+            REQUIRE(pool.getFilter(i).process(x - 0.5) == reference.process(x - 0.5));
+        }
+    }
+
+    // The state is cleared, the parameters are kept
+    pool.reset(sampleRate);
+    adsp::SkLp2 reference;
+    reference.reset(sampleRate);
+    adsp::SkLp2Params params;
+    params.fc = 100.0 + 10.0 * 7;
+    reference.setParameters(params);
+    CHECK(pool.getFilter(7).process(1.0) == reference.process(1.0));
+
+    pool.allocate(3);
+    CHECK(pool.getNumFilters() == 3);
+    pool.release();
+    CHECK(pool.getNumFilters() == 0);
+    pool.reset(sampleRate);
+}
+
+TEST_CASE("FilterPool state reset and BiquadStatePool", "[filter]")
+{
+    double coefficients[adsp::numCoefficients];
+    adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, 500.0, 1.0, 6.0, 48000.0);
+
+    adsp::FilterPool<adsp::Biquad> biquads;
+    biquads.allocate(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        biquads.getFilter(i).setCoefficients(coefficients);
+        biquads.getFilter(i).process(1.0);
+    }
+    biquads.reset();
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int r = 0; r < adsp::numRegisters; ++r)
+        {
+            REQUIRE(biquads.getFilter(i).getStateArray()[r] == 0.0);
+        }
+    }
+
+    // Kernels on pooled states match Biquad
+    const int numVoices = 9;
+    adsp::BiquadStatePool states;
+    states.allocate(numVoices);
+    REQUIRE(states.getNumStates() == numVoices);
+    CHECK(reinterpret_cast<uintptr_t>(states.getState(0)) % adsp::FILTER_POOL_ALIGNMENT == 0);
+    CHECK(states.getState(1) - states.getState(0) == adsp::BIQUAD_STATE_STRIDE);
+
+    adsp::Biquad reference;
+    adsp::BiquadParams params;
+    params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+    reference.setParameters(params);
+    reference.setCoefficients(coefficients);
+
+    std::vector<double> block(128);
+    std::vector<double> expected(128);
+    for (int n = 0; n < 128; ++n)
+    {
+        block[n] = n == 0 ? 1.0 : 0.0;
+        expected[n] = reference.process(block[n]);
+    }
+
+    const double *noDerived = nullptr;
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        std::vector<double> out(128);
+        adsp::processBiquadBlock(params.calculationType, coefficients, noDerived, states.getState(voice), block.data(), out.data(), 1, 128);
+        for (int n = 0; n < 128; ++n)
+        {
+            REQUIRE(out[n] == expected[n]);
+        }
+    }
+
+    // Clearing one state leaves the others alone
+    states.resetState(4);
+    CHECK(states.getState(4)[adsp::x_z1] == 0.0);
+    CHECK(states.getState(5)[adsp::x_z1] == reference.getStateArray()[adsp::x_z1]);
+
+    states.reset();
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        REQUIRE(states.getState(voice)[adsp::x_z1] == 0.0);
+    }
+
+    states.release();
+    CHECK(states.getNumStates() == 0);
+    states.reset();
+}
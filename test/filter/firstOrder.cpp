@@ -0,0 +1,135 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    std::vector<double> firstOrderSignal(int numSamples, double phase)
+    {
+        std::vector<double> signal(numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            signal[n] = 0.3 + sin(0.001 * n * n + phase) + (n % 97 == 0 ? 1.0 : 0.0);
+        }
+        return signal;
+    }
+}
+
+TEST_CASE("FirstOrder matches Biquad", "[filter]")
+{
+    for (double fc : {5.0, 1000.0, 20000.0})
+    {
+        for (auto design : {adsp::designRcLp1(fc, 48000.0), adsp::designRcHp1(fc, 48000.0)})
+        {
+            adsp::Biquad biquad;
+            adsp::BiquadParams params;
+            params.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+            biquad.setParameters(params);
+            biquad.setCoefficients(design.data());
+
+            adsp::FirstOrder single;
+            single.setCoefficients(design.data());
+            adsp::FirstOrder block = single;
+
+            std::vector<double> signal = firstOrderSignal(2000, 0.0);
+            std::vector<double> out = signal;
+            block.processBlock(out.data(), out.data(), 1000);
+            block.processBlock(out.data() + 1000, out.data() + 1000, 1000);
+
+            for (int n = 0; n < 2000; ++n)
+            {
+                const double y = biquad.process(signal[n]);
+                REQUIRE(single.process(signal[n]) == y);
+                REQUIRE(out[n] == y);
+            }
+        }
+    }
+}
+
+TEST_CASE("RC filters run on FirstOrder", "[filter]")
+{
+    adsp::RcHp1 rcHp1;
+    rcHp1.reset(44100.0);
+    adsp::RcHp1Params params;
+    params.fc = 30.0;
+    rcHp1.setParameters(params);
+
+    adsp::FirstOrder reference;
+    reference.setCoefficients(adsp::designRcHp1(30.0, 44100.0).data());
+
+    std::vector<double> signal = firstOrderSignal(1000, 1.0);
+    for (int n = 0; n < 1000; ++n)
+    {
+        REQUIRE(rcHp1.process(signal[n]) == reference.process(signal[n]));
+    }
+
+    // Coefficients keep the second-order layout
+    CHECK(rcHp1.getCoefficients()[adsp::a2] == 0.0);
+    CHECK(rcHp1.getCoefficients()[adsp::b2] == 0.0);
+}
+
+TEST_CASE("FirstOrderBank matches FirstOrder", "[filter]")
+{
+    const auto coefficients = adsp::designRcLp1(2000.0, 48000.0);
+    const int numSamples = 700;
+
+    for (int numChannels : {1, 3, 8, 11})
+    {
+        std::vector<std::vector<double>> signals;
+        std::vector<std::vector<double>> expected;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            signals.push_back(firstOrderSignal(numSamples, channel));
+
+            adsp::FirstOrder single;
+            single.setCoefficients(coefficients.data());
+            expected.push_back(signals.back());
+            single.processBlock(expected.back().data(), expected.back().data(), numSamples);
+        }
+
+        adsp::FirstOrderBank bank;
+        bank.reset(numChannels);
+        bank.setCoefficients(coefficients.data());
+        CHECK(bank.getNumChannels() == numChannels);
+
+        // Planar, in two blocks
+        std::vector<std::vector<double>> planar = signals;
+        std::vector<double *> pointers;
+        for (auto &channel : planar)
+        {
+            pointers.push_back(channel.data());
+        }
+        bank.process(pointers.data(), 300);
+        for (auto &pointer : pointers)
+        {
+            pointer += 300;
+        }
+        bank.process(pointers.data(), numSamples - 300);
+
+        // Interleaved
+        bank.clear();
+        std::vector<double> interleaved(numSamples * numChannels);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                interleaved[n * numChannels + channel] = signals[channel][n];
+            }
+        }
+        bank.processInterleaved(interleaved.data(), numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int n = 0; n < numSamples; ++n)
+            {
+                REQUIRE(planar[channel][n] == expected[channel][n]);
+                REQUIRE(interleaved[n * numChannels + channel] == expected[channel][n]);
+            }
+        }
+    }
+}
@@ -0,0 +1,331 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Magnitude of a coefficient set at the given frequencies
+    std::vector<double> rbjMagnitudedB(double *coefficients, const std::vector<double> &frequencies, double sampleRate)
+    {
+        adsp::FrequencyResponse response;
+        response.setFrequencies(frequencies.data(), static_cast<int>(frequencies.size()), sampleRate);
+        response.addBiquad(coefficients);
+
+        const double *magnitude = response.getMagnitudedB();
+        return std::vector<double>(magnitude, magnitude + frequencies.size());
+    }
+}
+
+//==============================================================================
+// RBJ cookbook designs
+
+TEST_CASE("RBJ filter wrappers", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const std::vector<double> frequencies = {1.0, 1000.0, 23999.0};
+
+    SECTION("Peak")
+    {
+        adsp::Peak filter;
+        filter.reset(sampleRate);
+        adsp::PeakParams params;
+        params.fc = 1000.0;
+        params.q = 2.0;
+        params.gain = 6.0;
+        filter.setParameters(params);
+
+        const auto magnitude = rbjMagnitudedB(filter.getCoefficients(), frequencies, sampleRate);
+        REQUIRE(magnitude[0] == Approx(0.0).margin(1e-3));
+        REQUIRE(magnitude[1] == Approx(6.0).margin(1e-6));
+        REQUIRE(magnitude[2] == Approx(0.0).margin(1e-3));
+    }
+
+    SECTION("LowShelf")
+    {
+        adsp::LowShelf filter;
+        filter.reset(sampleRate);
+        adsp::LowShelfParams params;
+        params.gain = -12.0;
+        filter.setParameters(params);
+
+        const auto magnitude = rbjMagnitudedB(filter.getCoefficients(), frequencies, sampleRate);
+        REQUIRE(magnitude[0] == Approx(-12.0).margin(1e-3));
+        REQUIRE(magnitude[1] == Approx(-6.0).margin(1e-6));
+        REQUIRE(magnitude[2] == Approx(0.0).margin(1e-3));
+    }
+
+    SECTION("HighShelf")
+    {
+        adsp::HighShelf filter;
+        filter.reset(sampleRate);
+        adsp::HighShelfParams params;
+        params.gain = 9.0;
+        filter.setParameters(params);
+
+        const auto magnitude = rbjMagnitudedB(filter.getCoefficients(), frequencies, sampleRate);
+        REQUIRE(magnitude[0] == Approx(0.0).margin(1e-3));
+        REQUIRE(magnitude[1] == Approx(4.5).margin(1e-6));
+        REQUIRE(magnitude[2] == Approx(9.0).margin(1e-2));
+    }
+
+    SECTION("Notch")
+    {
+        adsp::Notch filter;
+        filter.reset(sampleRate);
+
+        const auto magnitude = rbjMagnitudedB(filter.getCoefficients(), frequencies, sampleRate);
+        REQUIRE(magnitude[0] == Approx(0.0).margin(1e-3));
+        REQUIRE(magnitude[1] < -100.0);
+        REQUIRE(magnitude[2] == Approx(0.0).margin(1e-3));
+    }
+
+    SECTION("Bandpass")
+    {
+        adsp::Bandpass filter;
+        filter.reset(sampleRate);
+
+        const auto magnitude = rbjMagnitudedB(filter.getCoefficients(), frequencies, sampleRate);
+        REQUIRE(magnitude[0] < -50.0);
+        REQUIRE(magnitude[1] == Approx(0.0).margin(1e-6));
+        REQUIRE(magnitude[2] < -50.0);
+    }
+
+    SECTION("Allpass")
+    {
+        adsp::Allpass filter;
+        filter.reset(sampleRate);
+
+        adsp::FrequencyResponse response;
+        response.setLogFrequencies(64, 20.0, 20000.0, sampleRate);
+        response.addFilter(filter);
+
+        const double *magnitude = response.getMagnitudedB();
+        for (int i = 0; i < response.getNumFrequencies(); ++i)
+        {
+            REQUIRE(magnitude[i] == Approx(0.0).margin(1e-9));
+        }
+
+        // No phase shift far below the center frequency
+        const double *phase = response.getPhase();
+        REQUIRE(phase[0] == Approx(0.0).margin(0.1));
+    }
+}
+
+TEST_CASE("RBJ design matches the exact cookbook formulas", "[filter]")
+{
+    const double sampleRate = 44100.0;
+
+    for (double fc = 20.0; fc < 20000.0; fc *= 1.5)
+    {
+        for (double gain = -24.0; gain <= 24.0; gain += 6.0)
+        {
+            double fast[adsp::numCoefficients];
+            adsp::calculateRbjCoefficients(fast, adsp::rbjFilter::peak, fc, 1.3, gain, sampleRate);
+
+            // Reference with the standard library
+            const double A = pow(10.0, gain / 40.0);
+            const double w0 = adsp::TWO_PI * fc / sampleRate;
+            const double alpha = sin(w0) / (2.0 * 1.3);
+            const double d0 = 1.0 + alpha / A;
+
+            REQUIRE(fast[adsp::a0] == Approx((1.0 + alpha * A) / d0).margin(1e-7));
+            REQUIRE(fast[adsp::a1] == Approx(-2.0 * cos(w0) / d0).margin(1e-7));
+            REQUIRE(fast[adsp::a2] == Approx((1.0 - alpha * A) / d0).margin(1e-7));
+            REQUIRE(fast[adsp::b1] == Approx(-2.0 * cos(w0) / d0).margin(1e-7));
+            REQUIRE(fast[adsp::b2] == Approx((1.0 - alpha / A) / d0).margin(1e-7));
+        }
+    }
+}
+
+TEST_CASE("RBJ design at low frequencies and high sample rates", "[filter]")
+{
+    for (double sampleRate : {48000.0, 96000.0, 192000.0})
+    {
+        // Peak at MIN_FILTER_FREQ: full gain at the center, symmetric around it
+        double coefficients[adsp::numCoefficients];
+        adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::peak, adsp::MIN_FILTER_FREQ, 2.0, 12.0, sampleRate);
+
+        const std::vector<double> frequencies = {adsp::MIN_FILTER_FREQ / 1.05, adsp::MIN_FILTER_FREQ, adsp::MIN_FILTER_FREQ * 1.05};
+        const auto magnitude = rbjMagnitudedB(coefficients, frequencies, sampleRate);
+        CHECK(magnitude[1] == Approx(12.0).margin(1e-3));
+        CHECK(magnitude[0] == Approx(magnitude[2]).margin(1e-2));
+
+        // Distance of the poles from z = 1 is exact relative to its size
+        const double w0 = adsp::TWO_PI * adsp::MIN_FILTER_FREQ / sampleRate;
+        const double alpha = sin(w0) / (2.0 * 2.0);
+        const double A = pow(10.0, 12.0 / 40.0);
+        const double exact = (2.0 - 2.0 * cos(w0)) / (1.0 + alpha / A);
+        CHECK(1.0 + coefficients[adsp::b1] + coefficients[adsp::b2] == Approx(exact).epsilon(1e-6));
+
+        // Low shelf corner at half gain
+        adsp::calculateRbjCoefficients(coefficients, adsp::rbjFilter::lowShelf, adsp::MIN_FILTER_FREQ, 0.7071, 12.0, sampleRate);
+        CHECK(rbjMagnitudedB(coefficients, {adsp::MIN_FILTER_FREQ}, sampleRate)[0] == Approx(6.0).margin(1e-2));
+    }
+}
+
+//==============================================================================
+// Cascade and equalizer
+
+TEST_CASE("ParametricEq", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numBands = 4;
+    const int numSamples = 1024;
+
+    adsp::ParametricEq eq;
+    eq.reset(sampleRate, numBands);
+    REQUIRE(eq.getNumBands() == numBands);
+
+    std::vector<double> in(numSamples);
+    for (int n = 0; n < numSamples; ++n)
+    {
+        in[n] = sin(0.01 * n) + 0.5 * sin(0.9 * n);
+    }
+
+    SECTION("Disabled bands pass the signal unchanged")
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(eq.process(in[n]) == in[n]);
+        }
+    }
+
+    // Low shelf, two peaks and a high shelf
+    const adsp::rbjFilter types[numBands] = {adsp::rbjFilter::lowShelf, adsp::rbjFilter::peak, adsp::rbjFilter::peak, adsp::rbjFilter::highShelf};
+    std::vector<adsp::Biquad> reference(numBands);
+    for (int band = 0; band < numBands; ++band)
+    {
+        adsp::EqBandParams params;
+        params.enabled = true;
+        params.type = types[band];
+        params.fc = 100.0 * pow(8.0, band);
+        params.q = 1.0 + band;
+        params.gain = band % 2 == 0 ? 6.0 : -9.0;
+        eq.setBand(band, params);
+
+        double coefficients[adsp::numCoefficients];
+        adsp::calculateRbjCoefficients(coefficients, params.type, params.fc, params.q, params.gain, sampleRate);
+
+        adsp::BiquadParams biquadParams;
+        biquadParams.calculationType = adsp::biquadAlgorithm::transposedCanonical;
+        reference[band].setParameters(biquadParams);
+        reference[band].setCoefficients(coefficients);
+    }
+
+    SECTION("Cascade matches a chain of biquads")
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            double expected = in[n];
+            for (auto &biquad : reference)
+            {
+                expected = biquad.process(expected);
+            }
+
+            REQUIRE(eq.process(in[n]) == Approx(expected).margin(1e-12));
+        }
+    }
+
+    SECTION("Block path matches per-sample processing")
+    {
+        adsp::ParametricEq perSample = eq;
+
+        std::vector<double> out(numSamples);
+        eq.processBlock(in.data(), out.data(), numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(out[n] == Approx(perSample.process(in[n])).margin(1e-12));
+        }
+    }
+
+    SECTION("Strided path filters one channel of an interleaved buffer")
+    {
+        adsp::ParametricEq perSample = eq;
+
+        std::vector<double> stereo(2 * numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            stereo[2 * n] = in[n];
+            stereo[2 * n + 1] = -in[n];
+        }
+        eq.processStrided(stereo.data(), stereo.data(), 2, numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(stereo[2 * n] == Approx(perSample.process(in[n])).margin(1e-12));
+            REQUIRE(stereo[2 * n + 1] == -in[n]);
+        }
+    }
+
+    SECTION("Response is the product of the bands")
+    {
+        adsp::FrequencyResponse response;
+        response.setLogFrequencies(32, 20.0, 20000.0, sampleRate);
+
+        adsp::BiquadCascade &cascade = eq.getCascade();
+        for (int section = 0; section < cascade.getNumSections(); ++section)
+        {
+            response.addBiquad(cascade.getSectionCoefficients(section));
+        }
+
+        adsp::FrequencyResponse expected;
+        expected.setLogFrequencies(32, 20.0, 20000.0, sampleRate);
+        for (auto &biquad : reference)
+        {
+            expected.addFilter(biquad);
+        }
+
+        const double *magnitude = response.getMagnitudedB();
+        const double *expectedMagnitude = expected.getMagnitudedB();
+        for (int i = 0; i < 32; ++i)
+        {
+            REQUIRE(magnitude[i] == Approx(expectedMagnitude[i]).margin(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Filter wrapper block paths", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numSamples = 1000;
+
+    std::vector<double> in(numSamples);
+    for (int n = 0; n < numSamples; ++n)
+    {
+        in[n] = sin(0.01 * n) + 0.5 * sin(0.9 * n);
+    }
+
+    adsp::Peak peak;
+    peak.reset(sampleRate);
+    adsp::PeakParams params;
+    params.gain = 9.0;
+    peak.setParameters(params);
+    adsp::Peak perSample = peak;
+
+    adsp::RcLp1 lowpass;
+    lowpass.reset(sampleRate);
+    adsp::RcLp1 lowpassPerSample = lowpass;
+
+    // Block on a copy, strided in place on a stereo buffer
+    std::vector<double> out(numSamples);
+    std::vector<double> stereo(2 * numSamples, 0.5);
+    for (int n = 0; n < numSamples; ++n)
+    {
+        stereo[2 * n] = in[n];
+    }
+    peak.processBlock(in.data(), out.data(), numSamples);
+    lowpass.processStrided(stereo.data(), stereo.data(), 2, numSamples);
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        REQUIRE(out[n] == perSample.process(in[n]));
+        REQUIRE(stereo[2 * n] == lowpassPerSample.process(in[n]));
+        REQUIRE(stereo[2 * n + 1] == 0.5);
+    }
+}
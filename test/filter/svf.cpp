@@ -0,0 +1,199 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Peak amplitude of the steady-state response to a sine
+    double svfSineGain(adsp::Svf &filter, double frequency, double sampleRate)
+    {
+        const int numSamples = 48000;
+        double peak = 0.0;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const double y = filter.process(sin(adsp::TWO_PI * frequency * n / sampleRate));
+            if (n > numSamples / 2)
+            {
+                peak = std::max(peak, fabs(y));
+            }
+        }
+        return peak;
+    }
+}
+
+//==============================================================================
+// State-variable filter
+
+TEST_CASE("Svf", "[filter]")
+{
+    const double sampleRate = 48000.0;
+
+    adsp::Svf svf;
+    svf.reset(sampleRate);
+
+    adsp::SvfParams params;
+    params.fc = 1000.0;
+    svf.setParameters(params);
+
+    SECTION("Low-pass is -3 dB at the cutoff frequency")
+    {
+        REQUIRE(adsp::rawGainTodB(svfSineGain(svf, 1000.0, sampleRate)) == Approx(-3.01).margin(0.05));
+    }
+
+    SECTION("High-pass blocks DC, low-pass passes it")
+    {
+        adsp::SvfOutputs outputs;
+        for (int n = 0; n < 10000; ++n)
+        {
+            outputs = svf.processAll(1.0);
+        }
+
+        REQUIRE(outputs.lowpass == Approx(1.0).margin(1e-9));
+        REQUIRE(outputs.highpass == Approx(0.0).margin(1e-9));
+        REQUIRE(outputs.bandpass == Approx(0.0).margin(1e-9));
+        REQUIRE(outputs.notch == Approx(1.0).margin(1e-9));
+    }
+
+    SECTION("Notch removes the cutoff frequency")
+    {
+        params.output = adsp::svfOutput::notch;
+        params.q = 4.0;
+        svf.setParameters(params);
+
+        REQUIRE(svfSineGain(svf, 1000.0, sampleRate) < 1e-3);
+    }
+
+    SECTION("Band-pass has unity gain at the cutoff frequency with k = 1 / Q")
+    {
+        params.output = adsp::svfOutput::bandpass;
+        params.q = 1.0;
+        svf.setParameters(params);
+
+        REQUIRE(svfSineGain(svf, 1000.0, sampleRate) == Approx(1.0).margin(1e-3));
+    }
+
+    SECTION("Outputs are consistent")
+    {
+        for (int n = 0; n < 1000; ++n)
+        {
+            const double x = sin(0.05 * n) + 0.3 * sin(0.7 * n);
+            const adsp::SvfOutputs outputs = svf.processAll(x);
+
+            REQUIRE(outputs.notch == Approx(outputs.lowpass + outputs.highpass).margin(1e-12));
+        }
+    }
+
+    SECTION("Block paths match per-sample processing")
+    {
+        const int numSamples = 512;
+        std::vector<double> in(numSamples);
+        std::vector<double> fc(numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            in[n] = sin(0.1 * n);
+            fc[n] = 500.0 + 400.0 * sin(0.02 * n);
+        }
+
+        adsp::Svf reference;
+        reference.reset(sampleRate);
+        reference.setParameters(params);
+
+        std::vector<double> out(numSamples);
+        svf.processBlockModulated(in.data(), out.data(), fc.data(), numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            reference.setCutoff(fc[n]);
+            REQUIRE(out[n] == Approx(reference.process(in[n])).margin(1e-12));
+        }
+
+        std::vector<double> lowpass(numSamples);
+        std::vector<double> highpass(numSamples);
+        svf.reset(sampleRate);
+        svf.setParameters(params);
+        svf.processBlockAll(in.data(), lowpass.data(), nullptr, highpass.data(), nullptr, numSamples);
+
+        reference.reset(sampleRate);
+        reference.setCutoff(params.fc);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const adsp::SvfOutputs outputs = reference.processAll(in[n]);
+            REQUIRE(lowpass[n] == Approx(outputs.lowpass).margin(1e-12));
+            REQUIRE(highpass[n] == Approx(outputs.highpass).margin(1e-12));
+        }
+    }
+
+    SECTION("Stays bounded under audio-rate cutoff modulation")
+    {
+        params.q = 10.0;
+        svf.setParameters(params);
+
+        double peak = 0.0;
+        for (int n = 0; n < 48000; ++n)
+        {
+            svf.setCutoff(n % 2 == 0 ? 100.0 : 15000.0);
+            peak = std::max(peak, fabs(svf.process(n % 100 < 50 ? 1.0 : -1.0)));
+        }
+
+        REQUIRE(std::isfinite(peak));
+        REQUIRE(peak < 100.0);
+    }
+}
+
+TEST_CASE("SvfBank", "[filter]")
+{
+    const double sampleRate = 48000.0;
+    const int numVoices = 5;
+    const int numSamples = 256;
+
+    adsp::SvfBank bank;
+    bank.reset(numVoices, sampleRate);
+    REQUIRE(bank.getNumVoices() == numVoices);
+
+    const adsp::svfOutput outputs[] = {adsp::svfOutput::lowpass, adsp::svfOutput::bandpass, adsp::svfOutput::highpass, adsp::svfOutput::notch};
+    for (auto output : outputs)
+    {
+        bank.setOutput(output);
+
+        std::vector<adsp::Svf> voices(numVoices);
+        for (int v = 0; v < numVoices; ++v)
+        {
+            adsp::SvfParams params;
+            params.fc = 200.0 * (v + 1);
+            params.q = 0.5 + v;
+            params.output = output;
+
+            voices[v].reset(sampleRate);
+            voices[v].setParameters(params);
+
+            bank.resetVoice(v);
+            bank.setVoice(v, params.fc, params.q);
+        }
+
+        std::vector<double> interleaved(numSamples * numVoices);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            for (int v = 0; v < numVoices; ++v)
+            {
+                interleaved[n * numVoices + v] = sin(0.03 * (v + 1) * n);
+            }
+        }
+
+        std::vector<double> processed(interleaved.size());
+        bank.processInterleaved(interleaved.data(), processed.data(), numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            for (int v = 0; v < numVoices; ++v)
+            {
+                const double expected = voices[v].process(interleaved[n * numVoices + v]);
+                REQUIRE(processed[n * numVoices + v] == Approx(expected).margin(1e-12));
+            }
+        }
+    }
+}
@@ -0,0 +1,230 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // HP -> shelving -> LP -> clip
+    struct GraphTrack
+    {
+        adsp::RcHp1 highpass;
+        adsp::LowShelf shelf;
+        adsp::SkLp2 lowpass;
+        adsp::Saturator saturator;
+
+        void reset(double sampleRate, int track)
+        {
+            highpass.reset(sampleRate);
+            shelf.reset(sampleRate);
+            lowpass.reset(sampleRate);
+            saturator.reset();
+
+            adsp::RcHp1Params highpassParams;
+            highpassParams.fc = 30.0 + 10.0 * track;
+            highpass.setParameters(highpassParams);
+
+            adsp::LowShelfParams shelfParams;
+            shelfParams.fc = 200.0;
+            shelfParams.gain = 3.0 * track - 6.0;
+            shelf.setParameters(shelfParams);
+
+            adsp::SkLp2Params lowpassParams;
+            lowpassParams.fc = 2000.0 + 1000.0 * track;
+            lowpass.setParameters(lowpassParams);
+
+            adsp::SaturatorParams saturatorParams;
+            saturatorParams.drive = 6.0;
+            saturator.setParameters(saturatorParams);
+        }
+
+        double process(double x)
+        {
+            return saturator.process(lowpass.process(shelf.process(highpass.process(x))));
+        }
+    };
+
+    // Node function of a custom processor
+    void halve(void *, double *block, int numSamples)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            block[n] *= 0.5;
+        }
+    }
+}
+
+TEST_CASE("ProcessGraph matches hand-written chains", "[graph]")
+{
+    const double sampleRate = 48000.0;
+    const int numTracks = 5;
+    const int numSamples = 1000;
+
+    std::vector<std::vector<double>> inputs(numTracks, std::vector<double>(numSamples));
+    for (int track = 0; track < numTracks; ++track)
+    {
+        double x = 0.1 + 0.05 * track;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            x = 3.9 * x * (1.0 - x);
+            inputs[track][n] = x - 0.5;
+        }
+    }
+
+    // Reference, one chain after the other sample by sample, tracks summed into a bus
+    std::vector<GraphTrack> reference(numTracks);
+    std::vector<std::vector<double>> trackOut(numTracks, std::vector<double>(numSamples));
+    std::vector<double> busOut(numSamples, 0.0);
+    for (int track = 0; track < numTracks; ++track)
+    {
+        reference[track].reset(sampleRate, track);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            trackOut[track][n] = reference[track].process(inputs[track][n]);
+        }
+    }
+    for (int n = 0; n < numSamples; ++n)
+    {
+        for (int track = 0; track < numTracks; ++track)
+        {
+            busOut[n] += trackOut[track][n];
+        }
+        busOut[n] *= 0.5;
+    }
+
+    for (int numThreads : {1, 2, 3})
+    {
+        std::vector<GraphTrack> tracks(numTracks);
+        adsp::ProcessGraph graph;
+
+        std::vector<int> trackNodes;
+        const int bus = graph.addNode(&halve, nullptr);
+        for (int track = 0; track < numTracks; ++track)
+        {
+            tracks[track].reset(sampleRate, track);
+
+            const int input = graph.addInput();
+            const int highpass = graph.addNode(tracks[track].highpass);
+            const int shelf = graph.addNode(tracks[track].shelf);
+            const int lowpass = graph.addNode(tracks[track].lowpass);
+            const int saturator = graph.addNode(tracks[track].saturator);
+
+            graph.connect(input, highpass);
+            graph.connect(highpass, shelf);
+            graph.connect(shelf, lowpass);
+            graph.connect(lowpass, saturator);
+            graph.connect(saturator, bus);
+            graph.addOutput(saturator);
+
+            trackNodes.push_back(input);
+        }
+        graph.addOutput(bus);
+
+        // Silence until prepared
+        std::vector<std::vector<double>> outputs(numTracks + 1, std::vector<double>(numSamples, 1.0));
+        std::vector<const double *> inputPointers;
+        std::vector<double *> outputPointers;
+        for (auto &input : inputs)
+        {
+            inputPointers.push_back(input.data());
+        }
+        for (auto &output : outputs)
+        {
+            outputPointers.push_back(output.data());
+        }
+        graph.process(inputPointers.data(), outputPointers.data(), 16);
+        CHECK(outputs[0][0] == 0.0);
+        CHECK(outputs[numTracks][15] == 0.0);
+
+        REQUIRE(graph.prepare(128, numThreads));
+        REQUIRE(graph.getNumNodes() == 1 + 5 * numTracks);
+        REQUIRE(graph.getNumInputs() == numTracks);
+        REQUIRE(graph.getNumOutputs() == numTracks + 1);
+        REQUIRE(graph.getNumThreads() == numThreads);
+
+        // Each chain stays on one thread
+        for (int track = 0; track < numTracks; ++track)
+        {
+            for (int node = trackNodes[track] + 1; node < trackNodes[track] + 5; ++node)
+            {
+                CHECK(graph.getNodeThread(node) == graph.getNodeThread(trackNodes[track]));
+            }
+        }
+
+        // Blocks longer and shorter than the prepared size
+        int offset = 0;
+        int blockSize = 1;
+        while (offset < numSamples)
+        {
+            const int length = std::min(blockSize, numSamples - offset);
+            std::vector<const double *> in;
+            std::vector<double *> out;
+            for (auto &input : inputs)
+            {
+                in.push_back(input.data() + offset);
+            }
+            for (auto &output : outputs)
+            {
+                out.push_back(output.data() + offset);
+            }
+            graph.process(in.data(), out.data(), length);
+
+            offset += length;
+            blockSize = blockSize * 3 % 400 + 1;
+        }
+
+        for (int track = 0; track < numTracks; ++track)
+        {
+            for (int n = 0; n < numSamples; ++n)
+            {
+                REQUIRE(outputs[track][n] == trackOut[track][n]);
+            }
+        }
+        for (int n = 0; n < numSamples; ++n)
+        {
+            REQUIRE(outputs[numTracks][n] == busOut[n]);
+        }
+    }
+}
+
+TEST_CASE("ProcessGraph scheduling", "[graph]")
+{
+    adsp::RcLp1 a;
+    adsp::RcLp1 b;
+    adsp::RcLp1 c;
+
+    adsp::ProcessGraph graph;
+    const int input = graph.addInput();
+    const int nodeA = graph.addNode(a);
+    const int nodeB = graph.addNode(b);
+    const int nodeC = graph.addNode(c);
+
+    // Branches of one input run side by side
+    graph.connect(input, nodeA);
+    graph.connect(input, nodeB);
+    graph.connect(nodeA, nodeC);
+    graph.connect(nodeB, nodeC);
+    graph.addOutput(nodeC);
+
+    REQUIRE(graph.prepare(64, 2));
+    CHECK(graph.getNodeThread(nodeA) == graph.getNodeThread(input));
+    CHECK(graph.getNodeThread(nodeB) != graph.getNodeThread(input));
+    CHECK(graph.getNodeThread(nodeC) == graph.getNodeThread(nodeA));
+
+    // Cycles and unknown nodes are rejected
+    graph.connect(nodeC, nodeA);
+    CHECK_FALSE(graph.prepare(64, 2));
+    CHECK(graph.getNumThreads() == 0);
+
+    graph.clear();
+    graph.addInput();
+    graph.addOutput(3);
+    CHECK_FALSE(graph.prepare(64, 1));
+
+    graph.clear();
+    CHECK(graph.prepare(64, 4));
+    CHECK(graph.getNumNodes() == 0);
+}
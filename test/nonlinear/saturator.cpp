@@ -0,0 +1,241 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    const adsp::saturationShape saturatorTestShapes[] = {
+        adsp::saturationShape::hard,
+        adsp::saturationShape::tanh,
+        adsp::saturationShape::atan,
+        adsp::saturationShape::cubic,
+        adsp::saturationShape::diode};
+
+    // Power of the non-harmonic spectral lines below a quarter of the sample rate, relative
+    // to the total power [dB]. The sine has fundamentalBin periods in 4800 samples, so
+    // harmonics and aliases fall on exact DFT bins.
+    double saturatorAliasingdB(adsp::Saturator &saturator, int fundamentalBin)
+    {
+        const int numSamples = 4800;
+
+        std::vector<double> twiddleCos(numSamples);
+        std::vector<double> twiddleSin(numSamples);
+        std::vector<double> signal(numSamples);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            twiddleCos[n] = cos(adsp::TWO_PI * n / numSamples);
+            twiddleSin[n] = sin(adsp::TWO_PI * n / numSamples);
+        }
+        for (int n = 0; n < numSamples; ++n)
+        {
+            signal[n] = twiddleSin[(fundamentalBin * n) % numSamples];
+        }
+
+        // Settle, then record one period of the output
+        std::vector<double> out(numSamples);
+        saturator.processBlock(signal.data(), out.data(), numSamples);
+        saturator.processBlock(signal.data(), out.data(), numSamples);
+
+        double total = 0.0;
+        for (double y : out)
+        {
+            total += y * y;
+        }
+
+        double aliasing = 0.0;
+        for (int bin = 1; bin < numSamples / 4; ++bin)
+        {
+            if (bin % fundamentalBin == 0)
+            {
+                continue;
+            }
+
+            double re = 0.0;
+            double im = 0.0;
+            for (int n = 0; n < numSamples; ++n)
+            {
+                re += out[n] * twiddleCos[(bin * n) % numSamples];
+                im -= out[n] * twiddleSin[(bin * n) % numSamples];
+            }
+            aliasing += 2.0 * (re * re + im * im) / numSamples;
+        }
+
+        return 10.0 * log10(aliasing / total);
+    }
+}
+
+TEST_CASE("Fast saturation approximations", "[nonlinear]")
+{
+    double tanhError = 0.0;
+    double atanError = 0.0;
+    double previous = -1.0;
+    for (double x = -20.0; x < 20.0; x += 1e-3)
+    {
+        tanhError = std::max(tanhError, fabs(adsp::fastTanh(x) - tanh(x)));
+        atanError = std::max(atanError, fabs(adsp::fastAtan(x) - atan(x)));
+
+        // Monotonic and bounded
+        REQUIRE(adsp::fastTanh(x) >= previous);
+        REQUIRE(fabs(adsp::fastTanh(x)) <= 1.0);
+        previous = adsp::fastTanh(x);
+    }
+    CHECK(tanhError < 7e-6);
+    CHECK(atanError < 1e-10);
+    CHECK(adsp::fastAtan(1e300) == Approx(0.5 * adsp::PI).margin(1e-15));
+}
+
+TEST_CASE("Saturation curves and antiderivatives", "[nonlinear]")
+{
+    for (auto shape : saturatorTestShapes)
+    {
+        // Unity slope at 0
+        CHECK(adsp::softClip(shape, 0.0) == Approx(0.0).margin(1e-12));
+        CHECK(adsp::softClip(shape, 1e-4) == Approx(1e-4).margin(1e-7));
+        CHECK(adsp::softClipIntegral(shape, 0.0) == Approx(0.0).margin(1e-12));
+
+        // The antiderivatives differentiate to the curves
+        // Evaluated between the kinks of the hard and cubic curves
+        for (double x = -7.995; x < 8.0; x += 0.01)
+        {
+            const double h = 1e-4;
+            const double derivative = (adsp::softClipIntegral(shape, x + h) - adsp::softClipIntegral(shape, x - h)) / (2.0 * h);
+            REQUIRE(derivative == Approx(adsp::softClip(shape, x)).margin(1e-5));
+        }
+
+        // Block processing evaluates the same curve
+        std::vector<double> block(1000);
+        for (size_t n = 0; n < block.size(); ++n)
+        {
+            block[n] = 0.01 * n - 5.0;
+        }
+        std::vector<double> out(block.size());
+        adsp::softClipBlock(shape, block.data(), out.data(), static_cast<int>(block.size()));
+        for (size_t n = 0; n < block.size(); ++n)
+        {
+            REQUIRE(out[n] == adsp::softClip(shape, block[n]));
+        }
+    }
+
+    // Limits
+    CHECK(adsp::softClip(adsp::saturationShape::tanh, 100.0) == Approx(1.0).margin(1e-8));
+    CHECK(adsp::softClip(adsp::saturationShape::atan, -1e9) == Approx(-1.0).margin(1e-8));
+    CHECK(adsp::softClip(adsp::saturationShape::cubic, 2.0) == 1.0);
+    CHECK(adsp::softClip(adsp::saturationShape::diode, 100.0) == Approx(0.5).margin(1e-12));
+    CHECK(adsp::softClip(adsp::saturationShape::diode, -100.0) == Approx(-1.0).margin(1e-12));
+}
+
+TEST_CASE("Saturator antiderivative anti-aliasing", "[nonlinear]")
+{
+    SECTION("Constant input gives the curve")
+    {
+        for (auto shape : saturatorTestShapes)
+        {
+            adsp::Saturator saturator;
+            adsp::SaturatorParams params;
+            params.shape = shape;
+            params.drive = 6.0;
+            saturator.setParameters(params);
+
+            double y = 0.0;
+            for (int n = 0; n < 10; ++n)
+            {
+                y = saturator.process(0.7);
+            }
+            CHECK(y == Approx(adsp::softClip(shape, 0.7 * adsp::dbToRawGain(6.0))).margin(1e-12));
+        }
+    }
+
+    SECTION("Block processing matches single samples")
+    {
+        for (auto shape : saturatorTestShapes)
+        {
+            for (bool antialiasing : {false, true})
+            {
+                adsp::SaturatorParams params;
+                params.shape = shape;
+                params.drive = 12.0;
+                params.antialiasing = antialiasing;
+                adsp::Saturator single;
+                single.setParameters(params);
+                adsp::Saturator block;
+                block.setParameters(params);
+
+                std::vector<double> signal(1000);
+                for (size_t n = 0; n < signal.size(); ++n)
+                {
+                    signal[n] = sin(0.3 * n) * (n % 7 == 0 ? 0.0 : 1.0);
+                }
+                std::vector<double> out(signal.size());
+                block.processBlock(signal.data(), out.data(), 333);
+                block.processBlock(signal.data() + 333, out.data() + 333, 667);
+
+                for (size_t n = 0; n < signal.size(); ++n)
+                {
+                    REQUIRE(out[n] == single.process(signal[n]));
+                }
+            }
+        }
+    }
+
+    SECTION("Aliasing below a quarter of the sample rate")
+    {
+        for (auto shape : {adsp::saturationShape::hard, adsp::saturationShape::tanh})
+        {
+            // 1230 Hz and 5030 Hz at 48 kHz
+            for (int fundamentalBin : {123, 503})
+            {
+                adsp::SaturatorParams params;
+                params.shape = shape;
+                params.drive = 20.0;
+
+                adsp::Saturator naive;
+                params.antialiasing = false;
+                naive.setParameters(params);
+
+                adsp::Saturator antialiased;
+                params.antialiasing = true;
+                antialiased.setParameters(params);
+
+                CHECK(saturatorAliasingdB(antialiased, fundamentalBin) < saturatorAliasingdB(naive, fundamentalBin) - 14.0);
+            }
+        }
+    }
+
+    SECTION("Slowly varying input stays accurate")
+    {
+        // Ramps with steps around the fallback threshold, through the segment
+        // boundaries of fastExp2() in the tanh and diode antiderivatives
+        for (auto shape : {adsp::saturationShape::tanh, adsp::saturationShape::atan,
+                           adsp::saturationShape::cubic, adsp::saturationShape::diode})
+        {
+            for (double step : {2e-5, 1e-4, 1.01e-3, 5e-3})
+            {
+                adsp::Saturator saturator;
+                adsp::SaturatorParams params;
+                params.shape = shape;
+                saturator.setParameters(params);
+
+                double last = -1.5;
+                saturator.process(last);
+
+                double maxError = 0.0;
+                for (double x = last + step; x < 1.5; x += step)
+                {
+                    const double y = saturator.process(x);
+
+                    // Mean of the curve over the step (Simpson's rule)
+                    const double mean = (adsp::softClip(shape, last) + 4.0 * adsp::softClip(shape, 0.5 * (last + x)) +
+                                         adsp::softClip(shape, x)) / 6.0;
+                    maxError = std::max(maxError, fabs(y - mean));
+                    last = x;
+                }
+                CHECK(20.0 * log10(maxError) < -100.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,205 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <complex>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+namespace
+{
+    // Amplitude of DFT bin k of a block, the tones below complete whole periods in it
+    double binAmplitude(const std::vector<double> &x, int k)
+    {
+        const int length = static_cast<int>(x.size());
+        std::complex<double> sum = 0.0;
+        for (int n = 0; n < length; ++n)
+        {
+            sum += x[n] * std::polar(1.0, -adsp::TWO_PI * static_cast<double>((static_cast<long long>(k) * n) % length) / length);
+        }
+        return 2.0 * std::abs(sum) / length;
+    }
+}
+
+//==============================================================================
+// Oversampler
+
+TEST_CASE("Oversampler", "[oversampling]")
+{
+    const int blockSize = 64;
+    const int numBlocks = 64;
+
+    SECTION("Round trip passes DC with unity gain")
+    {
+        for (int factor = 2; factor <= 16; factor *= 2)
+        {
+            for (auto type : {adsp::oversamplingFilter::iir, adsp::oversamplingFilter::fir})
+            {
+                adsp::Oversampler oversampler;
+                adsp::OversamplerParams params;
+                params.factor = factor;
+                params.filterType = type;
+                oversampler.setParameters(params);
+                oversampler.reset(blockSize);
+
+                REQUIRE(oversampler.getFactor() == factor);
+
+                std::vector<double> block(blockSize);
+                for (int b = 0; b < numBlocks; ++b)
+                {
+                    std::fill(block.begin(), block.end(), 0.5);
+                    oversampler.process(block.data(), blockSize, [](double x) { return x; });
+                }
+
+                REQUIRE(block[blockSize - 1] == Approx(0.5).margin(1e-4));
+            }
+        }
+    }
+
+    SECTION("FIR latency matches impulse peak")
+    {
+        adsp::Oversampler oversampler;
+        adsp::OversamplerParams params;
+        params.factor = 2;
+        params.filterType = adsp::oversamplingFilter::fir;
+        oversampler.setParameters(params);
+        oversampler.reset(blockSize);
+
+        std::vector<double> response;
+        std::vector<double> block(blockSize, 0.0);
+        block[0] = 1.0;
+        for (int b = 0; b < 4; ++b)
+        {
+            oversampler.process(block.data(), blockSize, [](double x) { return x; });
+            response.insert(response.end(), block.begin(), block.end());
+            std::fill(block.begin(), block.end(), 0.0);
+        }
+
+        const auto peak = std::max_element(response.begin(), response.end());
+        // Round trip latency can be a fractional number of samples
+        REQUIRE(static_cast<double>(peak - response.begin()) == Approx(oversampler.getLatency()).margin(0.5));
+    }
+
+    SECTION("Factor 1 bypasses")
+    {
+        adsp::Oversampler oversampler;
+        adsp::OversamplerParams params;
+        params.factor = 1;
+        oversampler.setParameters(params);
+        oversampler.reset(blockSize);
+
+        std::vector<double> block(blockSize, 0.25);
+        oversampler.process(block.data(), blockSize, [](double x) { return 2.0 * x; });
+
+        REQUIRE(oversampler.getLatency() == 0.0_a);
+        REQUIRE(block[0] == 0.5_a);
+    }
+
+    SECTION("Blocks that do not fit are rejected")
+    {
+        adsp::Oversampler oversampler;
+        adsp::OversamplerParams params;
+        params.factor = 16;
+        oversampler.setParameters(params);
+
+        // Before reset() there are no buffers
+        std::vector<double> block(4 * blockSize, 0.25);
+        CHECK(oversampler.upsample(block.data(), blockSize) == nullptr);
+        oversampler.downsample(block.data(), blockSize);
+        CHECK(block[0] == 0.25);
+
+        oversampler.reset(blockSize);
+        CHECK(oversampler.upsample(block.data(), blockSize + 1) == nullptr);
+        CHECK(oversampler.upsample(block.data(), -1) == nullptr);
+        oversampler.process(block.data(), 4 * blockSize, [](double x) { return 2.0 * x; });
+        for (double x : block)
+        {
+            REQUIRE(x == 0.25);
+        }
+
+        CHECK(oversampler.upsample(block.data(), blockSize) != nullptr);
+        oversampler.reset(-1);
+        CHECK(oversampler.upsample(block.data(), 0) == nullptr);
+    }
+}
+
+TEST_CASE("Oversampler image and alias rejection", "[oversampling]")
+{
+    // Tones on exact DFT bins of a window of N samples at the original rate, one low
+    // and one at the passband edge
+    const int N = 4096;
+    const int blockSize = 256;
+    const int numWarmupBlocks = 2 * N / blockSize;
+    const double minRejectiondB = 90.0;
+
+    for (int factor = 2; factor <= 16; factor *= 2)
+    {
+        for (auto type : {adsp::oversamplingFilter::iir, adsp::oversamplingFilter::fir})
+        {
+            adsp::OversamplerParams params;
+            params.factor = factor;
+            params.filterType = type;
+            const int M = N * factor;
+
+            for (int bin : {410, 1843})
+            {
+                // Upsampling a tone: the images at k * fs +- f are rejected
+                adsp::Oversampler up;
+                up.setParameters(params);
+                up.reset(blockSize);
+
+                std::vector<double> block(blockSize);
+                std::vector<double> upsampled;
+                for (int b = 0; b < numWarmupBlocks + N / blockSize; ++b)
+                {
+                    for (int n = 0; n < blockSize; ++n)
+                    {
+                        block[n] = sin(adsp::TWO_PI * bin * static_cast<double>(b * blockSize + n) / N);
+                    }
+                    const double *out = up.upsample(block.data(), blockSize);
+                    if (b >= numWarmupBlocks)
+                    {
+                        upsampled.insert(upsampled.end(), out, out + blockSize * factor);
+                    }
+                    up.downsample(block.data(), blockSize);
+                }
+                REQUIRE(binAmplitude(upsampled, bin) == Approx(1.0).margin(1e-3));
+
+                for (int k = 1; k <= factor / 2; ++k)
+                {
+                    for (int image : {k * N - bin, k * N + bin})
+                    {
+                        if (image >= M / 2)
+                        {
+                            continue;
+                        }
+                        CHECK(20.0 * log10(binAmplitude(upsampled, image)) < -minRejectiondB);
+
+                        // Downsampling the image frequency: its alias at f is rejected
+                        adsp::Oversampler down;
+                        down.setParameters(params);
+                        down.reset(blockSize);
+
+                        std::vector<double> downsampled;
+                        std::vector<double> silence(blockSize, 0.0);
+                        for (int b = 0; b < numWarmupBlocks + N / blockSize; ++b)
+                        {
+                            double *buffer = down.upsample(silence.data(), blockSize);
+                            for (int n = 0; n < blockSize * factor; ++n)
+                            {
+                                buffer[n] = sin(adsp::TWO_PI * image * static_cast<double>(b * blockSize * factor + n) / M);
+                            }
+                            down.downsample(block.data(), blockSize);
+                            if (b >= numWarmupBlocks)
+                            {
+                                downsampled.insert(downsampled.end(), block.begin(), block.end());
+                            }
+                        }
+                        CHECK(20.0 * log10(binAmplitude(downsampled, bin)) < -minRejectiondB);
+                    }
+                }
+            }
+        }
+    }
+}
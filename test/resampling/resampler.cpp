@@ -0,0 +1,92 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+//==============================================================================
+// Resampler
+
+TEST_CASE("Resampler", "[resampling]")
+{
+    const int blockSize = 441;
+    const int numBlocks = 100;
+
+    adsp::Resampler resampler;
+    adsp::ResamplerParams params;
+    params.inputSampleRate = 44100.0;
+    params.outputSampleRate = 48000.0;
+    resampler.setParameters(params);
+    resampler.reset(blockSize);
+
+    std::vector<double> in(blockSize, 0.5);
+    std::vector<double> out(resampler.getMaxOutputSamples(blockSize));
+
+    SECTION("Output count follows the ratio")
+    {
+        int numOutputSamples = 0;
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            numOutputSamples += resampler.process(in.data(), blockSize, out.data(), static_cast<int>(out.size()));
+        }
+
+        // 441 samples at 44.1 kHz are 480 samples at 48 kHz
+        REQUIRE(numOutputSamples == Approx(480 * numBlocks).margin(1));
+    }
+
+    SECTION("DC passes with unity gain")
+    {
+        int numOutputSamples = 0;
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            numOutputSamples = resampler.process(in.data(), blockSize, out.data(), static_cast<int>(out.size()));
+        }
+
+        REQUIRE(out[numOutputSamples - 1] == Approx(0.5).margin(1e-4));
+    }
+
+    SECTION("Ratio can drift without redesign")
+    {
+        resampler.setRatio(48000.0 / 44100.0 * 1.001);
+        REQUIRE(resampler.getRatio() == Approx(48000.0 / 44100.0 * 1.001));
+
+        int numOutputSamples = 0;
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            numOutputSamples += resampler.process(in.data(), blockSize, out.data(), static_cast<int>(out.size()));
+        }
+
+        REQUIRE(numOutputSamples == Approx(480.48 * numBlocks).margin(1));
+    }
+
+    SECTION("Blocks that do not fit are rejected without losing input")
+    {
+        adsp::Resampler reference;
+        reference.setParameters(params);
+        reference.reset(blockSize);
+        std::vector<double> expected(out.size());
+
+        std::vector<double> ramp(blockSize);
+        for (int n = 0; n < blockSize; ++n)
+        {
+            ramp[n] = static_cast<double>(n) / blockSize;
+        }
+
+        // Output capacity too small, block longer than maxBlockSize
+        std::vector<double> longBlock(blockSize + 1, 0.5);
+        REQUIRE(resampler.process(ramp.data(), blockSize, out.data(), 100) == -1);
+        REQUIRE(resampler.process(longBlock.data(), blockSize + 1, out.data(), static_cast<int>(out.size())) == -1);
+
+        for (int b = 0; b < 3; ++b)
+        {
+            const int numOutputSamples = resampler.process(ramp.data(), blockSize, out.data(), static_cast<int>(out.size()));
+            REQUIRE(numOutputSamples == reference.process(ramp.data(), blockSize, expected.data(), static_cast<int>(expected.size())));
+            for (int n = 0; n < numOutputSamples; ++n)
+            {
+                REQUIRE(out[n] == expected[n]);
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include "../Catch2/src/catch2/catch_all.hpp"
+#include "../../ADSP.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Catch::literals;
+using namespace Catch;
+
+TEST_CASE("Linear smoother", "[utility]")
+{
+    adsp::Smoother smoother;
+    smoother.reset(1000.0, 1.0);
+
+    // 10 ms at 1 kHz
+    adsp::SmootherParams params;
+    params.type = adsp::smoothingType::linear;
+    params.time = 10.0;
+    smoother.setParameters(params);
+
+    CHECK_FALSE(smoother.isSmoothing());
+    CHECK(smoother.getNext() == 1.0);
+
+    smoother.setTarget(2.0);
+    CHECK(smoother.isSmoothing());
+    for (int n = 1; n < 10; ++n)
+    {
+        CHECK(smoother.getNext() == Approx(1.0 + 0.1 * n).margin(1e-12));
+    }
+    CHECK(smoother.getNext() == 2.0);
+    CHECK_FALSE(smoother.isSmoothing());
+
+    // Same target does not restart
+    smoother.setTarget(2.0);
+    CHECK_FALSE(smoother.isSmoothing());
+
+    // Skipping lands on the ramp
+    smoother.setTarget(0.0);
+    CHECK(smoother.skip(4) == Approx(1.2).margin(1e-12));
+    CHECK(smoother.skip(100) == 0.0);
+    CHECK_FALSE(smoother.isSmoothing());
+}
+
+TEST_CASE("One-pole smoother", "[utility]")
+{
+    adsp::Smoother smoother;
+    smoother.reset(48000.0, 0.0);
+
+    adsp::SmootherParams params;
+    params.type = adsp::smoothingType::onePole;
+    params.time = 1.0;
+    smoother.setParameters(params);
+
+    // One time constant
+    smoother.setTarget(1.0);
+    double y = 0.0;
+    for (int n = 0; n < 48; ++n)
+    {
+        y = smoother.getNext();
+    }
+    CHECK(y == Approx(1.0 - exp(-1.0)).margin(1e-12));
+
+    // Snaps to the target after the residual
+    int numSamples = 48;
+    while (smoother.isSmoothing())
+    {
+        y = smoother.getNext();
+        ++numSamples;
+    }
+    CHECK(y == 1.0);
+    CHECK(numSamples == static_cast<int>(ceil(-log(adsp::SMOOTHER_ONE_POLE_RESIDUAL) * 48.0)));
+
+    // Skipping matches single samples
+    adsp::Smoother single = smoother;
+    smoother.setTarget(-1.0);
+    single.setTarget(-1.0);
+    for (int n = 0; n < 100; ++n)
+    {
+        y = single.getNext();
+    }
+    CHECK(smoother.skip(100) == Approx(y).margin(1e-12));
+}
+
+TEST_CASE("Smoother block output", "[utility]")
+{
+    for (auto type : {adsp::smoothingType::linear, adsp::smoothingType::onePole})
+    {
+        adsp::SmootherParams params;
+        params.type = type;
+        params.time = 5.0;
+
+        adsp::Smoother single;
+        single.setParameters(params);
+        single.reset(48000.0, 100.0);
+        adsp::Smoother block = single;
+
+        single.setTarget(1000.0);
+        block.setTarget(1000.0);
+
+        // Settles within a block, the rest of it holds the target
+        std::vector<double> out(256, -1.0);
+        while (block.isSmoothing())
+        {
+            REQUIRE(block.processBlock(out.data(), 256));
+            for (int n = 0; n < 256; ++n)
+            {
+                REQUIRE(out[n] == Approx(single.getNext()).margin(1e-9));
+            }
+        }
+        CHECK(out[255] == 1000.0);
+        CHECK(block.getCurrent() == 1000.0);
+
+        std::fill(out.begin(), out.end(), -1.0);
+        CHECK_FALSE(block.processBlock(out.data(), 256));
+        CHECK(out[0] == -1.0);
+    }
+}
@@ -271,5 +271,11 @@ TEST_CASE("Fast function approximations", "[utility]")
     {
         REQUIRE(adsp::fastLog2(16.0f) == Approx(4.0f).margin(0.005));
         REQUIRE(adsp::fastLog2(5.0f) == Approx(2.322f).margin(0.005));
+
+        // Double precision version
+        for (double x = 1e-300; x < 1e300; x *= 1.01)
+        {
+            REQUIRE(adsp::fastLog2(x) == Approx(log2(x)).margin(1e-12));
+        }
     }
 }
\ No newline at end of file